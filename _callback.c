@@ -43,6 +43,16 @@
 #include "spyer.h"
 #include "ticks.h"
 #include "fault.h"
+#include "ticker.h"
+#ifdef SIM_ENABLE
+#include "mpool.h"
+#include "event.h"
+#include "echain.h"
+#include "fsm.h"
+#include "hsm.h"
+#include "active.h"
+#include "sim.h"
+#endif  /* End of SIM_ENABLE */
 
 #define  EXTERN_GLOBALS
 #include "callback.h"
@@ -57,10 +67,36 @@ int16_t on_init(void_t)
 {
 } 
 
+#ifdef POSIX_HOST
 /***************************************************************************************
 *   on_idle() Implementation.
+*   The Manager Thread Blocks until an "ISR" (the Ticker or the Producers) Wakes It, 
+*   or the Simulator Advances the Virtual Clock. 
 ***************************************************************************************/
-int16_t on_idle(INT_KEY_TYPE int_lock_key)
+int16_t on_idle(cpu_sr_t int_lock_key, uint32_t ticks)
 {
+#if defined(SIM_ENABLE)
+    sim_idle(ticks); 
+#elif defined(TICKER_TICKLESS_ENABLE)
+    ticker_sleep(ticks); 
+#else
+    (void_t)ticks; 
+    interrupt_wait(); 
+#endif  /* End of TICKER_TICKLESS_ENABLE */
+    /* Unlock the Interrupts Locked by the Manager */
+    interrupt_restore(int_lock_key); 
+    return TRUE; 
 }
+#else
+/***************************************************************************************
+*   on_idle() Implementation.
+***************************************************************************************/
+int16_t on_idle(cpu_sr_t int_lock_key, uint32_t ticks)
+{
+    (void_t)ticks; 
+    /* Unlock the Interrupts Locked by the Manager */
+    interrupt_restore(int_lock_key); 
+    return TRUE; 
+}
+#endif  /* End of POSIX_HOST */
 
@@ -0,0 +1,147 @@
+/***************************************************************************************
+*   The MIT License (MIT)
+*   Copyright (C) 2005 JinHui Han, <Email: ferrethan485@sohu.com, QQ: 1901589440>
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in
+*   all copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+*   THE SOFTWARE.
+***************************************************************************************/
+
+/***************************************************************************************
+*   Component : Active Object Application FrameWork
+*   Group : Cycles
+*   File Name : cycles.c
+*   Version : 1.0
+*   Description : Base for High-Resolution Cycle Counter
+*   Author : JinHui Han
+*   History : 
+*          Name            Date                    Remarks
+*       JinHui Han      05-09-2005      Created Initial Version 1.0
+*       JinHui Han      05-09-2005      Verified Version 1.0
+***************************************************************************************/
+
+#include "std_type.h"
+#include "std_def.h"
+#include "config.h"
+
+#ifdef POSIX_HOST
+#define _GNU_SOURCE
+#include <time.h>
+#endif  /* End of POSIX_HOST */
+
+#ifdef SIM_ENABLE
+#include "lock.h"
+#include "mpool.h"
+#include "event.h"
+#include "echain.h"
+#include "fsm.h"
+#include "hsm.h"
+#include "active.h"
+#include "sim.h"
+#endif  /* End of SIM_ENABLE */
+
+#define  EXTERN_GLOBALS
+#include "cycles.h"
+
+#ifdef CORTEX_M
+
+/***************************************************************************************
+*   The Frequency of the CPU Core Clock, the DWT Counts the Core Clock. 
+***************************************************************************************/
+#ifndef CYCLES_CPU_HZ
+#define CYCLES_CPU_HZ   ((uint32_t)72000000)    /* Default is 72 MHz */
+#endif  /* End of CYCLES_CPU_HZ */
+
+/***************************************************************************************
+*   Registers of the Data Watchpoint and Trace Unit (DWT). 
+***************************************************************************************/
+#define CYCLES_DEMCR_       (*(uint32_t volatile *)0xE000EDFCUL)  /* Debug Exception */
+#define CYCLES_DWT_CTRL_    (*(uint32_t volatile *)0xE0001000UL)  /* DWT Control */
+#define CYCLES_DWT_CYCCNT_  (*(uint32_t volatile *)0xE0001004UL)  /* Cycle Count */
+#define CYCLES_DWT_LAR_     (*(uint32_t volatile *)0xE0001FB0UL)  /* Lock Access */
+
+#define CYCLES_TRCENA_      ((uint32_t)0x01000000)  /* DEMCR.TRCENA */
+#define CYCLES_CYCCNTENA_   ((uint32_t)0x00000001)  /* DWT_CTRL.CYCCNTENA */
+#define CYCLES_UNLOCK_      ((uint32_t)0xC5ACCE55)  /* Key of the Lock Access */
+
+/***************************************************************************************
+*   cycles_init() Implementation.
+***************************************************************************************/
+void_t cycles_init(void_t)
+{
+    /* Enable the Trace and Debug Blocks */
+    CYCLES_DEMCR_ |= CYCLES_TRCENA_; 
+    /* Unlock the DWT, Only Needed by the Cortex-M7 */
+    CYCLES_DWT_LAR_ = CYCLES_UNLOCK_; 
+    CYCLES_DWT_CYCCNT_ = (uint32_t)0; 
+    CYCLES_DWT_CTRL_ |= CYCLES_CYCCNTENA_; 
+}
+
+/***************************************************************************************
+*   cycles_get() Implementation.
+***************************************************************************************/
+uint32_t cycles_get(void_t)
+{
+    return CYCLES_DWT_CYCCNT_; 
+}
+
+/***************************************************************************************
+*   cycles_hz() Implementation.
+***************************************************************************************/
+uint32_t cycles_hz(void_t)
+{
+    return CYCLES_CPU_HZ; 
+}
+
+#endif  /* End of CORTEX_M */
+
+#ifdef POSIX_HOST
+
+/***************************************************************************************
+*   cycles_init() Implementation.
+***************************************************************************************/
+void_t cycles_init(void_t)
+{
+    /* CLOCK_MONOTONIC_RAW is Free-Running, Nothing to Start */
+}
+
+/***************************************************************************************
+*   cycles_get() Implementation.
+*   The Nanoseconds of CLOCK_MONOTONIC_RAW, Truncated to 32 Bits (4.29s Period), 
+*   or of the Virtual Clock in the Simulation. 
+***************************************************************************************/
+uint32_t cycles_get(void_t)
+{
+#ifdef SIM_ENABLE
+    return sim_cycles(); 
+#else
+    struct timespec now; 
+
+    clock_gettime(CLOCK_MONOTONIC_RAW, &now); 
+    return (uint32_t)((uint32_t)now.tv_sec * (uint32_t)1000000000UL + (uint32_t)now.tv_nsec); 
+#endif  /* End of SIM_ENABLE */
+}
+
+/***************************************************************************************
+*   cycles_hz() Implementation.
+***************************************************************************************/
+uint32_t cycles_hz(void_t)
+{
+    return (uint32_t)1000000000UL; 
+}
+
+#endif  /* End of POSIX_HOST */
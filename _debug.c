@@ -37,11 +37,23 @@
 #include "std_type.h"
 #include "std_def.h"
 #include "config.h"
+
+#ifdef POSIX_HOST
+#include <stdio.h>
+#endif  /* End of POSIX_HOST */
+
 #include "lock.h"
 
 #define  EXTERN_GLOBALS 
 #include "debug.h"
 
+#ifdef POSIX_HOST
+/***************************************************************************************
+*   The Stream Plays the Debugger UART on Host. 
+***************************************************************************************/
+static FILE *debug_stream_; 
+#endif  /* End of POSIX_HOST */
+
 /***************************************************************************************
 *   debug_init() Implementation.
 ***************************************************************************************/
@@ -53,7 +65,17 @@ int16_t debug_init(void_t)
     debug_buff_tail_ = (uint16_t)0;          /* Offset of where Next Byte will be Extracted  */
     debug_buff_used_ = (uint16_t)0;          /* Number of Bytes Currently in the Ring Buffer */
     /* Initialize the Debugger UART */
-
+#ifdef POSIX_HOST
+    debug_stream_ = stdout; 
+    if (DEBUG_HOST_FILE != (char const *)0) { 
+        debug_stream_ = fopen(DEBUG_HOST_FILE, "wb"); 
+        if (debug_stream_ == (FILE *)0) { 
+            debug_stream_ = stdout; 
+            return FAILURE; 
+        } 
+    } 
+#endif  /* End of POSIX_HOST */
+    return TRUE; 
 }
 
 /***************************************************************************************
@@ -104,6 +126,53 @@ int16_t debug_puts(int8_t * string)
     return TRUE; 
 }
 
+/***************************************************************************************
+*   debug_put_block() Implementation.
+***************************************************************************************/
+int16_t debug_put_block(uint8_t const * block, uint16_t size) 
+{
+    uint16_t count; 
+
+    INT_LOCK_KEY_
+
+    if ((block == (uint8_t const *)0) || (size > debug_buff_size_)) { 
+        return FAILURE; 
+    } 
+
+    INT_LOCK_();
+#ifdef POSIX_HOST
+    if ((uint32_t)debug_buff_used_ + (uint32_t)size > (uint32_t)debug_buff_size_) { 
+        /* The Host Port Never Overruns, Drain the Buffer into the Stream First */
+        (void_t)debug_flush(); 
+    } 
+#endif  /* End of POSIX_HOST */
+    /* Copy Up to the End of Ring Buffer, then Wrap Around */
+    count = (uint16_t)(debug_buff_size_ - debug_buff_head_); 
+    if (count > size) { 
+        count = size; 
+    } 
+    debug_buff_used_ = (uint16_t)(debug_buff_used_ + size); 
+    size = (uint16_t)(size - count); 
+    while (count-- > (uint16_t)0) { 
+        debug_buffer[debug_buff_head_++] = *block++; 
+    } 
+    if (debug_buff_head_ == debug_buff_size_) { 
+        debug_buff_head_ = (uint16_t)0; 
+    } 
+    while (size-- > (uint16_t)0) { 
+        debug_buffer[debug_buff_head_++] = *block++; 
+    } 
+
+    if (debug_buff_used_ > debug_buff_size_)
+    {   /* Overrun over the Old Data ? */
+        debug_buff_tail_ = debug_buff_head_;    /* Shift the Tail to the Old Data */
+        debug_buff_used_ = debug_buff_size_;    /* The whole Buffer is Used */
+    }
+    INT_UNLOCK_(); 
+    
+    return TRUE; 
+}
+
 /***************************************************************************************
 *   debug_get_byte() Implementation.
 ***************************************************************************************/
@@ -169,3 +238,37 @@ uint8_t const *debug_get_block(uint16_t *byte_count)
 *   Interrupt Service Routine Implementation for Debug Serial Port.
 ***************************************************************************************/
 
+#ifdef POSIX_HOST
+/***************************************************************************************
+*   debug_flush() Implementation.
+***************************************************************************************/
+int16_t debug_flush(void_t)
+{
+    uint8_t   block[256]; 
+    uint8_t const *begin; 
+    uint16_t  count; 
+    uint16_t  index; 
+
+    INT_LOCK_KEY_
+
+    for (;;) { 
+        /* Copy Out under the Lock, Write without It */
+        count = (uint16_t)sizeof(block); 
+        INT_LOCK_(); 
+        begin = debug_get_block(&count); 
+        for (index = (uint16_t)0; index < count; ++index) { 
+            block[index] = begin[index]; 
+        } 
+        INT_UNLOCK_(); 
+        if (count == (uint16_t)0) { 
+            break; 
+        } 
+        if (fwrite(block, (size_t)1, (size_t)count, debug_stream_) != (size_t)count) { 
+            return FAILURE; 
+        } 
+    } 
+    fflush(debug_stream_); 
+    return TRUE; 
+}
+#endif  /* End of POSIX_HOST */
+
@@ -0,0 +1,279 @@
+/***************************************************************************************
+*   The MIT License (MIT)
+*   Copyright (C) 2005 JinHui Han, <Email: ferrethan485@sohu.com, QQ: 1901589440>
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in
+*   all copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+*   THE SOFTWARE.
+***************************************************************************************/
+
+
+/***************************************************************************************
+*   Component : Active Object Application FrameWork
+*   Group : Active Object Manager
+*   File Name : _executor.c
+*   Version : 1.0
+*   Description : Multi-Core Executor of Active Objects for POSIX_HOST Port
+*   Author : JinHui Han
+*   History : 
+*          Name            Date                    Remarks
+*       JinHui Han      05-18-2005      Created Initial Version 1.0
+*       JinHui Han      05-18-2005      Verified Version 1.0
+***************************************************************************************/
+
+#include "std_type.h"
+#include "std_def.h"
+#include "config.h"
+
+#ifdef MANAGER_EXECUTOR_ENABLE
+#define _GNU_SOURCE
+/* The timer_t of <time.h> Clashes with the timer_t of Framework */
+#define timer_t posix_timer_t
+#include <pthread.h>
+#include <semaphore.h>
+#undef  timer_t
+#endif  /* End of MANAGER_EXECUTOR_ENABLE */
+
+#include "lock.h"
+#include "debug.h"
+#include "assert.h"
+#include "spyer.h"
+#include "ticks.h"
+#include "fault.h"
+#include "lookup.h"
+#include "mpool.h"
+#include "event.h"
+#include "epool.h"
+#include "cpool.h"
+#include "echain.h"
+#include "ering.h"
+#include "rchain.h"
+#include "fsm.h"
+#include "hsm.h"
+#include "active.h"
+#include "achain.h"
+#include "sche.h"
+#include "stack.h"
+#include "manager.h"
+
+#define  EXTERN_GLOBALS
+#include "executor.h"
+
+ASSERT_THIS_FILE(_executor.c)
+FAULT_THIS_FILE(_executor.c)
+SPYER_THIS_FILE(19)
+
+#ifdef MANAGER_EXECUTOR_ENABLE
+
+/***************************************************************************************
+*   Worker of Executor. 
+*
+*   The Run Queue is a Ring of the Active Objects, the Owner Takes from "head" and 
+*   the Thieves Take from "tail". An Active Object is in One Queue at Most, so 
+*   MAX_ACTIVE Entries are Enough. 
+***************************************************************************************/
+typedef struct executor_worker_tag { 
+    pthread_t   thread;             /* The Worker Thread */
+    sem_t       wake;               /* Posted when the Work is Given to the Worker */
+    active_t  * queue[MAX_ACTIVE];  /* Run Queue */
+    uint16_t    head;               /* Index of the Oldest Active Object */
+    uint16_t    count;              /* Number of the Queued Active Objects */
+    uint8_t     index;              /* Index of the Worker */
+} executor_worker_t; 
+
+static executor_worker_t executor_worker_[EXECUTOR_WORKERS]; 
+static uint32_t          executor_idle_;    /* Bit n is Set while Worker n Sleeps */
+
+/***************************************************************************************
+*   executor_push_() Implementation. Internal
+*   Called with the Interrupts Locked. 
+***************************************************************************************/
+static void_t executor_push_(executor_worker_t *worker, active_t *active)
+{
+    uint16_t tail; 
+
+    ASSERT_REQUIRE(worker -> count < (uint16_t)MAX_ACTIVE); 
+    tail = (uint16_t)((worker -> head + worker -> count) % (uint16_t)MAX_ACTIVE); 
+    worker -> queue[tail] = active; 
+    ++(worker -> count); 
+    active -> exec_ = EXECUTOR_QUEUED; 
+}
+
+/***************************************************************************************
+*   executor_pop_() Implementation. Internal
+*   Take the Oldest Active Object of the Own Queue. Called with the Interrupts Locked. 
+***************************************************************************************/
+static active_t *executor_pop_(executor_worker_t *worker)
+{
+    active_t *active; 
+
+    if (worker -> count == (uint16_t)0) { 
+        return (active_t *)0; 
+    } 
+    active = worker -> queue[worker -> head]; 
+    worker -> head = (uint16_t)((worker -> head + 1) % (uint16_t)MAX_ACTIVE); 
+    --(worker -> count); 
+    return active; 
+}
+
+/***************************************************************************************
+*   executor_steal_() Implementation. Internal
+*   Take the Newest Active Object from the Queue of Another Worker, Starting from 
+*   the Next Worker. Called with the Interrupts Locked. 
+***************************************************************************************/
+static active_t *executor_steal_(executor_worker_t *worker)
+{
+    uint8_t   step; 
+    uint16_t  tail; 
+    executor_worker_t *victim; 
+
+    for (step = (uint8_t)1; step < (uint8_t)EXECUTOR_WORKERS; ++step) { 
+        victim = &executor_worker_[(worker -> index + step) % EXECUTOR_WORKERS]; 
+        if (victim -> count != (uint16_t)0) { 
+            --(victim -> count); 
+            tail = (uint16_t)((victim -> head + victim -> count) % (uint16_t)MAX_ACTIVE); 
+            return victim -> queue[tail]; 
+        } 
+    } 
+    return (active_t *)0; 
+}
+
+/***************************************************************************************
+*   executor_wake_() Implementation. Internal
+*   Wake Up the Sleeping Worker. Called with the Interrupts Locked. 
+***************************************************************************************/
+static void_t executor_wake_(executor_worker_t *worker)
+{
+    uint32_t bit; 
+
+    bit = (uint32_t)1 << worker -> index; 
+    if ((executor_idle_ & bit) != (uint32_t)0) { 
+        executor_idle_ &= ~bit; 
+        sem_post(&(worker -> wake)); 
+    } 
+}
+
+/***************************************************************************************
+*   executor_thread_() Implementation. Internal
+*   The Worker Thread, Runs the Active Objects One RTC Step at a Time. 
+***************************************************************************************/
+static void_t *executor_thread_(void_t *arg)
+{
+    cpu_sr_t  key; 
+    int16_t   wake; 
+    active_t *active; 
+    executor_worker_t *worker; 
+
+    worker = (executor_worker_t *)arg; 
+    for (;;) { 
+        key = interrupt_enter(); 
+        active = executor_pop_(worker); 
+        if (active == (active_t *)0) { 
+            active = executor_steal_(worker); 
+        } 
+        if (active == (active_t *)0) { 
+            /* No Work, Sleep until executor_ready() Gives Some */
+            executor_idle_ |= (uint32_t)1 << worker -> index; 
+            interrupt_leave(key, FALSE); 
+            while (sem_wait(&(worker -> wake)) != 0) { 
+                /* Interrupted by Signal, Sleep Again */
+            } 
+            continue; 
+        } 
+        active -> exec_ = EXECUTOR_RUNNING; 
+        interrupt_leave(key, FALSE); 
+
+        /* One RTC Step, no Other Worker Touches the Active Object */
+        man_run(active); 
+
+        key = interrupt_enter(); 
+        if (!echain_is_empty(&(active -> event)) && (active -> pause != (int16_t)1)) { 
+            /* Events Posted during the Step, Keep It on This Worker */
+            executor_push_(worker, active); 
+        } 
+        else { 
+            /* Empty or Paused, the Next Post or active_resume() Queues It Again */
+            active -> exec_ = EXECUTOR_IDLE; 
+        } 
+        /* Wake Up the Manager if the Step Posted Events to It */
+        wake = echain_is_empty(&(man.event)) ? FALSE : TRUE; 
+        interrupt_leave(key, wake); 
+    } 
+    return (void_t *)0; 
+}
+
+/***************************************************************************************
+*   executor_init() Implementation.
+***************************************************************************************/
+int16_t executor_init(void_t)
+{
+    uint8_t index; 
+    executor_worker_t *worker; 
+
+    executor_idle_ = (uint32_t)0; 
+    for (index = (uint8_t)0; index < (uint8_t)EXECUTOR_WORKERS; ++index) { 
+        worker = &executor_worker_[index]; 
+        worker -> head   = (uint16_t)0; 
+        worker -> count  = (uint16_t)0; 
+        worker -> index  = index; 
+        if (sem_init(&(worker -> wake), 0, 0U) != 0) { 
+            return FAILURE; 
+        } 
+        /* The Worker Runs after interrupt_enable() */
+        if (pthread_create(&(worker -> thread), (pthread_attr_t *)0, 
+                           executor_thread_, (void_t *)worker) != 0) { 
+            return FAILURE; 
+        } 
+    } 
+    SPYER_MANAGER("The Executor is Initialized, %d Workers.", EXECUTOR_WORKERS); 
+    return TRUE; 
+}
+
+/***************************************************************************************
+*   executor_ready() Implementation.
+***************************************************************************************/
+int16_t executor_ready(active_t *active)
+{
+    uint8_t  index; 
+    executor_worker_t *worker; 
+
+    ASSERT_REQUIRE(active != (active_t *)0); 
+    if (active == (active_t *)0) { 
+        return FAILURE; 
+    } 
+    if (active -> exec_ != EXECUTOR_IDLE) { 
+        /* The Worker Checks the Event Chain Again after the RTC Step */
+        return FALSE; 
+    } 
+    worker = &executor_worker_[active -> slot % EXECUTOR_WORKERS]; 
+    executor_push_(worker, active); 
+    if ((executor_idle_ & ((uint32_t)1 << worker -> index)) != (uint32_t)0) { 
+        executor_wake_(worker); 
+    } 
+    else if (executor_idle_ != (uint32_t)0) { 
+        /* The Worker is Busy, Let a Sleeping Worker Steal It */
+        for (index = (uint8_t)0; index < (uint8_t)EXECUTOR_WORKERS; ++index) { 
+            if ((executor_idle_ & ((uint32_t)1 << index)) != (uint32_t)0) { 
+                executor_wake_(&executor_worker_[index]); 
+                break; 
+            } 
+        } 
+    } 
+    return TRUE; 
+}
+
+#endif  /* End of MANAGER_EXECUTOR_ENABLE */
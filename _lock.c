@@ -38,6 +38,11 @@
 #include "std_def.h"
 #include "config.h"
 
+#ifdef POSIX_HOST
+#define _GNU_SOURCE
+#include <pthread.h>
+#endif  /* End of POSIX_HOST */
+
 #define  EXTERN_GLOBALS
 #include "lock.h"
 
@@ -83,3 +88,108 @@ void_t   interrupt_restore(cpu_sr_t cpu_sr)
 }
 
 #endif  /* End of CORTEX_M */
+
+#ifdef POSIX_HOST
+
+/***************************************************************************************
+*   The Interrupt Lock of Host is a Recursive Mutex. 
+*
+*   The Main Thread Runs the Manager, the Other Threads (the Ticker and the Producers 
+*   of Test) are the Interrupts, They Hold the Mutex for the Whole "ISR" through 
+*   interrupt_enter() and interrupt_leave(), so the Critical Sections Exclude Them 
+*   as the Disabled Interrupts Do. 
+***************************************************************************************/
+static pthread_mutex_t lock_mutex_; 
+static pthread_cond_t  lock_cond_; 
+static pthread_once_t  lock_once_ = PTHREAD_ONCE_INIT; 
+static int16_t         lock_enabled_;   /* interrupt_enable() is Called */
+static uint32_t        lock_pending_;   /* Wake-Ups Signaled by the Interrupts */
+
+/***************************************************************************************
+*   lock_init_() Implementation. Internal
+***************************************************************************************/
+static void_t lock_init_(void_t)
+{
+    pthread_mutexattr_t attr; 
+
+    pthread_mutexattr_init(&attr); 
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE); 
+    pthread_mutex_init(&lock_mutex_, &attr); 
+    pthread_mutexattr_destroy(&attr); 
+    pthread_cond_init(&lock_cond_, (pthread_condattr_t *)0); 
+}
+
+/***************************************************************************************
+*   interrupt_enable() Implementation.
+***************************************************************************************/
+cpu_sr_t interrupt_enable(void_t)
+{
+    pthread_once(&lock_once_, lock_init_); 
+    pthread_mutex_lock(&lock_mutex_); 
+    /* Release the Interrupts Waiting in interrupt_enter() */
+    lock_enabled_ = TRUE; 
+    pthread_cond_broadcast(&lock_cond_); 
+    pthread_mutex_unlock(&lock_mutex_); 
+    return (cpu_sr_t)0; 
+}
+
+/***************************************************************************************
+*   interrupt_disable() Implementation.
+***************************************************************************************/
+cpu_sr_t interrupt_disable(void_t)
+{
+    pthread_once(&lock_once_, lock_init_); 
+    pthread_mutex_lock(&lock_mutex_); 
+    /* The Nesting is Counted by the Mutex, the Key is not Used */
+    return (cpu_sr_t)0; 
+}
+
+/***************************************************************************************
+*   interrupt_restore() Implementation.
+***************************************************************************************/
+void_t   interrupt_restore(cpu_sr_t cpu_sr)
+{
+    (void_t)cpu_sr; 
+    pthread_mutex_unlock(&lock_mutex_); 
+}
+
+/***************************************************************************************
+*   interrupt_enter() Implementation.
+***************************************************************************************/
+cpu_sr_t interrupt_enter(void_t)
+{
+    pthread_once(&lock_once_, lock_init_); 
+    pthread_mutex_lock(&lock_mutex_); 
+    /* The Interrupts are Held Pending until interrupt_enable() */
+    while (lock_enabled_ != TRUE) { 
+        pthread_cond_wait(&lock_cond_, &lock_mutex_); 
+    } 
+    return (cpu_sr_t)0; 
+}
+
+/***************************************************************************************
+*   interrupt_leave() Implementation.
+***************************************************************************************/
+void_t   interrupt_leave(cpu_sr_t cpu_sr, int16_t wake)
+{
+    (void_t)cpu_sr; 
+    if (wake == TRUE) { 
+        ++lock_pending_; 
+        pthread_cond_broadcast(&lock_cond_); 
+    } 
+    pthread_mutex_unlock(&lock_mutex_); 
+}
+
+/***************************************************************************************
+*   interrupt_wait() Implementation.
+***************************************************************************************/
+void_t   interrupt_wait(void_t)
+{
+    /* The Mutex is Locked Once by the Caller, pthread_cond_wait() Releases It */
+    while (lock_pending_ == (uint32_t)0) { 
+        pthread_cond_wait(&lock_cond_, &lock_mutex_); 
+    } 
+    lock_pending_ = (uint32_t)0; 
+}
+
+#endif  /* End of POSIX_HOST */
@@ -0,0 +1,318 @@
+/***************************************************************************************
+*   The MIT License (MIT)
+*   Copyright (C) 2005 JinHui Han, <Email: ferrethan485@sohu.com, QQ: 1901589440>
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in
+*   all copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+*   THE SOFTWARE.
+***************************************************************************************/
+
+
+/***************************************************************************************
+*   Component : Active Object Application FrameWork
+*   Group : Memory Pool
+*   File Name : _magazine.c
+*   Version : 1.0
+*   Description : Per-Thread Magazines of Memory Pools for POSIX_HOST Port
+*   Author : JinHui Han
+*   History : 
+*          Name            Date                    Remarks
+*       JinHui Han      05-23-2005      Created Initial Version 1.0
+*       JinHui Han      05-23-2005      Verified Version 1.0
+***************************************************************************************/
+
+#include "std_type.h"
+#include "std_def.h"
+#include "config.h"
+
+#ifdef MPOOL_MAGAZINE_ENABLE
+/* The timer_t of <time.h> Clashes with the timer_t of Framework */
+#define timer_t posix_timer_t
+#include <pthread.h>
+#undef  timer_t
+#endif  /* End of MPOOL_MAGAZINE_ENABLE */
+
+#include "lock.h"
+#include "debug.h"
+#include "assert.h"
+#include "spyer.h"
+#include "ticks.h"
+#include "fault.h"
+#include "mpool.h"
+
+#define  EXTERN_GLOBALS
+#include "magazine.h"
+
+ASSERT_THIS_FILE(_magazine.c)
+FAULT_THIS_FILE(_magazine.c)
+SPYER_THIS_FILE(21)
+
+#ifdef MPOOL_MAGAZINE_ENABLE
+
+/***************************************************************************************
+*   Magazine of One Pool, the Stack of the Cached Blocks. 
+***************************************************************************************/
+typedef struct magazine_tag { 
+    mpool_t   * pool;                   /* The Pool, NULL is Free */
+    uint16_t    count;                  /* Number of the Cached Blocks */
+    void_t    * block[MAGAZINE_SIZE];   /* The Cached Blocks */
+} magazine_t; 
+
+/***************************************************************************************
+*   Magazines of One Thread. 
+***************************************************************************************/
+typedef struct magazine_thread_tag { 
+    magazine_t      magazine[MAGAZINE_POOLS]; 
+    magazine_stat_t stat; 
+    int16_t         keyed;      /* The Exit of Thread is Hooked */
+} magazine_thread_t; 
+
+static __thread magazine_thread_t magazine_thread_; 
+static magazine_stat_t  magazine_global_;   /* Updated with the Atomics */
+static pthread_key_t    magazine_key_;      /* Drains the Magazines at the Exit */
+static pthread_once_t   magazine_once_ = PTHREAD_ONCE_INIT; 
+
+/***************************************************************************************
+*   magazine_exit_() Implementation. Internal
+*   Destructor of the Key, Drain the Magazines of the Exiting Thread. 
+***************************************************************************************/
+static void_t magazine_exit_(void_t *arg)
+{
+    (void_t)arg; 
+    magazine_flush(); 
+}
+
+/***************************************************************************************
+*   magazine_hook_() Implementation. Internal
+*   Create the Key whose Destructor Drains the Magazines. 
+***************************************************************************************/
+static void_t magazine_hook_(void_t)
+{
+    pthread_key_create(&magazine_key_, magazine_exit_); 
+}
+
+/***************************************************************************************
+*   magazine_find_() Implementation. Internal
+*   Return the Magazine of the Pool for the Calling Thread, Take a Free Magazine 
+*   for the New Pool. NULL if All the Magazines are Taken by the Other Pools. 
+***************************************************************************************/
+static magazine_t *magazine_find_(mpool_t *pool)
+{
+    uint16_t index; 
+    magazine_t *free; 
+    magazine_thread_t *thread; 
+
+    thread = &magazine_thread_; 
+    free = (magazine_t *)0; 
+    for (index = (uint16_t)0; index < (uint16_t)MAGAZINE_POOLS; ++index) { 
+        if (thread->magazine[index].pool == pool) { 
+            return &thread->magazine[index]; 
+        } 
+        if ((free == (magazine_t *)0) && (thread->magazine[index].pool == (mpool_t *)0)) { 
+            free = &thread->magazine[index]; 
+        } 
+    } 
+    if (free != (magazine_t *)0) { 
+        if (thread->keyed == (int16_t)0) { 
+            /* Hook the Exit of Thread before the First Block is Cached */
+            pthread_once(&magazine_once_, magazine_hook_); 
+            pthread_setspecific(magazine_key_, (void_t *)thread); 
+            thread->keyed = (int16_t)1; 
+        } 
+        free->pool  = pool; 
+        free->count = (uint16_t)0; 
+    } 
+    return free; 
+}
+
+/***************************************************************************************
+*   magazine_count_() Implementation. Internal
+*   Account the Blocks Entering (delta > 0) or Leaving the Magazines. 
+***************************************************************************************/
+static void_t magazine_count_(int32_t delta)
+{
+    uint32_t cached; 
+    uint32_t max; 
+    magazine_stat_t *stat; 
+
+    stat = &magazine_thread_.stat; 
+    stat->cached = (uint32_t)((int32_t)stat->cached + delta); 
+    if (stat->cached > stat->max_cached) { 
+        stat->max_cached = stat->cached; 
+    } 
+
+    cached = __atomic_add_fetch(&magazine_global_.cached, (uint32_t)delta, __ATOMIC_RELAXED); 
+    max = __atomic_load_n(&magazine_global_.max_cached, __ATOMIC_RELAXED); 
+    while ((cached > max) && !__atomic_compare_exchange_n(&magazine_global_.max_cached, 
+            &max, cached, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) { 
+        /* "max" is Reloaded by the Failed Swap */
+    } 
+}
+
+/***************************************************************************************
+*   magazine_refill_() Implementation. Internal
+*   Take the Half of Magazine from the Pool, mpool_get_n() Splices the Segment off 
+*   the Free List in One Critical Section. 
+***************************************************************************************/
+static void_t magazine_refill_(magazine_t *magazine)
+{
+    uint16_t count; 
+
+    count = magazine->count; 
+    if (count >= (uint16_t)(MAGAZINE_SIZE / 2)) { 
+        return; 
+    } 
+
+    /* Running Short is not Asserted, the Empty Pool Gives 0 Blocks */
+    magazine->count += mpool_get_n(magazine->pool, (uint16_t)(MAGAZINE_SIZE / 2) - count, 
+                                   &(magazine->block[count])); 
+
+    if (magazine->count != count) { 
+        ++magazine_thread_.stat.refills; 
+        __atomic_add_fetch(&magazine_global_.refills, (uint32_t)1, __ATOMIC_RELAXED); 
+        magazine_count_((int32_t)magazine->count - (int32_t)count); 
+    } 
+}
+
+/***************************************************************************************
+*   magazine_drain_() Implementation. Internal
+*   Put the Blocks Back to the Pool until "keep" Remain, mpool_put_n() Links Them 
+*   outside the Lock and Splices Them into the Free List in One Critical Section. 
+***************************************************************************************/
+static void_t magazine_drain_(magazine_t *magazine, uint16_t keep)
+{
+    uint16_t count; 
+
+    count = magazine->count; 
+    if (count <= keep) { 
+        return; 
+    } 
+
+    mpool_put_n(&(magazine->block[keep]), (uint16_t)(count - keep)); 
+    magazine->count = keep; 
+
+    ++magazine_thread_.stat.drains; 
+    __atomic_add_fetch(&magazine_global_.drains, (uint32_t)1, __ATOMIC_RELAXED); 
+    magazine_count_((int32_t)magazine->count - (int32_t)count); 
+}
+
+/***************************************************************************************
+*   magazine_get() Implementation.
+***************************************************************************************/
+void_t *magazine_get(mpool_t *me)
+{
+    magazine_t *magazine; 
+
+    ASSERT_REQUIRE(me != (mpool_t *)0);
+    if (me == (mpool_t *)0) { 
+        return NULL; 
+    }
+
+    magazine = magazine_find_(me); 
+    if (magazine == (magazine_t *)0) { 
+        ++magazine_thread_.stat.bypass; 
+        __atomic_add_fetch(&magazine_global_.bypass, (uint32_t)1, __ATOMIC_RELAXED); 
+        return mpool_get(me); 
+    } 
+    if (magazine->count == (uint16_t)0) { 
+        magazine_refill_(magazine); 
+    } 
+#ifdef MPOOL_ELASTIC_ENABLE
+    if (magazine->count == (uint16_t)0) { 
+        /* The Pool is Empty, mpool_get() Borrows a Batch from hpool */
+        return mpool_get(me); 
+    } 
+#endif  /* End of MPOOL_ELASTIC_ENABLE */
+    ASSERT_ENSURE(magazine->count != (uint16_t)0);  /* The Pool Runs out of Blocks */
+    if (magazine->count == (uint16_t)0) { 
+        return NULL; 
+    } 
+
+    magazine_count_((int32_t)-1); 
+    return magazine->block[--magazine->count]; 
+}
+
+/***************************************************************************************
+*   magazine_put() Implementation.
+***************************************************************************************/
+int16_t magazine_put(void_t *block)
+{
+    mpool_t *mpool; 
+    magazine_t *magazine; 
+
+    ASSERT_REQUIRE(block != (void_t *)0);
+    if (block == (void_t *)0) { 
+        return FAILURE; 
+    } 
+
+    /* Get the Memory Pool Pointer, mpool_put() Checks It when the Block is Drained */
+    mpool = MPOOL_OWNER(block); 
+    ASSERT_REQUIRE(mpool != (mpool_t *)0); 
+    if (mpool == (mpool_t *)0) { 
+        return FAILURE; 
+    } 
+
+    magazine = magazine_find_(mpool); 
+    if (magazine == (magazine_t *)0) { 
+        ++magazine_thread_.stat.bypass; 
+        __atomic_add_fetch(&magazine_global_.bypass, (uint32_t)1, __ATOMIC_RELAXED); 
+        return mpool_put(block); 
+    } 
+    if (magazine->count >= (uint16_t)MAGAZINE_SIZE) { 
+        magazine_drain_(magazine, (uint16_t)(MAGAZINE_SIZE / 2)); 
+    } 
+
+    magazine->block[magazine->count++] = block; 
+    magazine_count_((int32_t)1); 
+    return TRUE; 
+}
+
+/***************************************************************************************
+*   magazine_flush() Implementation.
+***************************************************************************************/
+void_t magazine_flush(void_t)
+{
+    uint16_t index; 
+    magazine_t *magazine; 
+
+    for (index = (uint16_t)0; index < (uint16_t)MAGAZINE_POOLS; ++index) { 
+        magazine = &magazine_thread_.magazine[index]; 
+        if (magazine->pool != (mpool_t *)0) { 
+            magazine_drain_(magazine, (uint16_t)0); 
+            magazine->pool = (mpool_t *)0;  /* Free the Magazine for Another Pool */
+        } 
+    } 
+}
+
+/***************************************************************************************
+*   magazine_snap() Implementation.
+***************************************************************************************/
+void_t magazine_snap(magazine_stat_t *thread, magazine_stat_t *global)
+{
+    if (thread != (magazine_stat_t *)0) { 
+        *thread = magazine_thread_.stat; 
+    } 
+    if (global != (magazine_stat_t *)0) { 
+        global->cached     = __atomic_load_n(&magazine_global_.cached,     __ATOMIC_RELAXED); 
+        global->max_cached = __atomic_load_n(&magazine_global_.max_cached, __ATOMIC_RELAXED); 
+        global->refills    = __atomic_load_n(&magazine_global_.refills,    __ATOMIC_RELAXED); 
+        global->drains     = __atomic_load_n(&magazine_global_.drains,     __ATOMIC_RELAXED); 
+        global->bypass     = __atomic_load_n(&magazine_global_.bypass,     __ATOMIC_RELAXED); 
+    } 
+}
+
+#endif  /* End of MPOOL_MAGAZINE_ENABLE */
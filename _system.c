@@ -46,10 +46,6 @@
 ***************************************************************************************/
 int16_t system_init(void_t)
 {
+    /* Initialize the System Hardware at Here, Nothing to Do on POSIX_HOST */
+    return TRUE; 
 }
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif      /* End of _SYSTEM_H */
@@ -37,12 +37,86 @@
 #include "std_type.h"
 #include "std_def.h"
 #include "config.h"
+
+#ifdef POSIX_HOST
+#define _GNU_SOURCE
+/* The timer_t of <time.h> Clashes with the timer_t of Framework */
+#define timer_t posix_timer_t
+#include <pthread.h>
+#include <time.h>
+#undef  timer_t
+#endif  /* End of POSIX_HOST */
+
+#include "lock.h"
+#include "debug.h"
 #include "ticks.h"
+#include "mpool.h"
+#include "event.h"
 #include "timer.h"
 
 #define  EXTERN_GLOBALS
 #include "ticker.h"
 
+#ifdef POSIX_HOST
+/***************************************************************************************
+*   The Period of Clock Tick in Nanoseconds. 
+***************************************************************************************/
+#define TICKER_PERIOD_NS_   ((long)(1000000000L / (long)TICKER))
+
+static pthread_t ticker_thread_; 
+#ifdef TICKER_TICKLESS_ENABLE
+static uint32_t  ticker_budget_;    /* Ticks to Sleep, 0 when the Clock Tick Runs */
+static uint32_t  ticker_slept_;     /* Ticks Elapsed while the Clock Tick is Stopped */
+#endif  /* End of TICKER_TICKLESS_ENABLE */
+
+#ifndef SIM_ENABLE
+/***************************************************************************************
+*   ticker_isr_() Implementation. Internal
+*   The Time-Tick "ISR" of Host, the Thread Wakes Up on the Absolute Deadlines of 
+*   CLOCK_MONOTONIC, so the Clock Tick does not Drift. 
+***************************************************************************************/
+static void_t *ticker_isr_(void_t *arg)
+{
+    cpu_sr_t key; 
+    int16_t  wake; 
+    struct timespec next; 
+
+    (void_t)arg; 
+    clock_gettime(CLOCK_MONOTONIC, &next); 
+    for (;;) { 
+        next.tv_nsec += TICKER_PERIOD_NS_; 
+        if (next.tv_nsec >= 1000000000L) { 
+            next.tv_nsec -= 1000000000L; 
+            ++next.tv_sec; 
+        } 
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, 
+                               (struct timespec *)0) != 0) { 
+            /* Interrupted by Signal, Sleep Again */
+        } 
+        key  = interrupt_enter(); 
+        wake = TRUE; 
+#ifdef TICKER_TICKLESS_ENABLE
+        if (ticker_budget_ != (uint32_t)0) { 
+            /* The Clock Tick is Stopped, Count the Tick for ticker_catchup() */
+            ++ticker_slept_; 
+            /* Wake Up the Manager when the Wake-Up Timer Expires */
+            wake = (ticker_slept_ >= ticker_budget_) ? TRUE : FALSE; 
+        } 
+        else { 
+            ticker (); 
+        } 
+#else
+        ticker (); 
+#endif  /* End of TICKER_TICKLESS_ENABLE */
+        interrupt_leave(key, wake); 
+        /* Play the Transmit ISR of Debug Serial Port */
+        debug_flush (); 
+    } 
+    return (void_t *)0; 
+}
+#endif  /* End of SIM_ENABLE */
+#endif  /* End of POSIX_HOST */
+
 /***************************************************************************************
 *   ticker_init() Implementation.
 ***************************************************************************************/
@@ -54,6 +128,10 @@ void_t ticker_init(void_t)
     /* Initialize the Timer */
     timer_init (); 
     /* Initialize the Time-Tick ISR (or the Highest-Priority Task) */
+#if defined(POSIX_HOST) && !defined(SIM_ENABLE)
+    /* The Thread Runs after interrupt_enable(), the Simulator Calls ticker() Itself */
+    pthread_create(&ticker_thread_, (pthread_attr_t *)0, ticker_isr_, (void_t *)0); 
+#endif  /* End of POSIX_HOST && !SIM_ENABLE */
     
     /* Spyer */
 }
@@ -64,9 +142,46 @@ void_t ticker_init(void_t)
 void_t ticker(void_t) 
 {
     /* Increment the System Ticks */
-    ticks_increment (); 
+    ticks_increase (); 
     /* Call the Timer Task */
     timer (); 
     /* Spyer */
 }
 
+#ifdef TICKER_TICKLESS_ENABLE
+/***************************************************************************************
+*   ticker_catchup() Implementation.
+***************************************************************************************/
+void_t ticker_catchup(uint32_t elapsed) 
+{
+    uint32_t step; 
+
+    while (elapsed > (uint32_t)0) { 
+        /* Never Step over the Next Timer Expiry */
+        step = timer_next (); 
+        if (step > elapsed) { 
+            step = elapsed; 
+        } 
+        ticks_advance (step); 
+        timer_advance (step); 
+        elapsed -= step; 
+    } 
+}
+
+#ifdef POSIX_HOST
+/***************************************************************************************
+*   ticker_sleep() Implementation.
+***************************************************************************************/
+void_t ticker_sleep(uint32_t ticks) 
+{
+    /* Stop the Clock Tick, and Program the Wake-Up Timer */
+    ticker_budget_ = (ticks == (uint32_t)0) ? (uint32_t)1 : ticks; 
+    ticker_slept_  = (uint32_t)0; 
+    interrupt_wait (); 
+    /* Restart the Clock Tick, Catch up the Ticks Slept */
+    ticker_budget_ = (uint32_t)0; 
+    ticker_catchup (ticker_slept_); 
+}
+#endif  /* End of POSIX_HOST */
+#endif  /* End of TICKER_TICKLESS_ENABLE */
+
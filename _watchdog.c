@@ -56,8 +56,9 @@ FAULT_THIS_FILE(watchdog.c)
 int16_t watchdog_init(void_t)
 {
 #ifdef WATCHDOG_ENABLE
-    /* Append Code at Here */
+    /* Append Code at Here, No Watchdog on POSIX_HOST */
 #endif  /* End of WATCHDOG_ENABLE */
+    return TRUE; 
 }
 
 /***************************************************************************************
@@ -66,6 +67,7 @@ int16_t watchdog_init(void_t)
 int16_t watchdog_feed(void_t)
 {
 #ifdef WATCHDOG_ENABLE
-    /* Append Code at Here */
+    /* Append Code at Here, No Watchdog on POSIX_HOST */
 #endif  /* End of WATCHDOG_ENABLE */
+    return TRUE; 
 }
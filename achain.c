@@ -44,7 +44,11 @@
 #include "ticks.h"
 #include "fault.h"
 #include "mpool.h"
+#include "event.h"
 #include "cpool.h"
+#include "echain.h"
+#include "fsm.h"
+#include "hsm.h"
 #include "active.h"
 
 #define  EXTERN_GLOBALS
@@ -52,6 +56,7 @@
 
 ASSERT_THIS_FILE(achain.c)
 FAULT_THIS_FILE(achain.c)
+SPYER_THIS_FILE(1)
 
 /***************************************************************************************
 *   achain_init() Implementation.
@@ -115,7 +120,7 @@ int16_t achain_bind(chain_t **me, active_t *active)
     /* The Active Object Has Bind in Chain Pool ? */
     if (achain_find(me, active) != (chain_t *)0) { 
         /* Find It */
-        SPYER_ACHAIN("Active Object %X Has Bind in Active Object Chain %X. TimeStamp %d", \\
+        SPYER_ACHAIN("Active Object %X Has Bind in Active Object Chain %X. TimeStamp %d", \
                       active, me, ticks_get()); 
         return TRUE; 
     } 
@@ -136,11 +141,11 @@ int16_t achain_bind(chain_t **me, active_t *active)
         chain->fore = chain;
     }
     else {  /* The Priority-Based Active Object Chain is Not NULL */
+        /* Get the Pointer of the Highest Priority Active Object */
+        current = *me;
         /* The Priority of "active" is High than The Highest Priority Active Object ? */
         if(active->priority < ((active_t *)(current->builtin))->priority) {   
             /* Yes, It High Than The Highest Priority Active Object */
-            /* Get the Pointer of the Highest Priority Active Object */
-            current = *me;
             /* Append this Active Object into The Head of Active Object Chain */
             chain->next  = current;
             chain->fore  = current->fore;  /* Circulated Bidirectional List */
@@ -170,7 +175,7 @@ int16_t achain_bind(chain_t **me, active_t *active)
         }
     }
 
-    SPYER_ACHAIN("Active Object %X is Bind into Active Object Chain %X. TimeStamp %d", \\
+    SPYER_ACHAIN("Active Object %X is Bind into Active Object Chain %X. TimeStamp %d", \
                   active, me, ticks_get()); 
 
     return TRUE; 
@@ -195,7 +200,7 @@ int16_t achain_unbind(chain_t **me, active_t *active)
     chain = achain_find(me, active); 
     if (chain == (chain_t *)0) { 
         /* Dont' Find It */
-        SPYER_ACHAIN("Active Object %X Has Unbind from Active Object Chain %X. TimeStamp %d", \\
+        SPYER_ACHAIN("Active Object %X Has Unbind from Active Object Chain %X. TimeStamp %d", \
                       active, me, ticks_get()); 
         return TRUE; 
     } 
@@ -218,7 +223,7 @@ int16_t achain_unbind(chain_t **me, active_t *active)
     ret = cpool_put((chain_t *)chain); 
     ASSERT_ENSURE(ret == TRUE); 
 
-    SPYER_ACHAIN("Active Object %X is Unbind from Active Object Chain %X. TimeStamp %d", \\
+    SPYER_ACHAIN("Active Object %X is Unbind from Active Object Chain %X. TimeStamp %d", \
                   active, me, ticks_get()); 
 
     return TRUE;
@@ -99,7 +99,8 @@ ACHAIN_EXT int16_t achain_bind(chain_t **me, active_t *active);
 ACHAIN_EXT int16_t achain_unbind(chain_t **me, active_t *active);
 
 #ifdef SPYER_ACHAIN_ENABLE   /* Spy Debuger Enabled */
-    #define SPYER_ACHAIN(format, ...)   spyer_((const int8_t *)format, ##__VA_ARGS__)
+    #define SPYER_ACHAIN(format, ...)   \
+        spyer_ch_(SPYER_CH_ACHAIN, (const int8_t *)format, ##__VA_ARGS__)
 #else                       /* Spyer Debuger Disabled */
     #define SPYER_ACHAIN(format, ...)   ((void_t)0)
 #endif  /* End of SPYER_ACHAIN_ENABLE */
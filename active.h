@@ -67,6 +67,35 @@ extern "C" {
 *   NOTE: Active Object Instance MUST be Static, Because achain_unbind() Does not execute
 *         the Release Operation for Active Object Instance.
 ***************************************************************************************/
+#ifdef ACTIVE_PROFILE_ENABLE
+    #ifndef ACTIVE_PROFILE_BUCKETS
+        /*******************************************************************************
+        *   This Constant Defines the Number of Buckets of the Log2 Histograms. The 
+        *   Bucket n Counts the Samples in [2^n, 2^(n+1)) Cycles, the Last Bucket 
+        *   Counts All the Larger Samples Too. 
+        *******************************************************************************/
+        #define ACTIVE_PROFILE_BUCKETS  24      /* Default is 24 */
+    #endif      /* End of ACTIVE_PROFILE_BUCKETS */
+
+/***************************************************************************************
+*   Run-Time Profile of Active Object. 
+*
+*   All the Times are in the Units of the Cycle Counter (cycles_hz()). 
+*   (1) "wait" is the Time from echain_post() to the Dispatch of the Event. 
+*   (2) "step" is the Time of hsm->dispatch() for One Event. 
+*   (3) "busy" is the Total Time Spent in run(), which is Called by the Manager. 
+***************************************************************************************/
+typedef struct active_profile_tag { 
+    uint32_t  events;       /* Events Dispatched */
+    uint32_t  runs;         /* Calls of run() by the Manager */
+    uint32_t  busy;         /* Total Cycles in run(), Wraps Around */
+    uint32_t  wait_max;     /* Maximum Queue Wait */
+    uint32_t  step_max;     /* Maximum RTC Step */
+    uint32_t  wait[ACTIVE_PROFILE_BUCKETS];     /* Log2 Histogram of Queue Wait */
+    uint32_t  step[ACTIVE_PROFILE_BUCKETS];     /* Log2 Histogram of RTC Step */
+} active_profile_t; 
+#endif  /* End of ACTIVE_PROFILE_ENABLE */
+
 /* Forward Declaration  */
 struct active_tag;
 /* The Signature of Active Function  */
@@ -88,13 +117,31 @@ typedef struct active_tag {
     /*  Where Lower Numerical Values Correspond to Higher Priority (urgency) */
     /*  Range from 0 to 65535, Where 0 Represents the Highest Priority. */
     uint16_t  priority;
+    /*  Unique Slot in the Ready Set of Manager, Range from 0 to (MAX_ACTIVE - 1), */
+    /*  Where Lower Slot Correspond to Higher Priority. Used Only When the Ready */
+    /*  Set Scheduler is Enabled (MANAGER_READY_SET_ENABLE). */
+    uint8_t   slot; 
+#ifdef SPYER_FILTER_ENABLE
+    /*  Trace Flag, All the Spyer Records Emitted in the RTC Step of the Active */
+    /*  Object Pass the Runtime Filter when It is 1. Set by the Manager. */
+    uint8_t   trace; 
+#endif  /* End of SPYER_FILTER_ENABLE */
+#ifdef MANAGER_EXECUTOR_ENABLE
+    /*  State in the Executor (EXECUTOR_IDLE/QUEUED/RUNNING), Changed by the */
+    /*  Executor Only. Zero (Idle) for the Static Active Object. */
+    uint8_t   exec_; 
+#endif  /* End of MANAGER_EXECUTOR_ENABLE */
+#ifdef ACTIVE_PROFILE_ENABLE
+    /*  Run-Time Profile, Cleared by active_profile_snap() */
+    active_profile_t profile; 
+#endif  /* End of ACTIVE_PROFILE_ENABLE */
     /*  NOTE: me->hsm and me->fsm is Used for Indicate the Exit Status of State */
     /*  Machine Also, when me->hsm = NULL or me->fsm = NULL. */
     hsm_t * hsm;        /* The Pointer of HSM hsm_t */
     fsm_t * fsm;        /* The Pointer of FSM fsm_t */
     /*  Event Chain. */
-    chain_t * event;    /* The Pointer of Event Chain */
-    chain_t * defer;    /* The Pointer of Defer Event Chain */
+    echain_t  event;    /* The Event Chain */
+    echain_t  defer;    /* The Defer Event Chain */
     /***********************************************************************************
     *   The Object's Behavior.
     ***********************************************************************************/
@@ -104,9 +151,9 @@ typedef struct active_tag {
     active_function_t probe;            /* Probe, Must be Imeplemented by User */
     active_function_t flushout;         /* Flush Out the Event Chain */
     active_function_t run;              /* Run, Return the IDLE Status */
-    active_function_t reset;            /* Request Reset */
+    active_function_t req_reset;        /* Request Reset */
     active_function_t quit;             /* Request Quit */
-    active_function_t pause;            /* Request Pause */
+    active_function_t req_pause;        /* Request Pause */
     active_function_t resume;           /* Request Resume */
     active_function_t on_idle;          /* Is in Idle State */
     active_function_t callback_exit;    /* Exit  Callback */
@@ -34,6 +34,8 @@
 *       JinHui Han      03-03-2005      Verified Version 1.0
 ***************************************************************************************/
 
+#include <stdio.h>
+
 #include "std_type.h"
 #include "std_def.h"
 #include "config.h"
@@ -48,19 +50,80 @@
 #include "epool.h"
 #include "cpool.h"
 #include "echain.h"
+#include "ering.h"
 #include "rchain.h"
 #include "fsm.h"
 #include "hsm.h"
 #include "active.h"
 #include "achain.h"
 #include "callback.h"
+#include "stack.h"
+#include "lookup.h"
+#include "sche.h"
 #include "manager.h"
+#include "cycles.h"
 
 #define  EXTERN_GLOBALS
 #include "activex.h" 
 
 ASSERT_THIS_FILE(activex.c)
 FAULT_THIS_FILE(activex.c)
+SPYER_THIS_FILE(2)
+
+#ifdef ACTIVE_PROFILE_ENABLE
+/***************************************************************************************
+*   active_log2_() Implementation. Internal
+*   Return the Bucket of Log2 Histogram for the "cycles". 
+***************************************************************************************/
+static uint8_t active_log2_(uint32_t cycles)
+{
+    uint8_t  bucket; 
+
+    bucket = (uint8_t)0; 
+    if (cycles >= ((uint32_t)1 << 16)) { cycles >>= 16; bucket += (uint8_t)16; } 
+    if (cycles >= ((uint32_t)1 <<  8)) { cycles >>=  8; bucket += (uint8_t)8;  } 
+    if (cycles >= ((uint32_t)1 <<  4)) { cycles >>=  4; bucket += (uint8_t)4;  } 
+    if (cycles >= ((uint32_t)1 <<  2)) { cycles >>=  2; bucket += (uint8_t)2;  } 
+    if (cycles >= ((uint32_t)1 <<  1)) {                bucket += (uint8_t)1;  } 
+    if (bucket >= (uint8_t)ACTIVE_PROFILE_BUCKETS) { 
+        bucket = (uint8_t)(ACTIVE_PROFILE_BUCKETS - 1); 
+    } 
+    return bucket; 
+}
+
+/***************************************************************************************
+*   active_dispatch_() Implementation. Internal
+*   Dispatch the Event to HSM of Active Object, and Profile the Queue Wait and the 
+*   RTC Step. 
+***************************************************************************************/
+static int16_t active_dispatch_(active_t *me, event_t *event)
+{
+    int16_t  ret; 
+    uint32_t start; 
+    uint32_t cycles; 
+    active_profile_t *profile; 
+
+    profile = (active_profile_t *)&(me->profile); 
+    start  = cycles_get(); 
+    cycles = start - event->stamp_; 
+    ++(profile->wait[active_log2_(cycles)]); 
+    if (cycles > profile->wait_max) { 
+        profile->wait_max = cycles; 
+    } 
+    ret = (*(me->hsm->dispatch))(me->hsm, event); 
+    cycles = cycles_get() - start; 
+    ++(profile->step[active_log2_(cycles)]); 
+    if (cycles > profile->step_max) { 
+        profile->step_max = cycles; 
+    } 
+    ++(profile->events); 
+    return ret; 
+}
+
+#define ACTIVE_DISPATCH_(me_, event_)   active_dispatch_((me_), (event_))
+#else
+#define ACTIVE_DISPATCH_(me_, event_)   ((*((me_)->hsm->dispatch))((me_)->hsm, (event_)))
+#endif  /* End of ACTIVE_PROFILE_ENABLE */
 
 /***************************************************************************************
 *   active_version() Implementation.
@@ -93,30 +156,22 @@ int8_t const ROM_KEYWORDS * active_name(void_t)
 ***************************************************************************************/
 int16_t active_flushout(active_t *me) 
 {
-    event_t *event;
+    int16_t ret;
 
     ASSERT_REQUIRE(me != (active_t *)0); 
     if (me == (active_t *)0) { 
         return FAILURE; 
     } 
 
-    /* Flush Out the Defer Event */
-    while (me->defer != (chain_t *)0) { 
-        /* Get One Event from Defer Event Chain */
-        event = echain_get((chain_t **)&(me->defer)); 
-        /* Release the Event */
-        epool_release(event); 
-        SPYER_ACTIVEX("Event[%X] is Flush Out from Defer Chain[%X] of Active Object[%X]. TimeStamp %d", \\
-                       event, me->defer, me, ticks_get()); 
-    } 
-    while (me->event != (chain_t *)0) { 
-        /* Get One Event from Event Chain */
-        event = echain_get((chain_t **)&(me->event)); 
-        /* Release the Event */
-        epool_release(event); 
-        SPYER_ACTIVEX("Event[%X] is Flush Out from Event Chain[%X] of Active Object[%X]. TimeStamp %d", \\
-                       event, me->event, me, ticks_get()); 
-    } 
+    /* Flush Out the Defer Event, the Events are Released in Batches */
+    ret = echain_flush((echain_t *)&(me->defer)); 
+    ASSERT_ENSURE(ret == TRUE); 
+    SPYER_ACTIVEX("Defer Chain[%X] of Active Object[%X] is Flush Out, Result %d. TimeStamp %d", \
+                   &(me->defer), me, ret, ticks_get()); 
+    ret = echain_flush((echain_t *)&(me->event)); 
+    ASSERT_ENSURE(ret == TRUE); 
+    SPYER_ACTIVEX("Event Chain[%X] of Active Object[%X] is Flush Out, Result %d. TimeStamp %d", \
+                   &(me->event), me, ret, ticks_get()); 
     return  TRUE; 
 }
 
@@ -137,7 +192,7 @@ int16_t active_run(active_t *me)
         ASSERT_REQUIRE(me->callback_exit != (active_function_t)0); 
         if (me->callback_exit != (active_function_t)0) { 
             if ((*(me->callback_exit))(me) == TRUE) { 
-                me -> exit == (int16_t)0; 
+                me -> exit = (int16_t)0; 
                 return TRUE; 
             } 
         } 
@@ -147,7 +202,7 @@ int16_t active_run(active_t *me)
         ASSERT_REQUIRE(me->callback_reset != (active_function_t)0); 
         if (me->callback_reset != (active_function_t)0) { 
             if ((*(me->callback_reset))(me) == TRUE) { 
-                me -> reset == (int16_t)0; 
+                me -> reset = (int16_t)0; 
                 return TRUE; 
             } 
         } 
@@ -163,11 +218,11 @@ int16_t active_run(active_t *me)
     ASSERT_REQUIRE(me->hsm->is_idle != (hsm_function_t)0); 
     if (me->hsm->is_idle != (hsm_function_t)0) { 
         if ((*(me->hsm->is_idle))(me->hsm) == TRUE) { 
-            if (me->defer != (chain_t *)0) { 
-                event = echain_get((chain_t **)&(me->defer)); 
+            if (!echain_is_empty(&(me->defer))) { 
+                event = echain_get((echain_t *)&(me->defer)); 
                 /* Dispatch the Event to Object's HSM */
                 if (me->hsm->dispatch != (hsm_dispatch_t)0) { 
-                    (*(me->hsm->dispatch))(me->hsm, event); 
+                    ACTIVE_DISPATCH_(me, event); 
                 } 
                 /* Release the Event */
                 epool_release(event); 
@@ -175,22 +230,22 @@ int16_t active_run(active_t *me)
                 if (me->hsm->service != (hsm_function_t)0) { 
                     (*(me->hsm->service))(me->hsm); 
                 } 
-                SPYER_ACTIVEX("Event[%X] is Dispatch to HSM[%X] of Active Object[%X]. TimeStamp %d", \\
+                SPYER_ACTIVEX("Event[%X] is Dispatch to HSM[%X] of Active Object[%X]. TimeStamp %d", \
                     event, me->hsm, me, ticks_get()); 
                 return TRUE; 
             } 
         } 
     } 
-    if (me->event != (chain_t *)0) { 
-        event = echain_get((chain_t **)&(me->event)); 
+    if (!echain_is_empty(&(me->event))) { 
+        event = echain_get((echain_t *)&(me->event)); 
         /* Dispatch the Event to Object's HSM */
         ret = TRUE;  
         if (me->hsm->dispatch != (hsm_dispatch_t)0) { 
-            ret = (*(me->hsm->dispatch))(me->hsm, event); 
+            ret = ACTIVE_DISPATCH_(me, event); 
         } 
         if (ret != TRUE) { 
             /* Post into Defer Chain, Wait Idle State to Solve It */
-            echain_post((chain_t **)&(me->defer), event)
+            echain_post((echain_t *)&(me->defer), event); 
             return TRUE; 
         } 
         /* Release the Event */
@@ -198,7 +253,7 @@ int16_t active_run(active_t *me)
         if (me->hsm->service != (hsm_function_t)0) { 
             (*(me->hsm->service))(me->hsm); 
         } 
-        SPYER_ACTIVEX("Event[%X] is Dispatch to HSM[%X] of Active Object[%X]. TimeStamp %d", \\
+        SPYER_ACTIVEX("Event[%X] is Dispatch to HSM[%X] of Active Object[%X]. TimeStamp %d", \
                    event, me->hsm, me, ticks_get()); 
     } 
     if (me->hsm->curr_state->service != (hsm_function_t)0) { 
@@ -267,6 +322,10 @@ int16_t active_resume(active_t *me)
     } 
     /* Clear the Pause */ 
     me -> pause = (int16_t)0; 
+#ifdef MANAGER_READY_SET_ENABLE
+    /* The Scheduler Dropped the Slot while Paused, Schedule the Pending Events */
+    man_ready(me); 
+#endif  /* End of MANAGER_READY_SET_ENABLE */
     SPYER_ACTIVEX("Request to Resume the Active Object %X. TimeStamp %d", me, ticks_get()); 
     return TRUE; 
 }
@@ -290,10 +349,10 @@ int16_t active_on_idle(active_t *me)
             return FALSE; 
         } 
     } 
-    if (me->event != (chain_t *)0) { 
+    if (!echain_is_empty(&(me->event))) { 
         return FALSE; 
     } 
-    if (me->defer != (chain_t *)0) { 
+    if (!echain_is_empty(&(me->defer))) { 
         return FALSE; 
     } 
     SPYER_ACTIVEX("Active Object %X is Idle. TimeStamp %d", me, ticks_get()); 
@@ -428,3 +487,78 @@ int16_t active_on_reset(active_t *me)
 
     SPYER_ACTIVEX("The Active Object %X is Reset. TimeStamp %d", me, ticks_get()); 
 } 
+
+#ifdef ACTIVE_PROFILE_ENABLE
+/***************************************************************************************
+*   active_profile_run() Implementation.
+***************************************************************************************/
+void_t active_profile_run(active_t *me, uint32_t cycles) 
+{
+    ASSERT_REQUIRE(me != (active_t *)0); 
+    if (me == (active_t *)0) { 
+        return; 
+    } 
+    ++(me->profile.runs); 
+    me->profile.busy += cycles; 
+}
+
+/***************************************************************************************
+*   active_profile_snap() Implementation.
+***************************************************************************************/
+int16_t active_profile_snap(active_t *me, active_profile_t *snap, int16_t clear) 
+{
+    size_t   index; 
+    uint8_t *source; 
+
+    INT_LOCK_KEY_
+
+    ASSERT_REQUIRE((me != (active_t *)0) && (snap != (active_profile_t *)0)); 
+    if ((me == (active_t *)0) || (snap == (active_profile_t *)0)) { 
+        return FAILURE; 
+    } 
+
+    /* The Profile is Written by the Manager Only, Lock for the Consistent Copy */
+    INT_LOCK_(); 
+    *snap = me->profile; 
+    if (clear == TRUE) { 
+        source = (uint8_t *)&(me->profile); 
+        for (index = (size_t)0; index < sizeof(active_profile_t); ++index) { 
+            source[index] = (uint8_t)0; 
+        } 
+    } 
+    INT_UNLOCK_(); 
+    return TRUE; 
+}
+
+/***************************************************************************************
+*   active_profile_dump() Implementation.
+***************************************************************************************/
+int16_t active_profile_dump(active_t *me, int16_t clear) 
+{
+    int16_t  ret; 
+    uint8_t  index; 
+    int8_t   buff_profile[SPYER_BUFFER_SIZE]; 
+    active_profile_t snap; 
+
+    ret = active_profile_snap(me, (active_profile_t *)&snap, clear); 
+    if (ret != TRUE) { 
+        return ret; 
+    } 
+    if (sprintf((char *)buff_profile, "\nProfile of Active Object %lX, Hz %u, Events %u, Runs %u, Busy %u, " 
+                "Wait Max %u, Step Max %u.", (unsigned long)(size_t)me, cycles_hz(), snap.events, 
+                snap.runs, snap.busy, snap.wait_max, snap.step_max) > 0) { 
+        debug_puts (buff_profile); 
+    } 
+    /* One Line for Every Non-Empty Bucket: Bucket, Wait, Step */
+    for (index = (uint8_t)0; index < (uint8_t)ACTIVE_PROFILE_BUCKETS; ++index) { 
+        if ((snap.wait[index] == (uint32_t)0) && (snap.step[index] == (uint32_t)0)) { 
+            continue; 
+        } 
+        if (sprintf((char *)buff_profile, "\n  2^%u: Wait %u, Step %u", (uint32_t)index, 
+                    snap.wait[index], snap.step[index]) > 0) { 
+            debug_puts (buff_profile); 
+        } 
+    } 
+    return TRUE; 
+}
+#endif  /* End of ACTIVE_PROFILE_ENABLE */
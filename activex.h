@@ -202,8 +202,52 @@ ACTIVEX_EXT int16_t active_on_quit(active_t *me);
 ***************************************************************************************/
 ACTIVEX_EXT int16_t active_on_reset(active_t *me); 
 
+#ifdef ACTIVE_PROFILE_ENABLE
+/***************************************************************************************
+*   Account One Call of run() into the Profile of Active Object.
+*
+*   Description: Account One Call of run() into the Profile of Active Object. 
+*   Argument: me --- The Pointer of Active Object. 
+*             cycles --- The Cycles Spent in run(). 
+*   Return: none
+*
+*   NOTE: 
+*   (1) Called by the Manager Only. 
+***************************************************************************************/
+ACTIVEX_EXT void_t active_profile_run(active_t *me, uint32_t cycles); 
+
+/***************************************************************************************
+*   Snapshot the Profile of Active Object.
+*
+*   Description: Copy the Profile of Active Object, and Clear It Optionally. 
+*   Argument: me --- The Pointer of Active Object. 
+*             snap --- The Pointer of Profile which Receives the Copy. 
+*             clear --- TRUE to Clear the Profile after Copy, Start a New Period. 
+*   Return:  1 is True, 0 is False, -1 is Failure 
+*
+*   NOTE: 
+*   (1) Callable from Any Active Object, the Copy is Consistent. 
+***************************************************************************************/
+ACTIVEX_EXT int16_t active_profile_snap(active_t *me, active_profile_t *snap, int16_t clear); 
+
+/***************************************************************************************
+*   Dump the Profile of Active Object to the Debug Port.
+*
+*   Description: Snapshot the Profile of Active Object, and Print It through the 
+*                debug_puts() as Text Lines. 
+*   Argument: me --- The Pointer of Active Object. 
+*             clear --- TRUE to Clear the Profile after Copy, Start a New Period. 
+*   Return:  1 is True, 0 is False, -1 is Failure 
+*
+*   NOTE: 
+*   (1) Only the Non-Empty Buckets of Histograms are Printed. 
+***************************************************************************************/
+ACTIVEX_EXT int16_t active_profile_dump(active_t *me, int16_t clear); 
+#endif  /* End of ACTIVE_PROFILE_ENABLE */
+
 #ifdef SPYER_ACTIVEX_ENABLE   /* Spy Debuger Enabled */
-    #define SPYER_ACTIVEX(format, ...)   spyer_((const int8_t *)format, ##__VA_ARGS__)
+    #define SPYER_ACTIVEX(format, ...)   \
+        spyer_ch_(SPYER_CH_ACTIVEX, (const int8_t *)format, ##__VA_ARGS__)
 #else                       /* Spyer Debuger Disabled */
     #define SPYER_ACTIVEX(format, ...)   ((void_t)0)
 #endif  /* End of SPYER_ACTIVEX_ENABLE */
@@ -0,0 +1,750 @@
+/***************************************************************************************
+*   The MIT License (MIT)
+*   Copyright (C) 2005 JinHui Han, <Email: ferrethan485@sohu.com, QQ: 1901589440>
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in
+*   all copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+*   THE SOFTWARE.
+***************************************************************************************/
+
+/***************************************************************************************
+*   Component : Active Object Application FrameWork
+*   Group : Benchmark
+*   File Name : bench.c
+*   Version : 1.0
+*   Description : Microbenchmarks of the Hot Primitives on the POSIX_HOST Port
+*   Author : JinHui Han
+*   History : 
+*          Name            Date                    Remarks
+*       JinHui Han      05-16-2005      Created Initial Version 1.0
+*       JinHui Han      05-16-2005      Verified Version 1.0
+***************************************************************************************/
+
+/***************************************************************************************
+*   Usage: bench [<json file>] 
+*
+*   Built Instead of main.c with POSIX_HOST and BENCH_ENABLE Defined, Runs Every 
+*   Benchmark and Writes the Results as One JSON Document into the File (or into 
+*   the Standard Output): 
+*       {"suite": "smartx", "config": {...}, "results": [ 
+*           {"name": "mpool_get_put", "param": 0, "ops": 1000000, 
+*            "ns_per_op": 12.3, "cycles_per_op": 41.0}, ... ]} 
+*
+*   The "param" is the Size, Depth, Number of Subscribers, Timers or Threads of the 
+*   Case. The "cycles_per_op" is null when the Host has no Time Stamp Counter. The 
+*   Cost of Reading the Clocks is Measured Once and Subtracted. 
+*
+*   The Threaded Cases Check the Blocks as well, the Exit Status is 1 when a Block 
+*   is Handed to Two Threads at Once or is not Recycled. 
+***************************************************************************************/
+
+#include "std_type.h"
+#include "std_def.h"
+#include "config.h"
+
+#if defined(POSIX_HOST) && defined(BENCH_ENABLE)
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+/* The timer_t of <time.h> Clashes with the timer_t of Framework */
+#define timer_t posix_timer_t
+#include <time.h>
+#include <pthread.h>
+#undef  timer_t
+
+#include "lock.h"
+#include "fault.h"
+#include "debug.h"
+#include "assert.h"
+#include "spyer.h"
+#include "ticks.h"
+#include "lookup.h"
+#include "mpool.h" 
+#include "magazine.h"
+#include "event.h"
+#include "epool.h"
+#include "cpool.h"
+#include "echain.h"
+#include "ering.h"
+#include "rchain.h"
+#include "fsm.h"
+#include "hsm.h"
+#include "active.h"
+#include "achain.h"
+#include "stack.h"
+#include "callback.h"
+#include "sche.h"
+#include "manager.h"
+#include "activex.h" 
+#include "timer.h"
+#include "hpool.h"
+#include "queue.h"
+
+#ifndef BENCH_ITERATIONS
+    /***********************************************************************************
+    *   This Constant Defines the Operations Timed in Every Case. 
+    ***********************************************************************************/
+    #define BENCH_ITERATIONS    200000      /* Default is 200000 */
+#endif      /* End of BENCH_ITERATIONS */
+
+#define BENCH_SIGNAL_       ((signal_t)1)   /* Signal Used by All the Cases */
+#define BENCH_BATCH_        16              /* Operations Timed between Two Clock Reads */
+#define BENCH_DEPTH_MAX_    1000            /* Deepest Event Chain */
+#define BENCH_ACTIVES_      64              /* Most Subscribers */
+#define BENCH_STATES_       17              /* Deepest HSM, Including the Root */
+#define BENCH_TIMERS_       10000           /* Most Armed Timers */
+#define BENCH_TICKS_        10000           /* Ticks Timed with the Armed Timers */
+#define BENCH_THREADS_      4               /* Most Threads Sharing One Pool */
+#define BENCH_HOLD_         4               /* Blocks Held by Each Thread at Once */
+
+/* The Threads Go through Their Magazines, which are Drained when They Exit */
+#ifdef MPOOL_MAGAZINE_ENABLE
+    #define BENCH_GET_(pool_)   magazine_get(pool_)
+    #define BENCH_PUT_(block_)  magazine_put(block_)
+#else
+    #define BENCH_GET_(pool_)   mpool_get(pool_)
+    #define BENCH_PUT_(block_)  mpool_put(block_)
+#endif  /* End of MPOOL_MAGAZINE_ENABLE */
+
+/***************************************************************************************
+*   Timing of the Case. 
+***************************************************************************************/
+typedef struct bench_clock_tag { 
+    double  ns;             /* Nanoseconds Accumulated */
+    double  cycles;         /* Cycles Accumulated */
+    double  ns_start;       /* Nanoseconds at Start */
+    double  cycles_start;   /* Cycles at Start */
+    uint32_t laps;          /* Number of Start/Stop Pairs */
+} bench_clock_t; 
+
+static FILE *   bench_out_; 
+static int16_t  bench_first_; 
+static int16_t  bench_failed_; 
+static double   bench_overhead_ns_; 
+static double   bench_overhead_cycles_; 
+
+/* Storage of the Cases */
+static uint8_t       bench_heap_[1024 * 1024]; 
+static uint8_t       bench_pool_[64 * 1024]; 
+static mpool_t       bench_single_;         /* The Pool of the Single Thread Cases */
+static event_t       bench_events_[BENCH_DEPTH_MAX_]; 
+static active_t      bench_actives_[BENCH_ACTIVES_]; 
+static hsm_state_t   bench_states_[BENCH_STATES_]; 
+static hsm_reaction_t bench_reaction_; 
+#ifdef HSM_INDEX_ENABLE
+static hsm_index_t   bench_index_[BENCH_STATES_ * HSM_INDEX_SIGNALS]; 
+#endif  /* End of HSM_INDEX_ENABLE */
+static fsm_state_t   bench_fstates_[2]; 
+static fsm_reaction_t bench_freactions_[2]; 
+static timer_t       bench_timers_[BENCH_TIMERS_]; 
+static void_t *      bench_ring_[BENCH_BATCH_]; 
+static uint8_t       bench_shared_buffer_[16 * 1024]; 
+static mpool_t       bench_shared_;         /* The Pool Shared by the Threads */
+static uint32_t      bench_corrupt_;        /* Blocks Overwritten or of a Wrong Owner */
+
+/***************************************************************************************
+*   bench_ns_() Implementation. Internal
+***************************************************************************************/
+static double bench_ns_(void_t)
+{
+    struct timespec now; 
+
+    clock_gettime(CLOCK_MONOTONIC_RAW, &now); 
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec; 
+}
+
+/***************************************************************************************
+*   bench_cycles_() Implementation. Internal
+*   The Time Stamp Counter, 0 If the Host has None. 
+***************************************************************************************/
+static double bench_cycles_(void_t)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return (double)__builtin_ia32_rdtsc(); 
+#else
+    return 0.0; 
+#endif
+}
+
+/***************************************************************************************
+*   Start and Stop the Clock of the Case. 
+***************************************************************************************/
+static void_t bench_start_(bench_clock_t *me)
+{
+    me->ns_start     = bench_ns_(); 
+    me->cycles_start = bench_cycles_(); 
+}
+
+static void_t bench_stop_(bench_clock_t *me)
+{
+    double cycles; 
+    double ns; 
+
+    cycles = bench_cycles_(); 
+    ns     = bench_ns_(); 
+    me->ns     += ns - me->ns_start; 
+    me->cycles += cycles - me->cycles_start; 
+    ++(me->laps); 
+}
+
+/***************************************************************************************
+*   bench_calibrate_() Implementation. Internal
+*   Measure the Cost of One Start/Stop Pair. 
+***************************************************************************************/
+static void_t bench_calibrate_(void_t)
+{
+    uint32_t      index; 
+    bench_clock_t clock; 
+
+    memset(&clock, 0, sizeof(clock)); 
+    for (index = (uint32_t)0; index < (uint32_t)BENCH_ITERATIONS; ++index) { 
+        bench_start_(&clock); 
+        bench_stop_(&clock); 
+    } 
+    bench_overhead_ns_     = clock.ns / (double)clock.laps; 
+    bench_overhead_cycles_ = clock.cycles / (double)clock.laps; 
+}
+
+/***************************************************************************************
+*   bench_report_() Implementation. Internal
+***************************************************************************************/
+static void_t bench_report_(char const *name, uint32_t param, uint32_t ops, 
+                            bench_clock_t const *clock)
+{
+    double ns; 
+    double cycles; 
+
+    ns     = (clock->ns - bench_overhead_ns_ * (double)clock->laps) / (double)ops; 
+    cycles = (clock->cycles - bench_overhead_cycles_ * (double)clock->laps) / (double)ops; 
+    fprintf(bench_out_, "%s\n    {\"name\": \"%s\", \"param\": %u, \"ops\": %u, " 
+            "\"ns_per_op\": %.2f, ", (bench_first_ == TRUE) ? "" : ",", name, 
+            (unsigned)param, (unsigned)ops, (ns > 0.0) ? ns : 0.0); 
+    if (bench_cycles_() == 0.0) { 
+        fprintf(bench_out_, "\"cycles_per_op\": null}"); 
+    } 
+    else { 
+        fprintf(bench_out_, "\"cycles_per_op\": %.2f}", (cycles > 0.0) ? cycles : 0.0); 
+    } 
+    bench_first_ = FALSE; 
+}
+
+/***************************************************************************************
+*   bench_skip_() Implementation. Internal
+*
+*   A Row without Timings for the Case the Build is too Small to Run. 
+***************************************************************************************/
+static void_t bench_skip_(char const *name, uint32_t param, char const *reason)
+{
+    fprintf(bench_out_, "%s\n    {\"name\": \"%s\", \"param\": %u, \"skipped\": \"%s\"}", 
+            (bench_first_ == TRUE) ? "" : ",", name, (unsigned)param, reason); 
+    bench_first_ = FALSE; 
+}
+
+/***************************************************************************************
+*   bench_mpool_() Implementation. Internal
+***************************************************************************************/
+static void_t bench_mpool_(void_t)
+{
+    uint32_t      index; 
+    uint32_t      batch; 
+    void_t      * block; 
+    bench_clock_t clock; 
+
+    mpool_init(&bench_single_, (void_t *)bench_pool_, (uint32_t)sizeof(bench_pool_), (uint16_t)32); 
+    memset(&clock, 0, sizeof(clock)); 
+    for (index = (uint32_t)0; index < (uint32_t)BENCH_ITERATIONS; index += BENCH_BATCH_) { 
+        bench_start_(&clock); 
+        for (batch = (uint32_t)0; batch < (uint32_t)BENCH_BATCH_; ++batch) { 
+            block = mpool_get(&bench_single_); 
+            mpool_put(block); 
+        } 
+        bench_stop_(&clock); 
+    } 
+    bench_report_("mpool_get_put", (uint32_t)0, (uint32_t)BENCH_ITERATIONS, &clock); 
+}
+
+/***************************************************************************************
+*   bench_worker_() Implementation. Internal
+*   Get BENCH_HOLD_ Blocks, Stamp Them with the Thread and Round, then Check the 
+*   Stamps and the Owner Pool, and Put Them Back. 
+***************************************************************************************/
+static void_t *bench_worker_(void_t *arg)
+{
+    uint32_t  index; 
+    uint32_t  stamp; 
+    uint16_t  count; 
+    uint16_t  held; 
+    void_t  * block[BENCH_HOLD_]; 
+
+    for (index = (uint32_t)0; index < (uint32_t)BENCH_ITERATIONS; ++index) { 
+        stamp = ((uint32_t)(size_t)arg << 24) | (index & (uint32_t)0x00FFFFFF); 
+        for (held = (uint16_t)0; held < (uint16_t)BENCH_HOLD_; ++held) { 
+            block[held] = BENCH_GET_(&bench_shared_); 
+            if (block[held] == (void_t *)0) { 
+                break; 
+            } 
+            *((uint32_t *)block[held]) = stamp + held; 
+        } 
+        for (count = (uint16_t)0; count < held; ++count) { 
+            if ((*((uint32_t *)block[count]) != stamp + count) || 
+                (MPOOL_OWNER(block[count]) != &bench_shared_)) { 
+                __atomic_fetch_add(&bench_corrupt_, (uint32_t)1, __ATOMIC_RELAXED); 
+            } 
+            BENCH_PUT_(block[count]); 
+        } 
+    } 
+    return (void_t *)0; 
+}
+
+/***************************************************************************************
+*   bench_mpool_threads_() Implementation. Internal
+*   The Threads Get and Put the Blocks of One Pool at Once, the Wall Time per 
+*   get/put Pair is Reported. 
+***************************************************************************************/
+static void_t bench_mpool_threads_(uint16_t threads)
+{
+    uint16_t      index; 
+    pthread_t     thread[BENCH_THREADS_]; 
+    bench_clock_t clock; 
+
+    mpool_init(&bench_shared_, (void_t *)bench_shared_buffer_, 
+               (uint32_t)sizeof(bench_shared_buffer_), (uint16_t)32); 
+    bench_corrupt_ = (uint32_t)0; 
+    memset(&clock, 0, sizeof(clock)); 
+    bench_start_(&clock); 
+    for (index = (uint16_t)0; index < threads; ++index) { 
+        pthread_create(&thread[index], (pthread_attr_t *)0, bench_worker_, 
+                       (void_t *)(size_t)(index + 1)); 
+    } 
+    for (index = (uint16_t)0; index < threads; ++index) { 
+        pthread_join(thread[index], (void_t **)0); 
+    } 
+    bench_stop_(&clock); 
+    if ((bench_corrupt_ != (uint32_t)0) || (mpool_all_recycled(&bench_shared_) != TRUE)) { 
+        fprintf(stderr, "mpool_threads %u: %u Blocks Corrupted, Free %u of %u\n", 
+                (unsigned)threads, (unsigned)bench_corrupt_, 
+                (unsigned)bench_shared_.free_cnt, (unsigned)bench_shared_.total_cnt); 
+        bench_failed_ = TRUE; 
+    } 
+    bench_report_("mpool_threads", (uint32_t)threads, 
+                  (uint32_t)BENCH_ITERATIONS * (uint32_t)BENCH_HOLD_ * (uint32_t)threads, &clock); 
+}
+
+/***************************************************************************************
+*   bench_hpool_() Implementation. Internal
+***************************************************************************************/
+static void_t bench_hpool_(uint16_t size)
+{
+    uint32_t      index; 
+    uint32_t      batch; 
+    void_t      * block; 
+    void_t      * keep; 
+    bench_clock_t clock; 
+
+    hpool_init((void_t *)bench_heap_, (uint32_t)sizeof(bench_heap_), (uint32_t)8192); 
+    /* Keep One Block, the Heap is not Empty between the Operations */
+    keep = hpool_get((uint16_t)48); 
+    memset(&clock, 0, sizeof(clock)); 
+    for (index = (uint32_t)0; index < (uint32_t)BENCH_ITERATIONS; index += BENCH_BATCH_) { 
+        bench_start_(&clock); 
+        for (batch = (uint32_t)0; batch < (uint32_t)BENCH_BATCH_; ++batch) { 
+            block = hpool_get(size); 
+            hpool_put(block); 
+        } 
+        bench_stop_(&clock); 
+    } 
+    hpool_put(keep); 
+    bench_report_("hpool_get_put", (uint32_t)size, (uint32_t)BENCH_ITERATIONS, &clock); 
+}
+
+/***************************************************************************************
+*   bench_epool_() Implementation. Internal
+***************************************************************************************/
+static void_t bench_epool_(void_t)
+{
+    uint32_t      index; 
+    uint32_t      batch; 
+    event_t     * event; 
+    bench_clock_t clock; 
+
+    epool_init(&bench_single_, (void_t *)bench_pool_, (uint32_t)sizeof(bench_pool_), 
+               (uint16_t)sizeof(event_t)); 
+    memset(&clock, 0, sizeof(clock)); 
+    for (index = (uint32_t)0; index < (uint32_t)BENCH_ITERATIONS; index += BENCH_BATCH_) { 
+        bench_start_(&clock); 
+        for (batch = (uint32_t)0; batch < (uint32_t)BENCH_BATCH_; ++batch) { 
+            event = epool_new(&bench_single_, BENCH_SIGNAL_, (uint16_t)0, (uint16_t)0); 
+            /* Take the Reference of the Only Consumer, which Releases It */
+            ++event->dynamic_; 
+            epool_release(event); 
+        } 
+        bench_stop_(&clock); 
+    } 
+    bench_report_("epool_new_release", (uint32_t)0, (uint32_t)BENCH_ITERATIONS, &clock); 
+}
+
+/***************************************************************************************
+*   bench_echain_() Implementation. Internal
+*   Post One and Get One, with "depth" Events Staying in the Chain. 
+***************************************************************************************/
+static void_t bench_echain_(uint16_t depth)
+{
+    uint32_t      index; 
+    uint32_t      batch; 
+    uint16_t      count; 
+    event_t     * event; 
+    echain_t      chain; 
+    bench_clock_t clock; 
+
+    echain_init(&chain); 
+    for (count = (uint16_t)0; count < depth; ++count) { 
+        event_init(&bench_events_[count], BENCH_SIGNAL_, (uint16_t)(count % 64), 
+                   (uint16_t)(count % 64)); 
+    } 
+    /* Fill the Chain to the Depth, Less the One in Flight */
+    for (count = (uint16_t)1; count < depth; ++count) { 
+        echain_post(&chain, &bench_events_[count]); 
+    } 
+    event = &bench_events_[0]; 
+    memset(&clock, 0, sizeof(clock)); 
+    for (index = (uint32_t)0; index < (uint32_t)BENCH_ITERATIONS; index += BENCH_BATCH_) { 
+        bench_start_(&clock); 
+        for (batch = (uint32_t)0; batch < (uint32_t)BENCH_BATCH_; ++batch) { 
+            echain_post(&chain, event); 
+            event = echain_get(&chain); 
+        } 
+        bench_stop_(&clock); 
+    } 
+    echain_flush(&chain); 
+    bench_report_("echain_post_get", (uint32_t)depth, (uint32_t)BENCH_ITERATIONS, &clock); 
+}
+
+/***************************************************************************************
+*   bench_publish_() Implementation. Internal
+*   Publish to "total" Subscribers, the Chains are Drained out of the Clock. 
+***************************************************************************************/
+static void_t bench_publish_(uint8_t total)
+{
+    uint32_t      index; 
+    uint16_t      batch; 
+    uint16_t      count; 
+    uint8_t       slot; 
+    event_t     * event; 
+    bench_clock_t clock; 
+
+    /* Every Publish Takes (total - 1) Cells from the Chain Pool at Most */
+    count = (uint16_t)((CPOOL_AMOUNT / 2) / total); 
+    if (count > (uint16_t)BENCH_BATCH_) { 
+        count = (uint16_t)BENCH_BATCH_; 
+    } 
+    if (count == (uint16_t)0) { 
+        count = (uint16_t)1; 
+    } 
+    for (batch = (uint16_t)0; batch < count; ++batch) { 
+        event_init(&bench_events_[batch], BENCH_SIGNAL_, (uint16_t)1, (uint16_t)1); 
+    } 
+    for (slot = (uint8_t)0; slot < total; ++slot) { 
+        memset(&bench_actives_[slot], 0, sizeof(active_t)); 
+        bench_actives_[slot].slot     = slot; 
+        bench_actives_[slot].priority = (uint16_t)slot; 
+        echain_init(&(bench_actives_[slot].event)); 
+        echain_init(&(bench_actives_[slot].defer)); 
+        man_subscribe(&bench_events_[0], &bench_actives_[slot]); 
+    } 
+    memset(&clock, 0, sizeof(clock)); 
+    for (index = (uint32_t)0; index < (uint32_t)BENCH_ITERATIONS; index += count) { 
+        bench_start_(&clock); 
+        for (batch = (uint16_t)0; batch < count; ++batch) { 
+            man_publish(&bench_events_[batch]); 
+        } 
+        bench_stop_(&clock); 
+        for (slot = (uint8_t)0; slot < total; ++slot) { 
+            while (!echain_is_empty(&(bench_actives_[slot].event))) { 
+                event = echain_get(&(bench_actives_[slot].event)); 
+                epool_release(event); 
+            } 
+        } 
+    } 
+    for (slot = (uint8_t)0; slot < total; ++slot) { 
+        man_unsubscribe_all(&bench_actives_[slot]); 
+    } 
+    bench_report_("man_publish", (uint32_t)total, 
+                  (uint32_t)(((BENCH_ITERATIONS + count - 1) / count) * count), &clock); 
+}
+
+/***************************************************************************************
+*   bench_hsm_() Implementation. Internal
+*   The Leaf at "depth" Handles the Event in Its Outermost Superstate, which Takes 
+*   the External Transition back to the Leaf: "depth" Exits and Entries. 
+***************************************************************************************/
+static void_t bench_hsm_(int16_t depth)
+{
+    uint32_t      index; 
+    uint32_t      batch; 
+    int16_t       level; 
+    event_t       event; 
+    hsm_t         hsm; 
+    bench_clock_t clock; 
+
+    memset(bench_states_, 0, sizeof(bench_states_)); 
+    memset(&bench_reaction_, 0, sizeof(bench_reaction_)); 
+    for (level = (int16_t)0; level <= depth; ++level) { 
+        bench_states_[level].depth = level; 
+        bench_states_[level].top   = (level == (int16_t)0) ? 
+                                     (hsm_state_t *)0 : &bench_states_[level - 1]; 
+        bench_states_[level].down  = (level == depth) ? 
+                                     (hsm_state_t *)0 : &bench_states_[level + 1]; 
+        bench_states_[level].name  = (int8_t *)"bench"; 
+    } 
+    bench_reaction_.signal   = BENCH_SIGNAL_; 
+    bench_reaction_.external = (int16_t)1; 
+    bench_reaction_.target   = &bench_states_[depth]; 
+    bench_states_[1].reaction = &bench_reaction_; 
+    bench_states_[1].rtotal   = (int16_t)1; 
+#ifdef HSM_INDEX_ENABLE
+    hsm_build_index(&bench_states_[0], (int16_t)(depth + 1), &bench_index_[0]); 
+#endif  /* End of HSM_INDEX_ENABLE */
+
+    memset(&hsm, 0, sizeof(hsm)); 
+    hsm.curr_state = &bench_states_[depth]; 
+    hsm.status_    = HSM_DISPATCH; 
+    hsm.dispatch   = (hsm_dispatch_t)hsm_dispatch; 
+    event_init(&event, BENCH_SIGNAL_, (uint16_t)0, (uint16_t)0); 
+    memset(&clock, 0, sizeof(clock)); 
+    for (index = (uint32_t)0; index < (uint32_t)BENCH_ITERATIONS; index += BENCH_BATCH_) { 
+        bench_start_(&clock); 
+        for (batch = (uint32_t)0; batch < (uint32_t)BENCH_BATCH_; ++batch) { 
+            hsm_dispatch(&hsm, &event); 
+        } 
+        bench_stop_(&clock); 
+    } 
+    bench_report_("hsm_dispatch", (uint32_t)depth, (uint32_t)BENCH_ITERATIONS, &clock); 
+}
+
+/***************************************************************************************
+*   bench_fsm_() Implementation. Internal
+*   Two States Toggled by the Same Signal. 
+***************************************************************************************/
+static void_t bench_fsm_(void_t)
+{
+    uint32_t      index; 
+    uint32_t      batch; 
+    event_t       event; 
+    fsm_t         fsm; 
+    bench_clock_t clock; 
+
+    memset(bench_fstates_, 0, sizeof(bench_fstates_)); 
+    memset(bench_freactions_, 0, sizeof(bench_freactions_)); 
+    bench_freactions_[0].signal   = BENCH_SIGNAL_; 
+    bench_freactions_[0].external = (int16_t)1; 
+    bench_freactions_[0].target   = &bench_fstates_[1]; 
+    bench_freactions_[1].signal   = BENCH_SIGNAL_; 
+    bench_freactions_[1].external = (int16_t)1; 
+    bench_freactions_[1].target   = &bench_fstates_[0]; 
+    bench_fstates_[0].reaction = &bench_freactions_[0]; 
+    bench_fstates_[0].rtotal   = (int16_t)1; 
+    bench_fstates_[0].name     = (int8_t *)"ping"; 
+    bench_fstates_[1].reaction = &bench_freactions_[1]; 
+    bench_fstates_[1].rtotal   = (int16_t)1; 
+    bench_fstates_[1].name     = (int8_t *)"pong"; 
+
+    memset(&fsm, 0, sizeof(fsm)); 
+    fsm.curr_state = &bench_fstates_[0]; 
+    fsm.status_    = FSM_DISPATCH; 
+    fsm.dispatch   = (fsm_dispatch_t)fsm_dispatch; 
+    event_init(&event, BENCH_SIGNAL_, (uint16_t)0, (uint16_t)0); 
+    memset(&clock, 0, sizeof(clock)); 
+    for (index = (uint32_t)0; index < (uint32_t)BENCH_ITERATIONS; index += BENCH_BATCH_) { 
+        bench_start_(&clock); 
+        for (batch = (uint32_t)0; batch < (uint32_t)BENCH_BATCH_; ++batch) { 
+            fsm_dispatch(&fsm, &event); 
+        } 
+        bench_stop_(&clock); 
+    } 
+    bench_report_("fsm_dispatch", (uint32_t)0, (uint32_t)BENCH_ITERATIONS, &clock); 
+}
+
+/***************************************************************************************
+*   bench_timer_() Implementation. Internal
+*   The Tick with "total" Timers Armed Far Ahead, none Expires in the Clock. 
+***************************************************************************************/
+static void_t bench_timer_(uint16_t total)
+{
+    uint32_t      index; 
+    uint16_t      count; 
+    event_t       event; 
+    bench_clock_t clock; 
+
+    timer_init(); 
+    event_init(&event, BENCH_SIGNAL_, (uint16_t)0, (uint16_t)0); 
+    for (count = (uint16_t)0; count < total; ++count) { 
+        /* Spread over the Levels of Wheel, Beyond the Ticks Timed */
+        timer_arm(&bench_timers_[count], 
+                  (int32_t)(BENCH_TICKS_ * 2 + ((uint32_t)count * 7919U) % 1000000U), 
+                  (int32_t)0, &event); 
+    } 
+    memset(&clock, 0, sizeof(clock)); 
+    for (index = (uint32_t)0; index < (uint32_t)BENCH_TICKS_; ++index) { 
+        bench_start_(&clock); 
+        timer(); 
+        bench_stop_(&clock); 
+    } 
+    for (count = (uint16_t)0; count < total; ++count) { 
+        timer_disarm(&bench_timers_[count]); 
+    } 
+    bench_report_("timer_tick", (uint32_t)total, (uint32_t)BENCH_TICKS_, &clock); 
+}
+
+/***************************************************************************************
+*   bench_queue_() Implementation. Internal
+***************************************************************************************/
+static void_t bench_queue_(void_t)
+{
+    uint32_t      index; 
+    uint32_t      batch; 
+    queue_t       queue; 
+    bench_clock_t clock; 
+
+    queue_init(&queue, bench_ring_, (uint16_t)BENCH_BATCH_); 
+    memset(&clock, 0, sizeof(clock)); 
+    for (index = (uint32_t)0; index < (uint32_t)BENCH_ITERATIONS; index += BENCH_BATCH_) { 
+        bench_start_(&clock); 
+        for (batch = (uint32_t)0; batch < (uint32_t)BENCH_BATCH_; ++batch) { 
+            queue_post_FIFO(&queue, (void_t *)&queue); 
+            queue_get(&queue); 
+        } 
+        bench_stop_(&clock); 
+    } 
+    bench_report_("queue_post_get", (uint32_t)0, (uint32_t)BENCH_ITERATIONS, &clock); 
+}
+
+/***************************************************************************************
+*   main() Implementation.
+***************************************************************************************/
+int main(int argc, char *argv[])
+{
+    uint16_t index; 
+    static uint16_t const hpool_sizes[] = { 16, 64, 256, 1024, 4096 }; 
+    static uint16_t const depths[]      = { 1, 10, 100, 1000 }; 
+    static uint8_t  const subscribers[] = { 1, 2, 4, 8, 16, 32, 64 }; 
+    static int16_t  const levels[]      = { 1, 2, 4, 8, 16 }; 
+    static uint16_t const timers[]      = { 10, 100, 1000, 10000 }; 
+    static uint16_t const threads[]     = { 1, 2, BENCH_THREADS_ }; 
+
+    bench_out_ = stdout; 
+    if (argc > 1) { 
+        bench_out_ = fopen(argv[1], "w"); 
+        if (bench_out_ == (FILE *)0) { 
+            perror(argv[1]); 
+            return 1; 
+        } 
+    } 
+
+    fault_init(); 
+    debug_init(); 
+    spyer_filter(SPYER_FILTER_DEFAULT); 
+    cpool_init(); 
+    man_init(); 
+
+    fprintf(bench_out_, "{\"suite\": \"smartx\", \"config\": {" 
+            "\"iterations\": %u, \"timer\": \"%s\", \"hpool\": \"%s\", \"echain\": \"%s\", " 
+            "\"mpool\": \"%s\", \"magazine\": %s, \"header\": %s}, \"results\": [", 
+            (unsigned)BENCH_ITERATIONS, 
+#ifdef TIMER_WHEEL_ENABLE
+            "wheel", 
+#else
+            "list", 
+#endif  /* End of TIMER_WHEEL_ENABLE */
+#ifdef HPOOL_TLSF_ENABLE
+            "tlsf", 
+#else
+            "native", 
+#endif  /* End of HPOOL_TLSF_ENABLE */
+#ifdef ECHAIN_BUCKET_ENABLE
+            "bucket", 
+#else
+            "list", 
+#endif  /* End of ECHAIN_BUCKET_ENABLE */
+#ifdef MPOOL_LOCKFREE_ENABLE
+            "lockfree", 
+#else
+            "lock", 
+#endif  /* End of MPOOL_LOCKFREE_ENABLE */
+#ifdef MPOOL_MAGAZINE_ENABLE
+            "true", 
+#else
+            "false", 
+#endif  /* End of MPOOL_MAGAZINE_ENABLE */
+#ifdef MPOOL_HEADERLESS_ENABLE
+            "false"
+#else
+            "true"
+#endif  /* End of MPOOL_HEADERLESS_ENABLE */
+            ); 
+    bench_first_  = TRUE; 
+    bench_failed_ = FALSE; 
+    bench_calibrate_(); 
+
+    bench_mpool_(); 
+    for (index = (uint16_t)0; index < (uint16_t)(sizeof(threads) / sizeof(threads[0])); ++index) { 
+        bench_mpool_threads_(threads[index]); 
+    } 
+    for (index = (uint16_t)0; index < (uint16_t)(sizeof(hpool_sizes) / sizeof(hpool_sizes[0])); ++index) { 
+        bench_hpool_(hpool_sizes[index]); 
+    } 
+    bench_epool_(); 
+    for (index = (uint16_t)0; index < (uint16_t)(sizeof(depths) / sizeof(depths[0])); ++index) { 
+#ifndef ECHAIN_INTRUSIVE_ENABLE
+        /* Every Event Takes a Cell of the Chain Pool */
+        if (depths[index] > (uint16_t)(CPOOL_AMOUNT / 2)) { 
+            bench_skip_("echain_post_get", (uint32_t)depths[index], "pool too small"); 
+            continue; 
+        } 
+#endif  /* End of ECHAIN_INTRUSIVE_ENABLE */
+        bench_echain_(depths[index]); 
+    } 
+    for (index = (uint16_t)0; index < (uint16_t)(sizeof(subscribers) / sizeof(subscribers[0])); ++index) { 
+        if (subscribers[index] > (uint8_t)MAX_ACTIVE) { 
+            bench_skip_("man_publish", (uint32_t)subscribers[index], "too few actives"); 
+            continue; 
+        } 
+        bench_publish_(subscribers[index]); 
+    } 
+    for (index = (uint16_t)0; index < (uint16_t)(sizeof(levels) / sizeof(levels[0])); ++index) { 
+        if (levels[index] >= (int16_t)HSM_MAX_DEPTH) { 
+            bench_skip_("hsm_dispatch", (uint32_t)levels[index], "nesting too deep"); 
+            continue; 
+        } 
+        bench_hsm_(levels[index]); 
+    } 
+    bench_fsm_(); 
+    for (index = (uint16_t)0; index < (uint16_t)(sizeof(timers) / sizeof(timers[0])); ++index) { 
+        bench_timer_(timers[index]); 
+    } 
+    bench_queue_(); 
+
+    fprintf(bench_out_, "\n]}\n"); 
+    if (bench_out_ != stdout) { 
+        fclose(bench_out_); 
+    } 
+    /* The Spyer Records Left in the Debug Buffer */
+    (void_t)debug_flush(); 
+    return (bench_failed_ == TRUE) ? 1 : 0; 
+}
+
+#endif  /* End of POSIX_HOST && BENCH_ENABLE */
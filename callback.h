@@ -64,6 +64,9 @@ CALLBACK_EXT int16_t on_init(void_t);
 *
 *   Description: Idle Callback. 
 *   Argument: int_lock_key -- The Interrupt Status need to be Resume. 
+*             ticks -- The Ticks the CPU may Sleep before the Next Timer Expires, 
+*                      TIMER_NEXT_NONE If No Timer is Armed. It is Always 1 If 
+*                      TICKER_TICKLESS_ENABLE is not Defined. 
 *   Return:  1 is True, 0 is False, -1 is Failure 
 *   
 *   NOTE: 
@@ -80,8 +83,12 @@ CALLBACK_EXT int16_t on_init(void_t);
 *       Putting the CPU into a Power-Saving Mode.
 *   (4) on_idle() is Only Used by the Non-Preemptive Scheduler Built into Manager 
 *       in the "Bare Metal" Port, and is NOT Used in any Other Ports. 
+*   (5) With TICKER_TICKLESS_ENABLE, on_idle() Stops the Clock Tick, Programs the 
+*       Wake-Up Timer "ticks" Ahead, Sleeps, and then Calls ticker_catchup() with 
+*       the Ticks Really Slept (an Interrupt may Wake the CPU Earlier) before 
+*       Restarting the Clock Tick. 
 ***************************************************************************************/
-CALLBACK_EXT int16_t on_idle(INT_KEY_TYPE int_lock_key); 
+CALLBACK_EXT int16_t on_idle(cpu_sr_t int_lock_key, uint32_t ticks); 
 
 #ifdef __cplusplus
 }
@@ -41,7 +41,36 @@
 extern "C" {
 #endif
 
+/***************************************************************************************
+*   The Type of CPU Core, the Port Layers (_xxx.c) are Selected by It, Define Only 
+*   One of Them: 
+*   (1) CORTEX_M   -- ARM Cortex-M, Bare Metal. 
+*   (2) POSIX_HOST -- Linux/POSIX Host, Native Builds for the Load Test, Benchmark 
+*                     and Simulation. Link with "-lpthread". Defined on the Command 
+*                     Line ("-DPOSIX_HOST", See the Makefile). 
+***************************************************************************************/
+#ifndef POSIX_HOST
 #define CORTEX_M  /* The Type of CPU Core */
+#endif
+
+#if defined(CORTEX_M) && defined(POSIX_HOST)
+    #error "Define Only One of CORTEX_M and POSIX_HOST"
+#endif
+
+/***************************************************************************************
+*   Enable the Microbenchmarks on the POSIX_HOST Port, Link bench.c Instead of main.c. 
+*   BENCH_ENABLE is Defined on the Command Line, "make bench" Defines It for bench.c. 
+*   "make bench" also Builds the Kernel Apart with CPOOL_AMOUNT and HSM_MAX_DEPTH 
+*   Overridden, so the Deepest Chain and HSM Cases Fit. 
+***************************************************************************************/
+#define BENCH_ITERATIONS    200000
+
+/***************************************************************************************
+*   Enable the Deterministic Simulation on the POSIX_HOST Port, the Ticker, on_idle() 
+*   and the Cycle Counter are Driven by the Virtual Clock of sim.c. 
+***************************************************************************************/
+#undef  SIM_ENABLE
+#define SIM_STEP_CYCLES     10000
 
 /***************************************************************************************
 * The Size of CPU Status Register, CPU-Specific. 
@@ -94,6 +123,20 @@ typedef uint32_t cpu_sr_t;
 **************************************************************************************/
 #define TICKER     500     /* UNIT: ticks/s */
 
+/***************************************************************************************
+*   Enable or Disable for Hierarchical Timing Wheel of Timer. 
+*   The Wheel Covers (1 << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) Ticks. 
+***************************************************************************************/
+#undef  TIMER_WHEEL_ENABLE
+#define TIMER_WHEEL_LEVELS  4
+#define TIMER_WHEEL_BITS    6
+
+/***************************************************************************************
+*   Enable or Disable for Tickless Idle. on_idle() is Told the Ticks until the Next 
+*   Timer Expires, and the Ticker is Caught up by ticker_catchup() after Wake-Up. 
+***************************************************************************************/
+#undef  TICKER_TICKLESS_ENABLE
+
 /***************************************************************************************
 *   Configure Definations for Failure Logger.
 ***************************************************************************************/
@@ -121,6 +164,24 @@ typedef uint32_t cpu_sr_t;
 ***************************************************************************************/
 #undef  SPYER_ENABLE
 
+/***************************************************************************************
+*   Enable or Disable for Binary Records of Spyer Debuger, which are Decoded on 
+*   the Host by spyer_decode.py. 
+***************************************************************************************/
+#undef  SPYER_BINARY_ENABLE
+
+/***************************************************************************************
+*   Enable or Disable for Interned Format Strings of Spyer Debuger. The Records Carry 
+*   the ID of Call Site, the Dictionary is Generated by spyer_dict.py. 
+***************************************************************************************/
+#undef  SPYER_INTERN_ENABLE
+
+/***************************************************************************************
+*   Enable or Disable for Runtime Filter of Spyer Debuger. The Trace Channels of 
+*   Subsystem and Active Object Compiled in can be Switched On or Off while Running. 
+***************************************************************************************/
+#undef  SPYER_FILTER_ENABLE
+
 /***************************************************************************************
 *   Enable or Disable for Spyer of System Ticks.
 ***************************************************************************************/
@@ -141,11 +202,61 @@ typedef uint32_t cpu_sr_t;
 ***************************************************************************************/
 #undef  SPYER_MPOOL_ENABLE
 
+/***************************************************************************************
+*   Enable or Disable for Lock-Free Free List of Memory Pools, mpool_get() and 
+*   mpool_put() Use the Compare-And-Swap instead of Locking the Interrupts. 
+*   NOTE: Requires the __atomic Builtins of GCC, and the Pool of < 65535 Blocks. 
+***************************************************************************************/
+#undef  MPOOL_LOCKFREE_ENABLE
+
+/***************************************************************************************
+*   Configure the Number of Blocks Handled in One Batch on the Stack, by the Callers 
+*   of mpool_get_n() and mpool_put_n(). 
+***************************************************************************************/
+#define MPOOL_BATCH     16
+
+/***************************************************************************************
+*   Enable or Disable for Header-Free Blocks of Memory Pools, the Owner Pool of Block 
+*   is Found by the Address in the Range Table of MPOOL_RANGES Pools, instead of the 
+*   Pointer Stored before Every Block. 
+***************************************************************************************/
+#undef  MPOOL_HEADERLESS_ENABLE
+#define MPOOL_RANGES    16
+
+/***************************************************************************************
+*   Enable or Disable for Elastic Memory Pools, the Exhausted Pool Borrows a Batch 
+*   of MPOOL_ELASTIC_BATCH Blocks from hpool, and Gives the Batches Back when They are 
+*   All Free and the Free Blocks have Stayed above the Low Water-Mark for 
+*   MPOOL_ELASTIC_PERIOD Ticks. 
+*   NOTE: Requires the Block Header, not with MPOOL_LOCKFREE_ENABLE. 
+***************************************************************************************/
+#undef  MPOOL_ELASTIC_ENABLE
+#define MPOOL_ELASTIC_BATCH     8
+#define MPOOL_ELASTIC_PERIOD    100
+
+/***************************************************************************************
+*   Enable or Disable for Per-Thread Magazines of Memory Pools, Each Thread Caches 
+*   MAGAZINE_SIZE Free Blocks for Each of MAGAZINE_POOLS Pools, and Refills or 
+*   Drains Them in Batches. 
+*   NOTE: POSIX_HOST Only. 
+***************************************************************************************/
+#undef  MPOOL_MAGAZINE_ENABLE
+#define MAGAZINE_SIZE   32
+#define MAGAZINE_POOLS  4
+
 /***************************************************************************************
 *   Enable or Disable for Spyer of Event Pools.
 ***************************************************************************************/
 #undef  SPYER_EPOOL_ENABLE
 
+/***************************************************************************************
+*   Enable or Disable for Size-Class Registry of Event Pools, epool_alloc() Takes the 
+*   Size of Event from the Smallest Registered Pool which Fits, and Falls Back to the 
+*   Larger Pool when It Runs Dry. 
+***************************************************************************************/
+#undef  EPOOL_CLASS_ENABLE
+#define EPOOL_CLASSES   4
+
 /***************************************************************************************
 *   Enable or Disable for Spyer of Variable Size Memory Pools.
 ***************************************************************************************/
@@ -157,16 +268,38 @@ typedef uint32_t cpu_sr_t;
 #define HPOOL_FACTOR    (1L)
 #define HPOOL_AMOUNT     12
 
+/***************************************************************************************
+*   Enable or Disable for Two-Level Segregated Fit Backend of Variable Size Memory 
+*   Pools, which Gets and Puts in O(1) with Immediate Coalescing. 
+***************************************************************************************/
+#undef  HPOOL_TLSF_ENABLE
+#define HPOOL_TLSF_SLI    3
+
 /***************************************************************************************
 *   Configure Definations for Chain Pool.
 ***************************************************************************************/
+#ifndef CPOOL_AMOUNT
 #define CPOOL_AMOUNT   256
+#endif
 
 /***************************************************************************************
 *   Enable or Disable for Spyer of Priority Based Event Chain.
 ***************************************************************************************/
 #undef  SPYER_ECHAIN_ENABLE
 
+/***************************************************************************************
+*   Enable or Disable for Bucketed Priority Based Event Chain (One FIFO per Level).
+*   NOTE: Event with Priority >= (ECHAIN_LEVELS - 1) Shares the Lowest Level.
+***************************************************************************************/
+#undef  ECHAIN_BUCKET_ENABLE
+#define ECHAIN_LEVELS   16
+
+/***************************************************************************************
+*   Enable or Disable for Embedded Chain Cell of Event (Intrusive Event Chain).
+*   NOTE: The Chain Pool is Used Only for the Second and Later Consumers of Multicast.
+***************************************************************************************/
+#undef  ECHAIN_INTRUSIVE_ENABLE
+
 /***************************************************************************************
 *   Enable or Disable for Spyer of Priority Based Active Object Chain.
 ***************************************************************************************/
@@ -202,11 +335,53 @@ typedef uint32_t cpu_sr_t;
 ***************************************************************************************/
 #define MSTACK_AMOUNT   4
 
+/***************************************************************************************
+*   Enable or Disable for Ready Set (Bitmap) Scheduler of Active Object Manager.
+*   NOTE: The Slot of Each Active Object Must be Unique and Less than MAX_ACTIVE.
+***************************************************************************************/
+#undef  MANAGER_READY_SET_ENABLE
+#define MAX_ACTIVE      64
+
+/***************************************************************************************
+*   Enable or Disable for Signal Indexed Subscriber Table of Active Object Manager.
+*   NOTE: Requires the Ready Set Scheduler, Signal Must be Less than MAX_SIGNAL.
+***************************************************************************************/
+#undef  MANAGER_SIGNAL_TABLE_ENABLE
+#define MAX_SIGNAL      256
+
+/***************************************************************************************
+*   Enable or Disable for Lock-Free Event Rings of Active Object Manager, which are 
+*   Used by ISRs to Post the Event. Each Producer Must Own Its Ring.
+***************************************************************************************/
+#undef  MANAGER_RING_ENABLE
+#define MAX_RING        4
+#define ERING_BATCH     8
+
+/***************************************************************************************
+*   Enable or Disable for Multi-Core Executor of Active Objects, the Active Objects 
+*   are Run by EXECUTOR_WORKERS Threads with Work Stealing. 
+*   NOTE: POSIX_HOST Only, Requires the Ready Set Scheduler. 
+***************************************************************************************/
+#undef  MANAGER_EXECUTOR_ENABLE
+#define EXECUTOR_WORKERS    4
+
+/***************************************************************************************
+*   Enable or Disable for Spyer of Lock-Free Event Ring.
+***************************************************************************************/
+#undef  SPYER_ERING_ENABLE
+
 /***************************************************************************************
 *   Enable or Disable for Spyer of Active Object Engine.
 ***************************************************************************************/
 #undef  SPYER_ACTIVEX_ENABLE
 
+/***************************************************************************************
+*   Enable or Disable for Run-Time Profiling of Active Object, which Counts the Queue 
+*   Wait and the RTC Step of Every Active Object by the Cycle Counter (cycles.h). 
+***************************************************************************************/
+#undef  ACTIVE_PROFILE_ENABLE
+#define ACTIVE_PROFILE_BUCKETS  24
+
 /***************************************************************************************
 *   Enable or Disable for Spyer of Timer.
 ***************************************************************************************/
@@ -215,7 +390,23 @@ typedef uint32_t cpu_sr_t;
 /***************************************************************************************
 *   Configure Definations for HSM.
 ***************************************************************************************/
+#ifndef HSM_MAX_DEPTH
 #define HSM_MAX_DEPTH   8
+#endif
+
+/***************************************************************************************
+*   Enable or Disable for Dispatch Index of HSM, which Maps the Signal into the 
+*   Reaction in One Lookup. 
+***************************************************************************************/
+#undef  HSM_INDEX_ENABLE
+#define HSM_INDEX_SIGNALS   64
+
+/***************************************************************************************
+*   Enable or Disable for Cached Transition Path of HSM. 
+***************************************************************************************/
+#undef  HSM_PATH_ENABLE
+#define HSM_PATH_AMOUNT     32
+#define HSM_PATH_STATES     128
 
 /***************************************************************************************
 *   Enable or Disable for Spyer of HSM.
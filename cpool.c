@@ -44,12 +44,14 @@
 #include "ticks.h"
 #include "fault.h"
 #include "mpool.h"
+#include "event.h"
 
 #define  EXTERN_GLOBALS
 #include "cpool.h"
 
 ASSERT_THIS_FILE(cpool.c)
 FAULT_THIS_FILE(cpool.c)
+SPYER_THIS_FILE(3)
 
 /***************************************************************************************
 *   cpool_init() Implementation.
@@ -58,7 +60,7 @@ int16_t cpool_init(void_t)
 {
     int16_t ret; 
 
-    ret = mpool_init((mpool_t *)&cpool, (void_t *)buff_echain, (uint32_t)SIZE_BUFF_CPOOL, (uint16_t)sizeof(chain_t)); 
+    ret = mpool_init((mpool_t *)&cpool, (void_t *)buff_cpool, (uint32_t)SIZE_BUFF_CPOOL, (uint16_t)sizeof(chain_t)); 
 
     SPYER_CPOOL("Chain Pool %X is Initialized, Result %d.", (mpool_t *)&cpool, ret); 
 
@@ -82,7 +84,7 @@ chain_t *cpool_get(void_t)
     /* Initialize the Chain Cell */
     chain->builtin = (void_t *)0; 
 
-    SPYER_CPOOL("Chain Cell %X is Get from Chain Pool %X. TimeStamp %d", \\
+    SPYER_CPOOL("Chain Cell %X is Get from Chain Pool %X. TimeStamp %d", \
                  chain, (mpool_t *)&cpool, ticks_get()); 
 
     return chain; 
@@ -97,16 +99,16 @@ int16_t cpool_put(chain_t *chain)
 
     ASSERT_REQUIRE(chain != (chain_t *)0);
     if (chain == (chain_t *)0) { 
-        return FAILURE
+        return FAILURE; 
     } 
 
     /* Release the Chain Cell */
     ret = mpool_put((void_t *)chain); 
     ASSERT_ENSURE(ret == TRUE); 
 
-    SPYER_CPOOL("Chain Cell %X is Put into Chain Pool %X, Result %d. TimeStamp %d", \\
+    SPYER_CPOOL("Chain Cell %X is Put into Chain Pool %X, Result %d. TimeStamp %d", \
                  chain, (mpool_t *)&cpool, ret, ticks_get()); 
-    }
+
     return ret;
 }
 
@@ -49,12 +49,10 @@ extern "C" {
 
 /***************************************************************************************
 *   Chain List Struct.
+*
+*   NOTE: The chain_t is Defined in "event.h", Because the Event Embed the Chain Cell 
+*         when ECHAIN_INTRUSIVE_ENABLE is Defined. 
 ***************************************************************************************/
-typedef struct chain_tag {
-    struct chain_tag *next;    /* Next     Location of Chain List */
-    struct chain_tag *fore;    /* Previous Location of Chain List */
-    void_t *builtin;           /* Built-In Object */
-}chain_t;
 
 /***************************************************************************************
 *   Memory Pool for Chain List.
@@ -64,7 +62,7 @@ typedef struct chain_tag {
     *   Macro to Override the Default Amount of Chain Pool Array.
     *
     *   Default is 256. The Size of Memory Pool is 
-    *   (sizeof(chain_t) + sizeof(void_t *)) * (CPOOL_AMOUNT + 1) 
+    *   (sizeof(chain_t) + MPOOL_HEADER) * (CPOOL_AMOUNT + 1) 
     *   NOTE: 
     *   (1) The Chain Pool Array is Used in the Range of Priority Based Event Chain 
     *       and Enroll Book, So the Value of CPOOL_AMOUNT must Meet Their 
@@ -74,7 +72,7 @@ typedef struct chain_tag {
 #endif
 
 /*  Buffer of Chain Pool */
-#define SIZE_BUFF_CPOOL    (sizeof(chain_t) + sizeof(void_t *)) * (CPOOL_AMOUNT + 1)
+#define SIZE_BUFF_CPOOL    (sizeof(chain_t) + MPOOL_HEADER) * (CPOOL_AMOUNT + 1)
 CPOOL_EXT uint8_t buff_cpool [SIZE_BUFF_CPOOL]; 
 /*  Memory Pool */
 CPOOL_EXT mpool_t cpool;
@@ -129,7 +127,8 @@ CPOOL_EXT int16_t cpool_put(chain_t *chain);
 CPOOL_EXT uint16_t cpool_margin(void_t); 
 
 #ifdef SPYER_CPOOL_ENABLE   /* Spy Debuger Enabled */
-    #define SPYER_CPOOL(format, ...)   spyer_((const int8_t *)format, ##__VA_ARGS__)
+    #define SPYER_CPOOL(format, ...)   \
+        spyer_ch_(SPYER_CH_CPOOL, (const int8_t *)format, ##__VA_ARGS__)
 #else                       /* Spyer Debuger Disabled */
     #define SPYER_CPOOL(format, ...)   ((void_t)0)
 #endif  /* End of SPYER_CPOOL_ENABLE */
@@ -0,0 +1,91 @@
+/***************************************************************************************
+*   The MIT License (MIT)
+*   Copyright (C) 2005 JinHui Han, <Email: ferrethan485@sohu.com, QQ: 1901589440>
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in
+*   all copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+*   THE SOFTWARE.
+***************************************************************************************/
+
+/***************************************************************************************
+*   Component : Active Object Application FrameWork
+*   Group : Cycles
+*   File Name : cycles.h
+*   Version : 1.0
+*   Description : Base for High-Resolution Cycle Counter
+*   Author : JinHui Han
+*   History : 
+*          Name            Date                    Remarks
+*       JinHui Han      05-09-2005      Created Initial Version 1.0
+*       JinHui Han      05-09-2005      Verified Version 1.0
+***************************************************************************************/
+
+#ifndef _CYCLES_H
+#define _CYCLES_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef  EXTERN_GLOBALS
+    #define CYCLES_EXT
+#else
+    #define CYCLES_EXT   extern
+#endif
+
+/***************************************************************************************
+*   Initialize the Cycle Counter.
+*
+*   Description: Start the Free-Running High-Resolution Counter of the Port. 
+*   Argument: none
+*   Return: none
+*
+*   NOTE: 
+*   (1) Called by system_init() or main_(), before Any Active Object Runs. 
+**************************************************************************************/
+CYCLES_EXT void_t cycles_init(void_t);
+
+/***************************************************************************************
+*   Get the Cycle Counter.
+*
+*   Description: Get the Current Value of the Free-Running Counter. 
+*   Argument: none
+*   Return: The Value of Counter, in the Units of cycles_hz(). 
+*
+*   NOTE: 
+*   (1) The Counter Wraps Around at 32 Bits, the Difference of Two Values Read 
+*       within One Period is Correct in the Unsigned Arithmetic. 
+*   (2) Callable from the ISRs, without Lock. 
+**************************************************************************************/
+CYCLES_EXT uint32_t cycles_get(void_t);
+
+/***************************************************************************************
+*   Get the Frequency of the Cycle Counter.
+*
+*   Description: Get the Counts per Second of the Cycle Counter. 
+*   Argument: none
+*   Return: The Frequency in Hz. 
+*
+*   NOTE: 
+**************************************************************************************/
+CYCLES_EXT uint32_t cycles_hz(void_t);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif      /* End of _CYCLES_H */
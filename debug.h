@@ -59,6 +59,16 @@ extern "C" {
     #define DEBUG_BUFFER_SIZE     4*1024      /* Default is 4KB */
 #endif      /* End of DEBUG_BUFFER_SIZE */
 
+#ifdef POSIX_HOST
+#ifndef DEBUG_HOST_FILE
+    /***********************************************************************************
+    *   This Constant Defines the Path of File which Receives the Debug Output on 
+    *   Host, NULL Means the Standard Output. 
+    ***********************************************************************************/
+    #define DEBUG_HOST_FILE     ((char const *)0)   /* Default is Standard Output */
+#endif      /* End of DEBUG_HOST_FILE */
+#endif      /* End of POSIX_HOST */
+
 /***************************************************************************************
 *   Buffer for Debug Serial Port
 ***************************************************************************************/
@@ -112,6 +122,20 @@ DEBUG_EXT int16_t debug_is_empty(void_t);
 ***************************************************************************************/
 DEBUG_EXT int16_t debug_puts(int8_t * string);
 
+/***************************************************************************************
+*   Put One Block into Debug Buffer. 
+*
+*   Description: Put One Block of Binary Data into Debug Buffer. 
+*   Argument: block -- The Pointer of Block Which will be Put into Debug Buffer. 
+*             size  -- The Size of Block in Bytes. 
+*   Return: 1 is True, 0 is False, -1 is Failure
+*
+*   NOTE: 
+*   (1) The Overrun is Handled as debug_puts(). 
+*   (2) debug_put_block() is Protected with a Critical Section.
+***************************************************************************************/
+DEBUG_EXT int16_t debug_put_block(uint8_t const * block, uint16_t size);
+
 /***************************************************************************************
 *   Byte-Oriented Interface to the Debug Buffer.
 *
@@ -154,10 +178,23 @@ DEBUG_EXT uint16_t debug_get_byte(void_t);
 ***************************************************************************************/
 DEBUG_EXT uint8_t const *debug_get_block(uint16_t *byte_count);
 
+#ifdef POSIX_HOST
 /***************************************************************************************
-*   Interrupt Service Routine Implementation for Debug Serial Port.
+*   Flush the Debug Buffer on Host.
+*
+*   Description: Write All the Bytes in the Debug Buffer into the Standard Output, 
+*                or into the DEBUG_HOST_FILE. 
+*   Argument: none
+*   Return:  1 is True, 0 is False, -1 is Failure 
+*
+*   NOTE: 
+*   (1) Plays the Transmit ISR of Debug Serial Port, Called by the Ticker Thread 
+*       at Every Tick, and May be Called by the Application before Exit. 
+*   (2) debug_put_block() Calls It too, when the Block would Overrun the Buffer, so 
+*       the Binary Records of Spyer are not Lost on Host. 
 ***************************************************************************************/
-DEBUG_EXT
+DEBUG_EXT int16_t debug_flush(void_t);
+#endif  /* End of POSIX_HOST */
 
 #ifdef __cplusplus
 }
@@ -43,61 +43,418 @@
 #include "spyer.h"
 #include "ticks.h"
 #include "fault.h"
+#include "lookup.h"
 #include "mpool.h"
 #include "event.h"
+#include "epool.h"
 #include "cpool.h"
+#include "cycles.h"
 
 #define  EXTERN_GLOBALS
 #include "echain.h"
 
 ASSERT_THIS_FILE(echain.c)
 FAULT_THIS_FILE(echain.c)
+SPYER_THIS_FILE(4)
 
 /***************************************************************************************
-*   echain_init() Implementation.
+*   Stamp the Event when Posted, the Queue Wait is Measured from Here. 
+***************************************************************************************/
+#ifdef ACTIVE_PROFILE_ENABLE
+#define ECHAIN_STAMP_(event_)   ((event_)->stamp_ = cycles_get())
+#else
+#define ECHAIN_STAMP_(event_)   ((void_t)0)
+#endif  /* End of ACTIVE_PROFILE_ENABLE */
+
+/***************************************************************************************
+*   echain_cell_get_() Implementation. Internal
+*
+*   NOTE: 
+*   (1) When ECHAIN_INTRUSIVE_ENABLE is Defined, the Embedded Chain Cell of Event is 
+*       Used if It is Free, It Serve the Single Consumer Post (and the First Consumer 
+*       of a Multicast) without Touching the Chain Pool. 
+*   (2) Otherwise (the Event is Already in Other Event Chain by Multicast), the Cell 
+*       is Get from Chain Pool as the Fan-Out Descriptor of Event. 
 ***************************************************************************************/
-int16_t echain_init(chain_t **me)
+static chain_t *echain_cell_get_(event_t *event)
 {
-    int16_t ret; 
+    chain_t *chain; 
 
-    ASSERT_REQUIRE(me != (chain_t **)0); 
-    if (me == (chain_t **)0) { 
-        return FAILURE; 
+#ifdef ECHAIN_INTRUSIVE_ENABLE
+    INT_LOCK_KEY_
+
+    /* Claim the Embedded Chain Cell */
+    chain = (chain_t *)0; 
+    INT_LOCK_(); 
+    if (event->link_.builtin == (void_t *)0) { 
+        chain = (chain_t *)&(event->link_); 
+        chain->builtin = (void_t *)event; 
     } 
+    INT_UNLOCK_(); 
+    if (chain != (chain_t *)0) { 
+        return chain; 
+    } 
+#endif  /* End of ECHAIN_INTRUSIVE_ENABLE */
 
-    *me = (chain_t *)0;    /* Initialize the List Head to 0 */
+    /* Get the Block from Event Chain Pool */
+    chain = (chain_t *)cpool_get(); 
+    if (chain != (chain_t *)0) { 
+        /* Initialize the Event Chain Cell */
+        chain->builtin = (void_t *)event; 
+    } 
+    return chain; 
+}
 
-    SPYER_ECHAIN("Priority Based Event Chain %X is Initialized", me); 
+/***************************************************************************************
+*   echain_cell_put_() Implementation. Internal
+***************************************************************************************/
+static int16_t echain_cell_put_(chain_t *chain)
+{
+#ifdef ECHAIN_INTRUSIVE_ENABLE
+    if (chain == (chain_t *)&(((event_t *)(chain->builtin))->link_)) { 
+        /* Free the Embedded Chain Cell */
+        chain->builtin = (void_t *)0; 
+        return TRUE; 
+    } 
+#endif  /* End of ECHAIN_INTRUSIVE_ENABLE */
+
+    /* Release the Block of Event Chain Cell */
+    return cpool_put(chain); 
+}
+
+/***************************************************************************************
+*   echain_release_() Implementation. Internal
+*
+*   NOTE: 
+*   (1) Release the Detached List of Event Chain Cells (Terminated by NULL "next"), 
+*       and Their Events, in Batches of MPOOL_BATCH. 
+*   (2) The Chain Cells are Released before the Events, They maybe Embedded. 
+***************************************************************************************/
+static int16_t echain_release_(chain_t *current)
+{
+    int16_t  ret; 
+    uint16_t cells; 
+    uint16_t count; 
+    chain_t *next; 
+    event_t *event; 
+    void_t  *cell[MPOOL_BATCH]; 
+    event_t *events[MPOOL_BATCH]; 
+
+    ret   = TRUE; 
+    cells = (uint16_t)0; 
+    count = (uint16_t)0; 
+    while (current != (chain_t *)0) { 
+        /* Backup the Next Event Chain Cell and the Event */
+        next  = current->next; 
+        event = (event_t *)(current->builtin); 
+#ifdef ECHAIN_INTRUSIVE_ENABLE
+        if (current == (chain_t *)&(event->link_)) { 
+            /* Free the Embedded Chain Cell */
+            current->builtin = (void_t *)0; 
+        } 
+        else { 
+            cell[cells++] = (void_t *)current; 
+        } 
+#else
+        cell[cells++] = (void_t *)current; 
+#endif  /* End of ECHAIN_INTRUSIVE_ENABLE */
+        events[count++] = event; 
+
+        if ((count == (uint16_t)MPOOL_BATCH) || (next == (chain_t *)0)) { 
+            /* Release the Batch of Chain Cells, then the Batch of Events */
+            if ((cells != (uint16_t)0) && (mpool_put_n(cell, cells) != TRUE)) { 
+                ret = FAILURE; 
+            } 
+            if (epool_release_n(events, count) != TRUE) { 
+                ret = FAILURE; 
+            } 
+            cells = (uint16_t)0; 
+            count = (uint16_t)0; 
+        } 
+        current = next; 
+    } 
+    ASSERT_ENSURE(ret == TRUE); 
 
     return ret; 
 }
 
+#ifdef ECHAIN_BUCKET_ENABLE
+
 /***************************************************************************************
-*   echain_post() Implementation.
+*   echain_init() Implementation. Bucketed Chain.
+***************************************************************************************/
+int16_t echain_init(echain_t *me)
+{
+    uint8_t level; 
+
+    ASSERT_REQUIRE(me != (echain_t *)0); 
+    if (me == (echain_t *)0) { 
+        return FAILURE; 
+    } 
+
+    me->bytes = (uint8_t)0; 
+    for (level = (uint8_t)0; level < (uint8_t)sizeof(me->bits); ++level) { 
+        me->bits[level] = (uint8_t)0; 
+    } 
+    for (level = (uint8_t)0; level < (uint8_t)ECHAIN_LEVELS; ++level) { 
+        me->head[level] = (chain_t *)0; 
+        me->tail[level] = (chain_t *)0; 
+    } 
+
+    SPYER_ECHAIN("Bucketed Event Chain %X is Initialized", me); 
+
+    return TRUE; 
+}
+
+/***************************************************************************************
+*   echain_link_() Implementation. Bucketed Chain. Internal, Called with Lock.
+***************************************************************************************/
+static void_t echain_link_(echain_t *me, chain_t *chain)
+{
+    uint8_t level; 
+
+    /* Initialize the Event Chain Cell */
+    chain->next    = (chain_t *)0; 
+    chain->fore    = (chain_t *)0; 
+    /* Get the Level of Event */
+    level = ECHAIN_LEVEL_(((event_t *)(chain->builtin))->priority); 
+
+    if (me->head[level] == (chain_t *)0) { 
+        /* The Level is Empty, Mark It into the Occupancy Bitmap */
+        me->head[level] = chain; 
+        me->bits[ROM_BYTE(&lookup_div8[level])] |= ROM_BYTE(&lookup_bit_or[level]); 
+        me->bytes |= ROM_BYTE(&lookup_bit_or[ROM_BYTE(&lookup_div8[level])]); 
+    } 
+    else { 
+        /* Append this Event into the Tail of the Level */
+        me->tail[level]->next = chain; 
+    } 
+    me->tail[level] = chain; 
+}
+
+/***************************************************************************************
+*   echain_post() Implementation. Bucketed Chain.
 ***************************************************************************************/
-int16_t echain_post(chain_t **me, event_t *event)
+int16_t echain_post(echain_t *me, event_t *event)
 {
     chain_t *chain;
-    chain_t *current;
 
-    ASSERT_REQUIRE(me  != (chain_t **)0);
+    INT_LOCK_KEY_
+
+    ASSERT_REQUIRE(me  != (echain_t *)0);
     ASSERT_REQUIRE(event != (event_t *)0);
-    if ((me == (chain_t **)0) || (event == (event_t *)0)) { 
+    if ((me == (echain_t *)0) || (event == (event_t *)0)) { 
         return FAILURE; 
     } 
     
-    /* Get the Block from Event Chain Pool */
-    chain = (chain_t *)cpool_get(); 
+    /* Get the Event Chain Cell */
+    chain = echain_cell_get_(event); 
     ASSERT_ENSURE(chain != (chain_t *)0); 
     if (chain == (chain_t *)0) { 
         return FAILURE; 
     }
+    ECHAIN_STAMP_(event); 
 
-    /* Initialize the Event Chain Cell */
-    chain->builtin = (void_t *)event; 
+    INT_LOCK_();
+    echain_link_(me, chain); 
+    INT_UNLOCK_();
+
+    SPYER_ECHAIN("Event %X is Post into Event Chain %X, Signal %d. TimeStamp %d", \
+                  event, me, event->signal, ticks_get()); 
+
+    return TRUE; 
+}
+
+/***************************************************************************************
+*   echain_get() Implementation. Bucketed Chain.
+***************************************************************************************/
+event_t *echain_get(echain_t *me)
+{
+    int16_t  ret; 
+    uint8_t  level; 
+    event_t *event; 
+    chain_t *current; 
+
+    INT_LOCK_KEY_
+
+    ASSERT_REQUIRE(me != (echain_t *)0);
+    if (me == (echain_t *)0) { 
+        return (event_t *)0; 
+    } 
+
+    INT_LOCK_();
+    if (me->bytes == (uint8_t)0) { 
+        /* The Priority-Based Event Chain is Empty */
+        INT_UNLOCK_();
+        return (event_t *)0; 
+    } 
+    /* Find the Highest Priority Level which is not Empty */
+    level = ROM_BYTE(&lookup_unmap[me->bytes]); 
+    level = (uint8_t)((level << 3) + ROM_BYTE(&lookup_unmap[me->bits[level]])); 
+    /* Remove the Head of the Level */
+    current = me->head[level]; 
+    me->head[level] = current->next; 
+    if (me->head[level] == (chain_t *)0) { 
+        /* The Level become Empty, Clear It from the Occupancy Bitmap */
+        me->tail[level] = (chain_t *)0; 
+        me->bits[ROM_BYTE(&lookup_div8[level])] &= ROM_BYTE(&lookup_bit_and[level]); 
+        if (me->bits[ROM_BYTE(&lookup_div8[level])] == (uint8_t)0) { 
+            me->bytes &= ROM_BYTE(&lookup_bit_and[ROM_BYTE(&lookup_div8[level])]); 
+        } 
+    } 
+    INT_UNLOCK_();
+
+    /* Get The Pointer of Event */
+    event = (event_t *)(current->builtin); 
+
+    /* Release the Event Chain Cell */
+    ret = echain_cell_put_((chain_t *)current); 
+    ASSERT_ENSURE(ret == TRUE); 
+
+    SPYER_ECHAIN("Event %X is Get from Event Chain %X, Signal %d, Dynamic %d. TimeStamp %d", \
+                  event, me, event->signal, event->dynamic_, ticks_get()); 
+
+    return event;
+}
+
+/***************************************************************************************
+*   echain_front() Implementation. Bucketed Chain.
+***************************************************************************************/
+event_t *echain_front(echain_t *me)
+{
+    uint8_t  level; 
+    event_t *event; 
+
+    INT_LOCK_KEY_
+
+    ASSERT_REQUIRE(me != (echain_t *)0);
+    if (me == (echain_t *)0) { 
+        return (event_t *)0; 
+    } 
+
+    event = (event_t *)0; 
+    INT_LOCK_();
+    if (me->bytes != (uint8_t)0) { 
+        /* Find the Highest Priority Level which is not Empty */
+        level = ROM_BYTE(&lookup_unmap[me->bytes]); 
+        level = (uint8_t)((level << 3) + ROM_BYTE(&lookup_unmap[me->bits[level]])); 
+        event = (event_t *)(me->head[level]->builtin); 
+    } 
+    INT_UNLOCK_();
+
+    return event;
+}
+
+/***************************************************************************************
+*   echain_flush() Implementation. Bucketed Chain.
+***************************************************************************************/
+int16_t echain_flush(echain_t *me)
+{
+    int16_t  ret; 
+    uint8_t  level; 
+    chain_t *head; 
+    chain_t *tail; 
+
+    INT_LOCK_KEY_
+
+    ASSERT_REQUIRE(me != (echain_t *)0);
+    if (me == (echain_t *)0) { 
+        return FAILURE; 
+    } 
+
+    /* Detach All Levels as One List, from the Highest Priority Level */
+    head = (chain_t *)0; 
+    tail = (chain_t *)0; 
+    INT_LOCK_();
+    for (level = (uint8_t)0; level < (uint8_t)ECHAIN_LEVELS; ++level) { 
+        if (me->head[level] != (chain_t *)0) { 
+            if (head == (chain_t *)0) { 
+                head = me->head[level]; 
+            } 
+            else { 
+                tail->next = me->head[level]; 
+            } 
+            tail = me->tail[level]; 
+            me->head[level] = (chain_t *)0; 
+            me->tail[level] = (chain_t *)0; 
+        } 
+    } 
+    me->bytes = (uint8_t)0; 
+    for (level = (uint8_t)0; level < (uint8_t)sizeof(me->bits); ++level) { 
+        me->bits[level] = (uint8_t)0; 
+    } 
+    INT_UNLOCK_();
+
+    /* Release the Chain Cells and Events in Batches */
+    ret = echain_release_(head); 
+
+    SPYER_ECHAIN("Event Chain %X is Flush Out. TimeStamp %d", me, ticks_get()); 
+
+    return ret;
+}
+
+/***************************************************************************************
+*   echain_count() Implementation. Bucketed Chain.
+***************************************************************************************/
+uint16_t echain_count(echain_t *me)
+{
+    uint8_t  level; 
+    uint16_t count; 
+    chain_t *chain; 
 
     INT_LOCK_KEY_
+
+    ASSERT_REQUIRE(me != (echain_t *)0);
+    if (me == (echain_t *)0) { 
+        return (uint16_t)0; 
+    } 
+
+    count = (uint16_t)0; 
     INT_LOCK_();
+    for (level = (uint8_t)0; level < (uint8_t)ECHAIN_LEVELS; ++level) { 
+        chain = me->head[level]; 
+        while (chain != (chain_t *)0) { 
+            ++count; 
+            chain = (chain == me->tail[level]) ? (chain_t *)0 : chain->next; 
+        } 
+    } 
+    INT_UNLOCK_();
+
+    return count;
+}
+
+#else
+
+/***************************************************************************************
+*   echain_init() Implementation.
+***************************************************************************************/
+int16_t echain_init(echain_t *me)
+{
+    int16_t ret; 
+
+    ret = FALSE; 
+    ASSERT_REQUIRE(me != (chain_t **)0); 
+    if (me == (chain_t **)0) { 
+        return ret; 
+    } 
+
+    *me = (chain_t *)0;    /* Initialize the List Head to 0 */
+    ret = TRUE; 
+
+    SPYER_ECHAIN("Priority Based Event Chain %X is Initialized", me); 
+
+    return ret; 
+}
+
+/***************************************************************************************
+*   echain_link_() Implementation. Internal, Called with Lock.
+***************************************************************************************/
+static void_t echain_link_(echain_t *me, chain_t *chain)
+{
+    event_t *event; 
+    chain_t *current;
+
+    event = (event_t *)(chain->builtin); 
     if(*me == (chain_t *)0) {   /* If Priority-Based Event Chain is NULL */
         *me = chain;            /* Set the List Head */
         chain->next = chain;
@@ -137,9 +494,35 @@ int16_t echain_post(chain_t **me, event_t *event)
             chain->next->fore = chain;
         }
     }
+}
+
+/***************************************************************************************
+*   echain_post() Implementation.
+***************************************************************************************/
+int16_t echain_post(echain_t *me, event_t *event)
+{
+    chain_t *chain;
+
+    ASSERT_REQUIRE(me  != (chain_t **)0);
+    ASSERT_REQUIRE(event != (event_t *)0);
+    if ((me == (chain_t **)0) || (event == (event_t *)0)) { 
+        return FAILURE; 
+    } 
+    
+    /* Get the Event Chain Cell */
+    chain = echain_cell_get_(event); 
+    ASSERT_ENSURE(chain != (chain_t *)0); 
+    if (chain == (chain_t *)0) { 
+        return FAILURE; 
+    }
+    ECHAIN_STAMP_(event); 
+
+    INT_LOCK_KEY_
+    INT_LOCK_();
+    echain_link_(me, chain); 
     INT_UNLOCK_();
 
-    SPYER_ECHAIN("Event %X is Post into Event Chain %X, Signal %d. TimeStamp %d", \\
+    SPYER_ECHAIN("Event %X is Post into Event Chain %X, Signal %d. TimeStamp %d", \
                   event, me, event->signal, ticks_get()); 
 
     return TRUE; 
@@ -148,7 +531,7 @@ int16_t echain_post(chain_t **me, event_t *event)
 /***************************************************************************************
 *   echain_get() Implementation.
 ***************************************************************************************/
-event_t *echain_get(chain_t **me)
+event_t *echain_get(echain_t *me)
 {
     int16_t ret; 
     event_t *event; 
@@ -181,63 +564,153 @@ event_t *echain_get(chain_t **me)
         /* Get The Pointer of Event */
         event = (event_t *)(current->builtin); 
 
-        /* Release the Block of Event Chain Cell */
-        ret = cpool_put((chain_t *)current); 
+        /* Release the Event Chain Cell */
+        ret = echain_cell_put_((chain_t *)current); 
         INT_UNLOCK_();
 
         ASSERT_ENSURE(ret == TRUE); 
 
-        SPYER_ECHAIN("Event %X is Get from Event Chain %X, Signal %d, Dynamic %d. TimeStamp %d", \\
+        SPYER_ECHAIN("Event %X is Get from Event Chain %X, Signal %d, Dynamic %d. TimeStamp %d", \
                   event, me, event->signal, event->dynamic_, ticks_get()); 
     }
     return event;
 }
 
+/***************************************************************************************
+*   echain_front() Implementation.
+***************************************************************************************/
+event_t *echain_front(echain_t *me)
+{
+    ASSERT_REQUIRE(me != (chain_t **)0);
+    if ((me == (chain_t **)0) || (*me == (chain_t *)0)) { 
+        return (event_t *)0; 
+    } 
+    /* The List Head Pointer to the Highest Priority Event */
+    return (event_t *)((*me)->builtin); 
+}
+
 /***************************************************************************************
 *   echain_flush() Implementation.
 ***************************************************************************************/
-int16_t echain_flush(chain_t **me)
+int16_t echain_flush(echain_t *me)
 {
     int16_t ret; 
-    event_t *event; 
     chain_t *current; 
 
+    INT_LOCK_KEY_
+
     ASSERT_REQUIRE(me != (chain_t **)0);
     if (me == (chain_t **)0) { 
         return FAILURE; 
     } 
 
+    /* Detach the Whole Event Chain */
+    INT_LOCK_();
+    current = *me; 
+    *me = (chain_t *)0;
+    INT_UNLOCK_();
+
     /* If Priority-Based Event Chain is NULL */
-    if(*me == (chain_t *)0) { 
+    if(current == (chain_t *)0) { 
         return TRUE; 
     }
-    /* Get the Head of Event Chain */
-    current = *me; 
-    /***********************************************************************************
-    *   NOTE: For Acceptance the Error, This Point Not Use the "&&", But "||".
-    ***********************************************************************************/
-    while ((current->fore != current) && (current->next != current)) { 
-        /* Tear Down the "current" Event Chain Cell */
-        current->next->fore = current->fore; 
-        current->fore->next = current->next;
-        /* Release the Block of Event */
-        ret = epool_release((event_t *)(current->builtin)); 
-        ASSERT_ENSURE(ret >= (int16_t)0); 
-        /* Release the Block of Event Chain Cell */
-        ret = cpool_put((chain_t *)current); 
-        ASSERT_ENSURE(ret == TRUE); 
-        /* Pointer to the Next Event Chain Cell */
-        current = current->next; 
-    }
-    /* Release the Block of Event */
-    ret = epool_release((event_t *)(current->builtin)); 
-    ASSERT_ENSURE(ret >= (int16_t)0); 
-    /* Release the Block of Event Chain Cell */
-    ret = cpool_put((chain_t *)current); 
-    ASSERT_ENSURE(ret == TRUE); 
+    /* Break the Ring behind the Lowest Priority Event */
+    current->fore->next = (chain_t *)0; 
+
+    /* Release the Chain Cells and Events in Batches */
+    ret = echain_release_(current); 
 
     SPYER_ECHAIN("Event Chain %X is Flush Out. TimeStamp %d", me, ticks_get()); 
 
-    *me = (chain_t *)0;
-    return TRUE;
+    return ret;
+}
+
+/***************************************************************************************
+*   echain_count() Implementation.
+***************************************************************************************/
+uint16_t echain_count(echain_t *me)
+{
+    uint16_t count; 
+    chain_t *chain; 
+
+    INT_LOCK_KEY_
+
+    ASSERT_REQUIRE(me != (chain_t **)0);
+    if ((me == (chain_t **)0) || (*me == (chain_t *)0)) { 
+        return (uint16_t)0; 
+    } 
+
+    /* The Chain is Circular, Walk It Once from the Head */
+    count = (uint16_t)0; 
+    INT_LOCK_();
+    chain = *me; 
+    do { 
+        ++count; 
+        chain = chain->next; 
+    } while ((chain != *me) && (chain != (chain_t *)0)); 
+    INT_UNLOCK_();
+
+    return count;
+}
+
+#endif  /* End of ECHAIN_BUCKET_ENABLE */
+
+/***************************************************************************************
+*   echain_multicast() Implementation.
+***************************************************************************************/
+uint16_t echain_multicast(echain_t *chains[], uint16_t n, event_t *event)
+{
+    uint16_t index; 
+    uint16_t first; 
+    uint16_t count; 
+    chain_t *cell[MPOOL_BATCH]; 
+
+    INT_LOCK_KEY_
+
+    ASSERT_REQUIRE(chains != (echain_t **)0);
+    ASSERT_REQUIRE(event != (event_t *)0);
+    ASSERT_REQUIRE(n <= (uint16_t)MPOOL_BATCH);
+    if ((chains == (echain_t **)0) || (event == (event_t *)0) || (n > (uint16_t)MPOOL_BATCH)) { 
+        return (uint16_t)0; 
+    } 
+    if (n == (uint16_t)0) { 
+        return (uint16_t)0; 
+    } 
+
+    first = (uint16_t)0; 
+#ifdef ECHAIN_INTRUSIVE_ENABLE
+    /* Claim the Embedded Chain Cell for the First Event Chain */
+    INT_LOCK_(); 
+    if (event->link_.builtin == (void_t *)0) { 
+        cell[0] = (chain_t *)&(event->link_); 
+        cell[0]->builtin = (void_t *)event; 
+        first = (uint16_t)1; 
+    } 
+    INT_UNLOCK_(); 
+#endif  /* End of ECHAIN_INTRUSIVE_ENABLE */
+
+    /* Get the Other Chain Cells from Chain Pool in One Batch */
+    count = mpool_get_n((mpool_t *)&cpool, (uint16_t)(n - first), (void_t **)&cell[first]); 
+    ASSERT_ENSURE(count == (uint16_t)(n - first)); 
+    /* Run Short, Post into the Chains the Cells are Obtained for */
+    count = (uint16_t)(first + count); 
+    for (index = first; index < count; ++index) { 
+        cell[index]->builtin = (void_t *)event; 
+    } 
+    if (count == (uint16_t)0) { 
+        return (uint16_t)0; 
+    } 
+    ECHAIN_STAMP_(event); 
+
+    /* Rank the Event into Event Chains, One Critical Section per Chain */
+    for (index = (uint16_t)0; index < count; ++index) { 
+        INT_LOCK_();
+        echain_link_(chains[index], cell[index]); 
+        INT_UNLOCK_();
+    } 
+
+    SPYER_ECHAIN("Event %X is Multicast into %d of %d Event Chains, Signal %d. TimeStamp %d", \
+                  event, count, n, event->signal, ticks_get()); 
+
+    return count; 
 }
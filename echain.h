@@ -57,7 +57,69 @@ extern "C" {
 *   Priority-Based Event Chain, It Pointer to The Highest Priority's Event.
 *
 *   This Priority-Based Event Chain is not Capable of Blocking on the get() Operation, 
+*
+*   Two Implementations are Available, Both are Accessed through the Same API: 
+*   (1) Default, the Sorted Bidirectional List. echain_post() Search the Insert Point 
+*       from the Tail of List, It is O(n) with Interrupts Locked. 
+*   (2) Bucketed Chain (ECHAIN_BUCKET_ENABLE), One FIFO per Priority Level Plus an 
+*       Occupancy Bitmap, the Highest Priority Level is Found through lookup_unmap[]. 
+*       Both echain_post() and echain_get() are O(1). 
+*
+*   When ECHAIN_INTRUSIVE_ENABLE is Defined, Each Event Embed One Chain Cell "link_", 
+*   which is Used for the Post of Single Consumer, the Chain Cell is Get from Chain 
+*   Pool (cpool) Only when the Event is Multicast to More than One Event Chain. 
 ***************************************************************************************/
+#ifdef ECHAIN_BUCKET_ENABLE
+
+    #ifndef ECHAIN_LEVELS
+        /*******************************************************************************
+        *   Macro to Override the Default Amount of Priority Levels of Bucketed Chain.
+        *
+        *   Default is 16, Range is 1..64. The Size of Bucketed Chain is 
+        *   (2 * sizeof(chain_t *) * ECHAIN_LEVELS + (ECHAIN_LEVELS + 7) / 8 + 1). 
+        *   NOTE: 
+        *   (1) The Event with Priority 0..(ECHAIN_LEVELS - 2) Owns Its Level, 
+        *       the Event with Lower Priority (Priority >= ECHAIN_LEVELS - 1) are 
+        *       Ranked into the Lowest Level with FIFO Order.
+        *******************************************************************************/
+        #define ECHAIN_LEVELS   16
+    #endif
+
+    #if (ECHAIN_LEVELS < 1) || (ECHAIN_LEVELS > 64)
+        #error "ECHAIN_LEVELS Must be in the Range 1..64"
+    #endif
+
+    /* Map the Event Priority to the Level of Bucketed Chain */
+    #define ECHAIN_LEVEL_(priority_)    \
+            ((uint8_t)(((priority_) < (uint16_t)(ECHAIN_LEVELS - 1)) ? (priority_) : (ECHAIN_LEVELS - 1)))
+
+    typedef struct echain_tag { 
+        /* Bit n in "bytes" is 1 when any Bit in bits[n] is 1 */
+        uint8_t   bytes; 
+        /* Bit (n % 8) in bits[n / 8] is 1 when Level n is not Empty */
+        uint8_t   bits[(ECHAIN_LEVELS + 7) / 8]; 
+        /* FIFO of Each Priority Level, Single Linked through chain_t.next */
+        chain_t * head[ECHAIN_LEVELS]; 
+        chain_t * tail[ECHAIN_LEVELS]; 
+    } echain_t; 
+
+    /* Static Initializer of Event Chain */
+    #define ECHAIN_INITIALIZER          { (uint8_t)0 }
+
+    /* The Macro Evaluates to TRUE if the Event Chain "me_" is Empty */
+    #define echain_is_empty(me_)        (((echain_t *)(me_))->bytes == (uint8_t)0)
+
+#else
+
+    typedef chain_t * echain_t; 
+
+    /* Static Initializer of Event Chain */
+    #define ECHAIN_INITIALIZER          ((chain_t *)0)
+
+    /* The Macro Evaluates to TRUE if the Event Chain "me_" is Empty */
+    #define echain_is_empty(me_)        (*((echain_t *)(me_)) == (chain_t *)0)
+
+#endif  /* End of ECHAIN_BUCKET_ENABLE */
 
 /***************************************************************************************
 *   Initializes the Priority-Based Event Chain
@@ -68,7 +130,7 @@ extern "C" {
 *
 *   NOTE: 
 ***************************************************************************************/
-ECHAIN_EXT int16_t echain_init(chain_t **me); 
+ECHAIN_EXT int16_t echain_init(echain_t *me); 
 
 /***************************************************************************************
 *   Post Event into Priority-Based Event Chain. 
@@ -85,7 +147,30 @@ ECHAIN_EXT int16_t echain_init(chain_t **me);
 *       not to Call it from within a Critical Section when Nesting of Critical 
 *       Section is not Supported.
 ***************************************************************************************/
-ECHAIN_EXT int16_t echain_post(chain_t **me, event_t *event);
+ECHAIN_EXT int16_t echain_post(echain_t *me, event_t *event);
+
+/***************************************************************************************
+*   Post One Event into Several Priority-Based Event Chains. 
+*
+*   Description: Post the Event into Each of "n" Event Chains, the Chain Cells are 
+*                Obtained from Chain Pool in One Batch and Ranked into the Chains 
+*                One Critical Section per Chain. 
+*   Argument: chains -- The Pointers to the List Heads of Event Chains. 
+*             n -- The Number of Event Chains, not Greater than MPOOL_BATCH. 
+*             event -- The Event which is be Appended. 
+*   Return: The Number of Event Chains the Event is Post into, the First Ones of 
+*           "chains". Less than "n" is Failure. 
+*
+*   NOTE: 
+*   (1) The Caller Holds One Reference of Event for Each Chain, and Drops the 
+*       References of the Chains the Event is not Post into. 
+*   (2) When the Chain Pool Runs Short, the Event is Post into as Many Chains as 
+*       the Cells Obtained. 
+*   (3) This Function Uses Internally a Critical Section, so You should be Careful 
+*       not to Call it from within a Critical Section when Nesting of Critical 
+*       Section is not Supported.
+***************************************************************************************/
+ECHAIN_EXT uint16_t echain_multicast(echain_t *chains[], uint16_t n, event_t *event);
 
 /***************************************************************************************
 *   Get Event from Priority-Based Event Chain. 
@@ -102,7 +187,21 @@ ECHAIN_EXT int16_t echain_post(chain_t **me, event_t *event);
 *       not to Call it from within a Critical Section when Nesting of Critical 
 *       Section is not Supported.
 ***************************************************************************************/
-ECHAIN_EXT event_t *echain_get(chain_t **me);
+ECHAIN_EXT event_t *echain_get(echain_t *me);
+
+/***************************************************************************************
+*   Peek the Highest Priority Event of Priority-Based Event Chain. 
+*
+*   Description: Return the Event which Have Highest Priority, but not Remove It from 
+*                the Priority-Based Event Chain. 
+*   Argument: me -- Pointer to the List Head of Event Chain. 
+*   Return: The Pointer to Highest Priority Event, or else Return NULL if Have Not 
+*           Event in that Chain.
+*
+*   NOTE: 
+*   (1) This Function is Called from Object Itself.
+***************************************************************************************/
+ECHAIN_EXT event_t *echain_front(echain_t *me);
 
 /***************************************************************************************
 *   Flush Out the Priority-Based Event Chain. 
@@ -116,11 +215,27 @@ ECHAIN_EXT event_t *echain_get(chain_t **me);
 *   (1) This Function is Called from Object Itself. 
 *   (2) If has ISR Post the Event into Event Chain, You Must Disable this ISR before
 *       Call echain_flush(). 
+*   (3) The Chain is Detached in One Critical Section, the Chain Cells and Events 
+*       are Released in Batches of MPOOL_BATCH. 
+***************************************************************************************/
+ECHAIN_EXT int16_t echain_flush(echain_t *me);
+
+/***************************************************************************************
+*   Count the Events in Priority-Based Event Chain. 
+*
+*   Description: Count the Events Ranked in the Event Chain. 
+*   Argument: me -- Pointer to the List Head of Event Chain. 
+*   Return: The Number of Events. 
+*
+*   NOTE: 
+*   (1) It Walks the Chain with Interrupts Locked, O(n). Used for the Measurement 
+*       (Simulation, Debug), not in the Hot Path. 
 ***************************************************************************************/
-ECHAIN_EXT int16_t echain_flush(chain_t **me);
+ECHAIN_EXT uint16_t echain_count(echain_t *me);
 
 #ifdef SPYER_ECHAIN_ENABLE   /* Spy Debuger Enabled */
-    #define SPYER_ECHAIN(format, ...)   spyer_((const int8_t *)format, ##__VA_ARGS__)
+    #define SPYER_ECHAIN(format, ...)   \
+        spyer_ch_(SPYER_CH_ECHAIN, (const int8_t *)format, ##__VA_ARGS__)
 #else                       /* Spyer Debuger Disabled */
     #define SPYER_ECHAIN(format, ...)   ((void_t)0)
 #endif  /* End of SPYER_ECHAIN_ENABLE */
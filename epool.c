@@ -44,13 +44,89 @@
 #include "ticks.h"
 #include "fault.h"
 #include "mpool.h"
+#include "magazine.h"
 #include "event.h"
+#ifdef SIM_ENABLE
+#include "echain.h"
+#include "fsm.h"
+#include "hsm.h"
+#include "active.h"
+#include "sim.h"
+#endif  /* End of SIM_ENABLE */
 
 #define  EXTERN_GLOBALS
 #include "epool.h"
 
 ASSERT_THIS_FILE(epool.c)
 FAULT_THIS_FILE(epool.c)
+SPYER_THIS_FILE(5)
+
+/***************************************************************************************
+*   The Events are Taken and Recycled through the Magazines of the Thread, if Any. 
+***************************************************************************************/
+#ifdef MPOOL_MAGAZINE_ENABLE
+    #define EPOOL_GET_(me_)         magazine_get(me_)
+    #define EPOOL_PUT_(block_)      magazine_put(block_)
+#else
+    #define EPOOL_GET_(me_)         mpool_get(me_)
+    #define EPOOL_PUT_(block_)      mpool_put(block_)
+#endif  /* End of MPOOL_MAGAZINE_ENABLE */
+
+/***************************************************************************************
+*   epool_put_n_() Implementation. Internal
+*   Recycle the Garbage Events Collected by epool_release_n(). 
+***************************************************************************************/
+static int16_t epool_put_n_(void_t *blocks[], uint16_t n)
+{
+#ifdef MPOOL_MAGAZINE_ENABLE
+    int16_t  ret; 
+    uint16_t index; 
+
+    /* The Magazine of the Thread Needs no Lock, Put One by One */
+    ret = TRUE; 
+    for (index = (uint16_t)0; index < n; ++index) { 
+        if (magazine_put(blocks[index]) != TRUE) { 
+            ret = FAILURE; 
+        } 
+    } 
+    return ret; 
+#else
+    return mpool_put_n(blocks, n); 
+#endif  /* End of MPOOL_MAGAZINE_ENABLE */
+}
+
+#ifdef EPOOL_CLASS_ENABLE
+/***************************************************************************************
+*   Size-Class Registry, Sorted by the Block Size. 
+***************************************************************************************/
+typedef struct epool_class_tag { 
+    mpool_t      *pool; 
+    epool_stat_t  stat; 
+} epool_class_t; 
+
+static epool_class_t epool_class_[EPOOL_CLASSES]; 
+static uint16_t      epool_classes_;    /* Number of Registered Pools */
+#endif  /* End of EPOOL_CLASS_ENABLE */
+
+/***************************************************************************************
+*   epool_set_() Implementation. Internal
+*   Initialize the Event Block Obtained from the Pool. 
+***************************************************************************************/
+static void_t epool_set_(event_t *event, signal_t signal, uint16_t priority, uint16_t threshold)
+{
+    event->signal    = signal;      /* Set Signal   for This Event */
+    event->priority  = priority;    /* Set Priority for This Event */
+    event->threshold = threshold;    /* Set Highest Priority Threshold for This Event */
+    event->record    = (void_t *)0; /* Set Data Record for This Event */
+    /***********************************************************************************
+    *   Store the Dynamic Attributes of the Event: The Reference Counter = 0
+    ***********************************************************************************/
+    event->dynamic_ = (int16_t)0; 
+    event->static_  = (int16_t)0; 
+#ifdef ECHAIN_INTRUSIVE_ENABLE
+    event->link_.builtin = (void_t *)0;   /* The Embedded Chain Cell is Free */
+#endif  /* End of ECHAIN_INTRUSIVE_ENABLE */
+}
 
 /***************************************************************************************
 *   epool_init() Implementation.
@@ -62,7 +138,7 @@ int16_t epool_init(mpool_t *me, void_t *begin, uint32_t size, uint16_t event_siz
     /* Perfom the Platform-Dependent Initialization of the Pool */
     ret = mpool_init(me, begin, size, event_size);
 
-    SPYER_EMPOOL("Event Pool %X is Initialized, Start %X, Size %d, Event Size %d.", \\
+    SPYER_EPOOL("Event Pool %X is Initialized, Start %X, Size %d, Event Size %d.", \
                  me, begin, size, event_size); 
     return ret; 
 }
@@ -75,33 +151,198 @@ event_t *epool_new(mpool_t *me, signal_t signal, uint16_t priority, uint16_t thr
     event_t *event;
 
     /* Get Event -- Platform-Dependent */
-    event = (event_t *)mpool_get(me);
+    event = (event_t *)EPOOL_GET_(me);
     ASSERT_ENSURE(event != (event_t *)0);   /* Pool must not Run out of Events */
     if (event == (event_t *)0) { 
         return NULL; 
     } 
+    epool_set_(event, signal, priority, threshold); 
 
-    event->signal    = signal;      /* Set Signal   for This Event */
-    event->priority  = priority;    /* Set Priority for This Event */
-    event->threshold = threshold;    /* Set Highest Priority Threshold for This Event */
-    event->record    = (void_t *)0; /* Set Data Record for This Event */
-    /***********************************************************************************
-    *   Store the Dynamic Attributes of the Event: The Reference Counter = 0
-    ***********************************************************************************/
-    event->dynamic_ = (int16_t)0; 
-    event->static_  = (int16_t)0; 
-
-    SPYER_EMPOOL("New Event %X from Pool %X, Signal %d, Priority %d. TimeStamp %d", \\ 
+    SPYER_EPOOL("New Event %X from Pool %X, Signal %d, Priority %d. TimeStamp %d", \
                   event, me, signal, priority, ticks_get());
     return event;
 }
 
+/***************************************************************************************
+*   epool_new_payload() Implementation.
+***************************************************************************************/
+event_t *epool_new_payload(mpool_t *me, signal_t signal, uint16_t priority, 
+                           uint16_t threshold, void_t const *data, uint16_t size)
+{
+    uint16_t index; 
+    uint8_t *payload; 
+    event_t *event;
+
+    ASSERT_REQUIRE(me != (mpool_t *)0); 
+    if (me == (mpool_t *)0) { 
+        return NULL; 
+    } 
+    /* The Payload Must Fit in the Block after the Header */
+    ASSERT_REQUIRE((uint32_t)EVENT_PAYLOAD_OFFSET + (uint32_t)size <= (uint32_t)me->block_size); 
+    if ((uint32_t)EVENT_PAYLOAD_OFFSET + (uint32_t)size > (uint32_t)me->block_size) { 
+        return NULL; 
+    } 
+
+    event = epool_new(me, signal, priority, threshold); 
+    if (event == (event_t *)0) { 
+        return NULL; 
+    } 
+    payload = (uint8_t *)event_payload(event); 
+    if (data != (void_t const *)0) { 
+        for (index = (uint16_t)0; index < size; ++index) { 
+            payload[index] = ((uint8_t const *)data)[index]; 
+        } 
+    } 
+    /* The Handlers Find the Payload through "record" */
+    event->record = (void_t *)payload; 
+
+    return event;
+}
+
+#ifdef EPOOL_CLASS_ENABLE
+/***************************************************************************************
+*   epool_register() Implementation.
+***************************************************************************************/
+int16_t epool_register(mpool_t *me)
+{
+    uint16_t index; 
+
+    ASSERT_REQUIRE(me != (mpool_t *)0); 
+    if (me == (mpool_t *)0) { 
+        return FAILURE; 
+    } 
+
+    INT_LOCK_KEY_
+    INT_LOCK_();
+    if (epool_classes_ >= (uint16_t)EPOOL_CLASSES) { 
+        INT_UNLOCK_();
+        return FALSE; 
+    } 
+    /* Insertion Sort by the Block Size, the Equal Sizes Keep the Order of Register */
+    index = epool_classes_; 
+    while ((index > (uint16_t)0) && (epool_class_[index - 1].pool->block_size > me->block_size)) { 
+        epool_class_[index] = epool_class_[index - 1]; 
+        --index; 
+    } 
+    epool_class_[index].pool = me; 
+    epool_class_[index].stat.requests  = (uint32_t)0; 
+    epool_class_[index].stat.fallbacks = (uint32_t)0; 
+    epool_class_[index].stat.misses    = (uint32_t)0; 
+    ++epool_classes_; 
+    INT_UNLOCK_();
+
+    SPYER_EPOOL("Event Pool %X is Registered, Block Size %d, Class %d.", \
+                 me, me->block_size, index); 
+    return TRUE; 
+}
+
+/***************************************************************************************
+*   epool_alloc() Implementation.
+***************************************************************************************/
+event_t *epool_alloc(uint16_t size, signal_t signal, uint16_t priority, uint16_t threshold)
+{
+    uint16_t first; 
+    uint16_t index; 
+    event_t *event;
+
+    event = (event_t *)0; 
+
+    INT_LOCK_KEY_
+    INT_LOCK_();
+    /* The Smallest Pool which Fits */
+    for (first = (uint16_t)0; first < epool_classes_; ++first) { 
+        if (epool_class_[first].pool->block_size >= size) { 
+            break; 
+        } 
+    } 
+    if (first >= epool_classes_) { 
+        INT_UNLOCK_();
+        ASSERT_ERROR();     /* No Pool is Large Enough */
+        return NULL; 
+    } 
+    /* Take from the First Non-Empty Pool, so the Empty Pool is not Asserted */
+    for (index = first; index < epool_classes_; ++index) { 
+        if (epool_class_[index].pool->free_cnt > (uint16_t)0) { 
+            event = (event_t *)mpool_get(epool_class_[index].pool); 
+            break; 
+        } 
+    } 
+#ifdef MPOOL_ELASTIC_ENABLE
+    if (index >= epool_classes_) { 
+        /* All Pools are Empty, the Smallest which Fits Borrows from hpool. The Pool 
+           Grows Outside Its Lock, so It is not Called with Interrupts Locked, and 
+           Re-checks the Free Blocks Itself */
+        INT_UNLOCK_();
+        event = (event_t *)mpool_get(epool_class_[first].pool); 
+        INT_LOCK_();
+        index = first; 
+    } 
+#endif  /* End of MPOOL_ELASTIC_ENABLE */
+    ++epool_class_[first].stat.requests; 
+    if (event == (event_t *)0) { 
+        ++epool_class_[first].stat.misses; 
+    } 
+    else if (index != first) { 
+        ++epool_class_[first].stat.fallbacks; 
+    } 
+    INT_UNLOCK_();
+
+    if (event == (event_t *)0) { 
+        SPYER_EPOOL("Event Size %d Misses All Pools, Signal %d. TimeStamp %d", \
+                     size, signal, ticks_get());
+        return NULL; 
+    } 
+    epool_set_(event, signal, priority, threshold); 
+
+    SPYER_EPOOL("New Event %X of Size %d from Class %d, Signal %d, Priority %d. TimeStamp %d", \
+                 event, size, index, signal, priority, ticks_get());
+    return event;
+}
+
+/***************************************************************************************
+*   epool_class_snap() Implementation.
+***************************************************************************************/
+int16_t epool_class_snap(mpool_t *me, epool_stat_t *snap, int16_t clear)
+{
+    uint16_t index; 
+
+    ASSERT_REQUIRE((me != (mpool_t *)0) && (snap != (epool_stat_t *)0)); 
+    if ((me == (mpool_t *)0) || (snap == (epool_stat_t *)0)) { 
+        return FAILURE; 
+    } 
+
+    INT_LOCK_KEY_
+    INT_LOCK_();
+    for (index = (uint16_t)0; index < epool_classes_; ++index) { 
+        if (epool_class_[index].pool == me) { 
+            break; 
+        } 
+    } 
+    if (index >= epool_classes_) { 
+        INT_UNLOCK_();
+        return FALSE; 
+    } 
+    *snap = epool_class_[index].stat; 
+    if (clear != 0) { 
+        epool_class_[index].stat.requests  = (uint32_t)0; 
+        epool_class_[index].stat.fallbacks = (uint32_t)0; 
+        epool_class_[index].stat.misses    = (uint32_t)0; 
+    } 
+    INT_UNLOCK_();
+    return TRUE; 
+}
+#endif  /* End of EPOOL_CLASS_ENABLE */
+
 /***************************************************************************************
 *   epool_release() Implementation.
 ***************************************************************************************/
 int16_t epool_release(event_t *event)
 {
-    int16_t ret;
+    int16_t  ret;
+    int16_t  dynamic;   /* The Count Left, the Event is Gone Once it is Put */
+#ifdef SPYER_EPOOL_ENABLE
+    signal_t signal; 
+#endif  /* End of SPYER_EPOOL_ENABLE */
 
     ASSERT_REQUIRE(event != (event_t *)0); 
     if (event == (event_t *)0) { 
@@ -111,27 +352,117 @@ int16_t epool_release(event_t *event)
     INT_LOCK_KEY_
     INT_LOCK_();
     --event->dynamic_;
-    if (event->dynamic_ > 0) {  /* Isn't This the Last Reference ? */
+    dynamic = event->dynamic_; 
+#ifdef SPYER_EPOOL_ENABLE
+    signal  = event->signal; 
+#endif  /* End of SPYER_EPOOL_ENABLE */
+    if (dynamic > 0) {  /* Isn't This the Last Reference ? */
         /* Decrement the Reference Counter */
         INT_UNLOCK_();
         /* Cast the 'const' Away, which is Legitimate Because it's a Pool Event */
-        SPYER_EMPOOL("Attempt Recycle Event %X to Pool %X, Signal %d, Dynamic %d. TimeStamp %d", \\ 
-                      event, event->mpool_, event->signal, event->dynamic, ticks_get());
+        SPYER_EPOOL("Attempt Recycle Event %X, Signal %d, Dynamic %d. TimeStamp %d", \
+                      event, signal, dynamic, ticks_get());
     }
     else {  /* This is the Last Reference to This Event, Recycle It */
         INT_UNLOCK_();
+#ifdef SIM_ENABLE
+        /* The End of the Event, for the Latency Measured by the Simulator */
+        sim_done(event); 
+#endif  /* End of SIM_ENABLE */
         if (event->static_ == (int16_t)1) {
-            return ret; 
+            /* Static Event is Never Recycled */
+            return (int16_t)0; 
         } 
         /* Cast 'const' Away, which is Legitimate, Because it's a Pool Event */
-        ret = mpool_put((void_t *)event);
+        ret = EPOOL_PUT_((void_t *)event);
         if (ret != TRUE) { 
             return FAILURE;
         } 
-        SPYER_EMPOOL("Recycle Event %X to Pool %X, Signal %d, Dynamic %d. TimeStamp %d", \\ 
-                      event, event->mpool_, event->signal, event->dynamic, ticks_get());
+        SPYER_EPOOL("Recycle Event %X, Signal %d, Dynamic %d. TimeStamp %d", \
+                      event, signal, dynamic, ticks_get());
     } 
-    return  event->dynamic_; 
+    return  dynamic; 
+}
+
+/***************************************************************************************
+*   epool_new_n() Implementation.
+***************************************************************************************/
+uint16_t epool_new_n(mpool_t *me, uint16_t n, event_t *events[], 
+                     signal_t signal, uint16_t priority, uint16_t threshold)
+{
+    uint16_t index; 
+    uint16_t count; 
+
+    count = mpool_get_n(me, n, (void_t **)events); 
+    for (index = (uint16_t)0; index < count; ++index) { 
+        epool_set_(events[index], signal, priority, threshold); 
+    } 
+
+    SPYER_EPOOL("%d New Events from Pool %X, Signal %d, Priority %d. TimeStamp %d", \
+                 count, me, signal, priority, ticks_get());
+    return count; 
+}
+
+/***************************************************************************************
+*   epool_release_n() Implementation.
+***************************************************************************************/
+int16_t epool_release_n(event_t *events[], uint16_t n)
+{
+    int16_t  ret; 
+    uint16_t index; 
+    uint16_t begin; 
+    uint16_t count; 
+    uint16_t dead; 
+    event_t *event; 
+    void_t  *garbage[MPOOL_BATCH]; 
+
+    ASSERT_REQUIRE((events != (event_t **)0) || (n == (uint16_t)0)); 
+    if ((events == (event_t **)0) && (n != (uint16_t)0)) { 
+        return FAILURE; 
+    } 
+
+    ret = TRUE; 
+    for (begin = (uint16_t)0; begin < n; begin += count) { 
+        count = ((n - begin) < (uint16_t)MPOOL_BATCH) ? (uint16_t)(n - begin) : (uint16_t)MPOOL_BATCH; 
+
+        /* Drop the References of the Batch in One Critical Section */
+        {
+            INT_LOCK_KEY_
+            INT_LOCK_();
+            for (index = (uint16_t)0; index < count; ++index) { 
+                event = events[begin + index]; 
+                garbage[index] = (void_t *)0; 
+                if (event == (event_t *)0) { 
+                    continue; 
+                } 
+                --event->dynamic_; 
+                if (event->dynamic_ <= 0) {     /* The Last Reference to This Event */
+                    garbage[index] = (void_t *)event; 
+                } 
+            } 
+            INT_UNLOCK_();
+        }
+
+        /* Compact the Garbage, the Static Events are not Recycled */
+        dead = (uint16_t)0; 
+        for (index = (uint16_t)0; index < count; ++index) { 
+            event = (event_t *)garbage[index]; 
+            if (event == (event_t *)0) { 
+                continue; 
+            } 
+#ifdef SIM_ENABLE
+            /* The End of the Event, for the Latency Measured by the Simulator */
+            sim_done(event); 
+#endif  /* End of SIM_ENABLE */
+            if (event->static_ != (int16_t)1) { 
+                garbage[dead++] = (void_t *)event; 
+            } 
+        } 
+        if ((dead != (uint16_t)0) && (epool_put_n_(garbage, dead) != TRUE)) { 
+            ret = FAILURE; 
+        } 
+    } 
+    return ret; 
 }
 
 /***************************************************************************************
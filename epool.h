@@ -47,6 +47,32 @@ extern "C" {
     #define EPOOL_EXT   extern
 #endif
 
+#ifdef EPOOL_CLASS_ENABLE
+    #ifndef EPOOL_CLASSES
+        /*******************************************************************************
+        *   This Constant Defines the Maximum Number of Event Pools in the Size-Class 
+        *   Registry. 
+        *******************************************************************************/
+        #define EPOOL_CLASSES   4       /* Default is 4 */
+    #endif      /* End of EPOOL_CLASSES */
+
+/***************************************************************************************
+*   Statistics of One Size Class. 
+*
+*   Every epool_alloc() is Charged to the Smallest Pool which Fits the Size, even 
+*   when a Larger Pool Serves It, so the Counters Tell Which Pool is too Small for 
+*   the Real Traffic: 
+*   (1) "requests" is the Allocations whose Best Fit is This Pool. 
+*   (2) "fallbacks" is the Requests Served by a Larger Pool, This Pool was Empty. 
+*   (3) "misses" is the Requests not Served at All, All the Fitting Pools were Empty. 
+***************************************************************************************/
+typedef struct epool_stat_tag { 
+    uint32_t  requests; 
+    uint32_t  fallbacks; 
+    uint32_t  misses; 
+} epool_stat_t; 
+#endif  /* End of EPOOL_CLASS_ENABLE */
+
 /***************************************************************************************
 *   Event Pool Initialization for Dynamic Allocation of Events.
 *
@@ -85,6 +111,88 @@ EPOOL_EXT int16_t epool_init(mpool_t *me, void_t *begin, uint32_t size, uint16_t
 ***************************************************************************************/
 EPOOL_EXT event_t *epool_new(mpool_t *me, signal_t signal, uint16_t priority, uint16_t threshold);
 
+/***************************************************************************************
+*   Size the Event Pool for the Inline Payload. 
+*
+*   EPOOL_BLOCK_SIZE(payload_) is the "event_size" of epool_init() for the Events 
+*   Carrying up to "payload_" Bytes Inline, EPOOL_BUFFER_SIZE(payload_, amount_) is 
+*   the Size of Storage for "amount_" Such Events, Including the Overhead of Pool. 
+*       static uint8_t buff_frame[EPOOL_BUFFER_SIZE(64, 16)]; 
+*       epool_init(&epool_frame, buff_frame, sizeof(buff_frame), EPOOL_BLOCK_SIZE(64)); 
+***************************************************************************************/
+#define EPOOL_BLOCK_SIZE(payload_)          \
+        ((uint16_t)(EVENT_PAYLOAD_OFFSET + (payload_)))
+#define EPOOL_BUFFER_SIZE(payload_, amount_)    \
+        ((EVENT_PAYLOAD_OFFSET + (payload_) + MPOOL_HEADER) * ((amount_) + 1))
+
+/***************************************************************************************
+*   Allocate a Dynamic Event with the Inline Payload.
+*
+*   Description: Allocate a Dynamic Event from Event Pool as epool_new(), and Copy 
+*                the "size" Bytes of "data" into the Inline Payload of Event. 
+*   Argument: me -- Pointer to the mpool_t Sized by EPOOL_BLOCK_SIZE(). 
+*             signal -- Signal of Event. 
+*             priority -- Priority of Event. 
+*             threshold -- Threshold for Preemptive.
+*             data -- The Data Copied into the Payload, or NULL to Leave It for the 
+*                     Caller to Fill through event_payload(). 
+*             size -- The Size of Data in Bytes. 
+*   Return: Returns a Pointer to the Allocated Event Block or NULL if no Free 
+*           Blocks are Available, or the Block is too Small for the "size". 
+*
+*   NOTE: 
+*   (1) "record" of the Event Points to the Payload, and Needn't be Released, 
+*       epool_release() Recycles the Payload with the Event. 
+***************************************************************************************/
+EPOOL_EXT event_t *epool_new_payload(mpool_t *me, signal_t signal, uint16_t priority, 
+                                     uint16_t threshold, void_t const *data, uint16_t size);
+
+#ifdef EPOOL_CLASS_ENABLE
+/***************************************************************************************
+*   Register an Event Pool into the Size-Class Registry. 
+*
+*   Description: Insert the Event Pool into the Registry, which is Sorted by the 
+*                Block Size. 
+*   Argument: me -- Pointer to the mpool_t Initialized by epool_init(). 
+*   Return: 1 is True, 0 is False (the Registry is Full), -1 is Failure
+*
+*   NOTE: 
+*   (1) Register the Pools at the Start-Up, before the First epool_alloc(). 
+*   (2) The Registered Pool can still be Used by epool_new() Directly. 
+***************************************************************************************/
+EPOOL_EXT int16_t epool_register(mpool_t *me);
+
+/***************************************************************************************
+*   Allocate a Dynamic Event by Size. 
+*
+*   Description: Allocate a Dynamic Event from the Smallest Registered Pool whose 
+*                Block Fits the "size", or from the Next Larger One if It is Empty. 
+*   Argument: size -- The Size of Event in Bytes, such as sizeof(my_event_t) or 
+*                     EPOOL_BLOCK_SIZE() of the Inline Payload. 
+*             signal -- Signal of Event. 
+*             priority -- Priority of Event. 
+*             threshold -- Threshold for Preemptive.
+*   Return: Returns a Pointer to the Allocated Event Block or NULL if All the 
+*           Fitting Pools are Empty. 
+*
+*   NOTE: 
+*   (1) Running out of the Pools is Counted in the Statistics, not Asserted, the 
+*       "size" Larger than All the Pools is Asserted. 
+***************************************************************************************/
+EPOOL_EXT event_t *epool_alloc(uint16_t size, signal_t signal, uint16_t priority, uint16_t threshold);
+
+/***************************************************************************************
+*   Snapshot the Statistics of a Size Class. 
+*
+*   Description: Copy the Statistics of the Registered Pool into the "snap". 
+*   Argument: me -- Pointer to the Registered mpool_t. 
+*             snap -- Pointer to the epool_stat_t Receives the Statistics. 
+*             clear -- Non-Zero to Clear the Statistics after the Copy. 
+*   Return: 1 is True, 0 is False (not Registered), -1 is Failure
+***************************************************************************************/
+EPOOL_EXT int16_t epool_class_snap(mpool_t *me, epool_stat_t *snap, int16_t clear);
+#endif  /* End of EPOOL_CLASS_ENABLE */
+
 /***************************************************************************************
 *   Recycle a Dynamic Event.
 *
@@ -112,6 +220,38 @@ EPOOL_EXT event_t *epool_new(mpool_t *me, signal_t signal, uint16_t priority, ui
 ***************************************************************************************/
 EPOOL_EXT int16_t epool_release(event_t *event);
 
+/***************************************************************************************
+*   Allocate Several Dynamic Events.
+*
+*   Description: Allocate up to "n" Dynamic Events from Event Pool in One Critical 
+*                Section, Each is Initialized as by epool_new(). 
+*   Argument: me -- Pointer to the mpool_t from which the Event Blocks are Requested. 
+*             n -- The Number of Events Requested. 
+*             events -- Receives the Pointers to the Events. 
+*             signal -- Signal of Events. 
+*             priority -- Priority of Events. 
+*             threshold -- Threshold for Preemptive.
+*   Return: The Number of Events Allocated, Less than "n" when the Pool Runs Short. 
+*
+*   NOTE: 
+*   (1) The Events are Taken from the Pool Directly, not through the Magazine of 
+*       the Thread (MPOOL_MAGAZINE_ENABLE). 
+***************************************************************************************/
+EPOOL_EXT uint16_t epool_new_n(mpool_t *me, uint16_t n, event_t *events[], 
+                               signal_t signal, uint16_t priority, uint16_t threshold);
+
+/***************************************************************************************
+*   Recycle Several Dynamic Events.
+*
+*   Description: Drop One Reference of Each Event as epool_release(), the Reference 
+*                Counters are Decremented in One Critical Section, and the Events 
+*                which Become Garbage are Recycled in Batches by mpool_put_n(). 
+*   Argument: events -- The Pointers to the Events which are Put Back. 
+*             n -- The Number of Events. 
+*   Return: 1 is True, -1 is Failure
+***************************************************************************************/
+EPOOL_EXT int16_t epool_release_n(event_t *events[], uint16_t n);
+
 /***************************************************************************************
 *   All Event are Recycled for the Given Event Pool ? 
 *
@@ -137,7 +277,8 @@ MPOOL_EXT int16_t epool_all_recycled(mpool_t *me);
 EPOOL_EXT uint16_t epool_margin(mpool_t *me);
 
 #ifdef SPYER_EPOOL_ENABLE   /* Spy Debuger Enabled */
-    #define SPYER_EPOOL(format, ...)   spyer_((const int8_t *)format, ##__VA_ARGS__)
+    #define SPYER_EPOOL(format, ...)   \
+        spyer_ch_(SPYER_CH_EPOOL, (const int8_t *)format, ##__VA_ARGS__)
 #else                        /* Spyer Debuger Disabled */
     #define SPYER_EPOOL(format, ...)   ((void_t)0)
 #endif  /* End of SPYER_EPOOL_ENABLE */
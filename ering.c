@@ -0,0 +1,206 @@
+/***************************************************************************************
+*   The MIT License (MIT)
+*   Copyright (C) 2005 JinHui Han, <Email: ferrethan485@sohu.com, QQ: 1901589440>
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in
+*   all copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+*   THE SOFTWARE.
+***************************************************************************************/
+
+/***************************************************************************************
+*   Component : Active Object Application FrameWork
+*   Group : Event Ring
+*   File Name : ering.c
+*   Version : 1.0
+*   Description : Base for Lock-Free Single-Producer Single-Consumer Event Ring
+*   Author : JinHui Han
+*   History : 
+*          Name            Date                    Remarks
+*       JinHui Han      05-09-2005      Created Initial Version 1.0
+*       JinHui Han      05-09-2005      Verified Version 1.0
+***************************************************************************************/
+
+#include "std_type.h"
+#include "std_def.h"
+#include "config.h"
+#include "lock.h"
+#include "debug.h"
+#include "assert.h"
+#include "spyer.h"
+#include "ticks.h"
+#include "fault.h"
+#include "mpool.h"
+#include "event.h"
+#include "cpool.h"
+#include "echain.h"
+
+#define  EXTERN_GLOBALS
+#include "ering.h"
+
+ASSERT_THIS_FILE(ering.c)
+FAULT_THIS_FILE(ering.c)
+SPYER_THIS_FILE(6)
+
+/***************************************************************************************
+*   ering_init() Implementation.
+***************************************************************************************/
+int16_t ering_init(ering_t *me, event_t *ring_buffer[], uint16_t ring_len)
+{
+    ASSERT_REQUIRE(me != (ering_t *)0);
+    ASSERT_REQUIRE(ring_buffer != (event_t **)0); 
+    if ((me == (ering_t *)0) || (ring_buffer == (event_t **)0)) { 
+        return FAILURE; 
+    } 
+    /* The Length Must be the Power of 2 */
+    ASSERT_REQUIRE((ring_len != (uint16_t)0) && ((ring_len & (ring_len - 1)) == 0)); 
+    if ((ring_len == (uint16_t)0) || ((ring_len & (ring_len - 1)) != 0)) { 
+        return FAILURE; 
+    } 
+
+    me->ring     = &ring_buffer[0];
+    me->mask     = (uint16_t)(ring_len - 1);
+    me->head     = (uint16_t)0;
+    me->tail     = (uint16_t)0;
+    me->lost_cnt = (uint16_t)0;
+    me->max_cnt  = (uint16_t)0;
+
+    SPYER_ERING("Event Ring %X is Initialized.", me); 
+    return TRUE; 
+}
+
+/***************************************************************************************
+*   ering_post() Implementation. 
+*
+*   NOTE: No Spyer Output at Here, Because spyer_() Locks the Interrupts.
+***************************************************************************************/
+int16_t ering_post(ering_t *me, event_t *event) 
+{
+    uint16_t head; 
+    uint16_t tail; 
+
+    ASSERT_REQUIRE(me    != (ering_t *)0);
+    ASSERT_REQUIRE(event != (event_t *)0);
+    if ((me == (ering_t *)0) || (event == (event_t *)0)) { 
+        return FAILURE; 
+    } 
+
+    /* The "head" is Written Only by this Producer */
+    head = me->head; 
+    tail = ERING_LOAD_(&(me->tail)); 
+    if ((uint16_t)(head - tail) > me->mask) { 
+        /* The Ring is Full */
+        ++(me->lost_cnt); 
+        return FALSE; 
+    } 
+    /* Insert Event into the Buffer, then Publish It to the Consumer */
+    me->ring[head & me->mask] = event; 
+    ERING_STORE_(&(me->head), (uint16_t)(head + 1)); 
+    return TRUE; 
+}
+
+/***************************************************************************************
+*   ering_get() Implementation. 
+***************************************************************************************/
+event_t *ering_get(ering_t *me) 
+{
+    uint16_t head; 
+    uint16_t tail; 
+    event_t *event; 
+
+    ASSERT_REQUIRE(me != (ering_t *)0);
+    if (me == (ering_t *)0) { 
+        return (event_t *)0; 
+    } 
+
+    /* The "tail" is Written Only by this Consumer */
+    tail = me->tail; 
+    head = ERING_LOAD_(&(me->head)); 
+    if (head == tail) { 
+        /* The Ring is Empty */
+        return (event_t *)0; 
+    } 
+    if ((uint16_t)(head - tail) > me->max_cnt) { 
+        me->max_cnt = (uint16_t)(head - tail); /* Store Maximum Used so Far */
+    } 
+    /* Extract Event from the Buffer, then Release the Location to the Producer */
+    event = me->ring[tail & me->mask]; 
+    ERING_STORE_(&(me->tail), (uint16_t)(tail + 1)); 
+
+    SPYER_ERING("Event %X is Get from Event Ring %X. TimeStamp %d", event, me, ticks_get()); 
+    return event; 
+}
+
+/***************************************************************************************
+*   ering_drain() Implementation. 
+***************************************************************************************/
+int16_t ering_drain(ering_t *me, echain_t *chain, uint16_t batch) 
+{
+    int16_t  ret; 
+    int16_t  count; 
+    uint16_t head; 
+    uint16_t tail; 
+    event_t *event; 
+
+    ASSERT_REQUIRE(me    != (ering_t *)0);
+    ASSERT_REQUIRE(chain != (echain_t *)0);
+    if ((me == (ering_t *)0) || (chain == (echain_t *)0)) { 
+        return FAILURE; 
+    } 
+
+    /* The "tail" is Written Only by this Consumer */
+    tail = me->tail; 
+    head = ERING_LOAD_(&(me->head)); 
+    if (head == tail) { 
+        /* The Ring is Empty */
+        return (int16_t)0; 
+    } 
+    if ((uint16_t)(head - tail) > me->max_cnt) { 
+        me->max_cnt = (uint16_t)(head - tail); /* Store Maximum Used so Far */
+    } 
+    /* Move the Events into the Priority-Based Event Chain */
+    count = (int16_t)0; 
+    while ((tail != head) && ((uint16_t)count < batch)) { 
+        event = me->ring[tail & me->mask]; 
+        ret = echain_post(chain, event); 
+        ASSERT_ENSURE(ret == TRUE); 
+        if (ret != TRUE) { 
+            /* Keep the Event in the Ring, Try Again Next Time */
+            break; 
+        } 
+        ++tail; 
+        ++count; 
+    } 
+    /* Release the Locations to the Producer */
+    ERING_STORE_(&(me->tail), tail); 
+
+    SPYER_ERING("%d Events are Drained from Event Ring %X into Event Chain %X. TimeStamp %d", \
+                 count, me, chain, ticks_get()); 
+    return count; 
+}
+
+/***************************************************************************************
+*   ering_margin() Implementation. 
+***************************************************************************************/
+uint16_t ering_margin(ering_t *me)
+{
+    ASSERT_REQUIRE(me != (ering_t *)0);
+    if (me == (ering_t *)0) { 
+        return (uint16_t)0; 
+    } 
+
+    return (uint16_t)(me->mask + 1 - me->max_cnt);
+}
@@ -0,0 +1,183 @@
+/***************************************************************************************
+*   The MIT License (MIT)
+*   Copyright (C) 2005 JinHui Han, <Email: ferrethan485@sohu.com, QQ: 1901589440>
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in
+*   all copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+*   THE SOFTWARE.
+***************************************************************************************/
+
+/***************************************************************************************
+*   Component : Active Object Application FrameWork
+*   Group : Event Ring
+*   File Name : ering.h
+*   Version : 1.0
+*   Description : Base for Lock-Free Single-Producer Single-Consumer Event Ring
+*   Author : JinHui Han
+*   History : 
+*          Name            Date                    Remarks
+*       JinHui Han      05-09-2005      Created Initial Version 1.0
+*       JinHui Han      05-09-2005      Verified Version 1.0
+***************************************************************************************/
+
+#ifndef _ERING_H
+#define _ERING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef  EXTERN_GLOBALS
+    #define ERING_EXT
+#else
+    #define ERING_EXT      extern
+#endif
+
+/***************************************************************************************
+*   Lock-Free Event Ring.
+*
+*   This Structure Describes the Single-Producer Single-Consumer Event Ring, which is 
+*   Used for Posting the Event from the ISR (or the Producer Thread of Host Port) to 
+*   the Active Object Manager without Locking the Interrupts. 
+*
+*   The Producer Writes Only "head", and the Consumer Writes Only "tail", so the 
+*   Post and Get Operations need not the Critical Section, the Cost of ering_post() 
+*   is Bounded by One Load, One Store and One Release-Store. 
+*
+*   NOTE: 
+*   (1) Each Ring Must have Exactly One Producer. If Several ISRs with Different 
+*       Priority (which can Preempt Each Other) Post Events, Each of them Must Own 
+*       Its Ring. 
+*   (2) The Length of the Ring Buffer Must be the Power of 2. 
+***************************************************************************************/
+typedef struct ering_tag { 
+    /*  Pointer to the Start of the Ring Buffer */
+    event_t ** ring;
+    /*  Total Number of Events in the Ring Buffer, Minus 1 (Mask of Index) */
+    uint16_t   mask;
+    /*  Free Running Offset where Next Event will be Inserted, Written by Producer */
+    uint16_t volatile head;
+    /*  Free Running Offset where Next Event will be Extracted, Written by Consumer */
+    uint16_t volatile tail;
+    /*  Number of Events Lost because the Ring is Full, Written by Producer */
+    uint16_t   lost_cnt;
+    /*  Maximum Number of Events Ever Present in the Ring Buffer, Written by Consumer */
+    uint16_t   max_cnt;
+} ering_t;
+
+/***************************************************************************************
+*   Ordered Access of the Offset Shared by Producer and Consumer. 
+*
+*   On the Single Core MCU the ISR can not be Interleaved with the Consumer, only the 
+*   Compiler must not Reorder the Access. On the Multi-Core Host the Acquire/Release 
+*   Ordering is Required. 
+***************************************************************************************/
+#if defined(__GNUC__)
+    #define ERING_LOAD_(ptr_)           __atomic_load_n((ptr_), __ATOMIC_ACQUIRE)
+    #define ERING_STORE_(ptr_, val_)    __atomic_store_n((ptr_), (val_), __ATOMIC_RELEASE)
+#else
+    #define ERING_LOAD_(ptr_)           (*(ptr_))
+    #define ERING_STORE_(ptr_, val_)    (*(ptr_) = (val_))
+#endif
+
+/***************************************************************************************
+*   Initializes the Event Ring
+*
+*   Description: Initializes the Lock-Free Event Ring. 
+*   Argument: me -- Pointer the ering_t Struct to be Initialized. 
+*             ring_buffer[] -- The Ring Buffer Storage. 
+*             ring_len -- The Length of the Ring Buffer in the Units of Event Pointer, 
+*                         Must be the Power of 2. 
+*   Return: 1 is True, 0 is False, -1 is Failure
+*
+*   NOTE: 
+*   (1) Must be Called before the Producer is Enabled. 
+***************************************************************************************/
+ERING_EXT int16_t ering_init(ering_t *me, event_t *ring_buffer[], uint16_t ring_len);
+
+/***************************************************************************************
+*   Post Event into the Event Ring. 
+*
+*   Description: Post Event into the Event Ring without Locking the Interrupts. 
+*   Argument: me -- Pointer the ering_t Struct to be Post Into. 
+*             event -- The Event to be Posting. 
+*   Return: 1 is True, 0 is False (the Ring is Full), -1 is Failure
+*
+*   NOTE: 
+*   (1) Called by the Only Producer of the Ring (ISR or Producer Thread). 
+*   (2) When the Ring is Full the Event is not Posted, "lost_cnt" is Increased and 
+*       FALSE is Returned, the Producer should Release the Event. 
+***************************************************************************************/
+ERING_EXT int16_t ering_post(ering_t *me, event_t *event);
+
+/***************************************************************************************
+*   Get Event from the Event Ring. 
+*
+*   Description: Get Event from the Event Ring without Locking the Interrupts. 
+*   Argument: me -- Pointer the ering_t Struct which Event is Get from. 
+*   Return: The Pointer to Event, or else Return NULL if the Ring is Empty. 
+*
+*   NOTE: 
+*   (1) Called by the Only Consumer of the Ring. 
+***************************************************************************************/
+ERING_EXT event_t *ering_get(ering_t *me);
+
+/***************************************************************************************
+*   Drain the Event Ring into the Priority-Based Event Chain. 
+*
+*   Description: Move at Most "batch" Events from the Event Ring into the Event Chain. 
+*   Argument: me -- Pointer the ering_t Struct to be Drained. 
+*             chain -- The Priority-Based Event Chain which Receives the Events. 
+*             batch -- The Maximum Number of Events Moved by this Call. 
+*   Return: The Number of Events Moved, or -1 is Failure. 
+*
+*   NOTE: 
+*   (1) Called by the Only Consumer of the Ring. 
+*   (2) The "head" is Loaded Once and the "tail" is Stored Once per Call. 
+***************************************************************************************/
+ERING_EXT int16_t ering_drain(ering_t *me, echain_t *chain, uint16_t batch);
+
+/***************************************************************************************
+*   Get the Margin of the Event Ring.
+*
+*   Description: Get the Margin of the Event Ring. 
+*   Argument: me -- Pointer the ering_t Struct which Margin is Get from. 
+*   Return: The Margin of the Event Ring. 
+*
+*   NOTE: 
+*   (1) The Margin is the Minimal Number of Free Locations Encountered in the Event 
+*       Ring since System Startup, Seen by the Consumer. 
+***************************************************************************************/
+ERING_EXT uint16_t ering_margin(ering_t *me); 
+
+/***************************************************************************************
+*   The Macro Evaluates to TRUE if the Event Ring "me_" is Empty
+***************************************************************************************/
+#define ering_is_empty(me_)     (((ering_t *)(me_))->head == ((ering_t *)(me_))->tail)
+
+#ifdef SPYER_ERING_ENABLE   /* Spy Debuger Enabled */
+    #define SPYER_ERING(format, ...)   \
+        spyer_ch_(SPYER_CH_ERING, (const int8_t *)format, ##__VA_ARGS__)
+#else                       /* Spy Debuger Disabled */
+    #define SPYER_ERING(format, ...)   ((void_t)0)
+#endif  /* End of SPYER_ERING_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif      /* End of _ERING_H */
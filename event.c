@@ -60,7 +60,7 @@ int16_t event_is_external(event_t *event)
         return FAILURE; 
     }
 
-    return event->dynamic_ == 0: FALSE, TRUE; 
+    return (event->dynamic_ == 0) ? FALSE : TRUE; 
 }
 
 /***************************************************************************************
@@ -73,7 +73,7 @@ int16_t event_is_end(event_t *event)
         return FAILURE; 
     }
 
-    return event->dynamic_ == 0: TRUE, FALSE; 
+    return (event->dynamic_ == 0) ? TRUE : FALSE; 
 }
 
 /***************************************************************************************
@@ -92,5 +92,8 @@ int16_t event_init(event_t *event, signal_t signal, uint16_t priority, uint16_t
     event->record    = (void_t *)0; 
     event->dynamic_  = (int16_t)0; 
     event->static_   = (int16_t)1;  /* 1 = Static Allocate */
+#ifdef ECHAIN_INTRUSIVE_ENABLE
+    event->link_.builtin = (void_t *)0;   /* The Embedded Chain Cell is Free */
+#endif  /* End of ECHAIN_INTRUSIVE_ENABLE */
     return TRUE; 
 }
\ No newline at end of file
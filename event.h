@@ -59,11 +59,23 @@ extern "C" {
 ***************************************************************************************/
 typedef uint16_t  signal_t;     /* Signal of the Event */
 
+/***************************************************************************************
+*   Chain List Struct.
+*
+*   The Cell of Bidirectional List, Allocated from the Chain Pool (cpool), or 
+*   Embedded in the Event when ECHAIN_INTRUSIVE_ENABLE is Defined. 
+***************************************************************************************/
+typedef struct chain_tag {
+    struct chain_tag *next;    /* Next     Location of Chain List */
+    struct chain_tag *fore;    /* Previous Location of Chain List */
+    void_t *builtin;           /* Built-In Object */
+}chain_t;
+
 /***************************************************************************************
 *   Signal Internal Constants
 ***************************************************************************************/
 enum {
-    SIG_EMPTY_ = 0;   /* Empty Signal for Internal Use Only */
+    SIG_EMPTY_ = 0    /* Empty Signal for Internal Use Only */
 };
 
 /***************************************************************************************
@@ -106,8 +118,50 @@ typedef struct event_tag {
                                 /* Associated with "record", You MUST Do it by yourself */
     int16_t   dynamic_;         /* Dynamic Attributes of the Event (0 for Static), Internal Use Only */
     int16_t   static_;          /* Static Allocate Flag, 1 is Static, 0 is Dynamic */
+#ifdef ECHAIN_INTRUSIVE_ENABLE
+    chain_t   link_;            /* Embedded Event Chain Cell, Internal Use Only */
+                                /* link_.builtin is NULL when the Cell is Free */
+#endif  /* End of ECHAIN_INTRUSIVE_ENABLE */
+#ifdef ACTIVE_PROFILE_ENABLE
+    uint32_t  stamp_;           /* Cycle Counter when Posted into the Event Chain, */
+                                /* Internal Use Only */
+#endif  /* End of ACTIVE_PROFILE_ENABLE */
 } event_t;
 
+/***************************************************************************************
+*   Inline Payload of Event. 
+*
+*   The Dynamic Event may Carry Its Data Inline, in the Same Block of Event Pool 
+*   after the Header, Instead of the External Block Pointed by "record": 
+*       +-----------+---------+------------------+
+*       |  event_t  | Padding |  Inline Payload  |
+*       +-----------+---------+------------------+
+*       |<- EVENT_PAYLOAD_OFFSET ->|
+*   The Payload is Recycled Together with the Event, so One Allocation and One 
+*   Release Serve Both. The Event Pool is Sized by EPOOL_BLOCK_SIZE(), and the Event 
+*   is Allocated by epool_new_payload(), which Points "record" to the Payload, so 
+*   the Handlers Reading "record" Work Unchanged. 
+*
+*   NOTE: (1) The Derivation from event_t ("super" as the First Member) is Still 
+*             the Way for the Typed Parameters, the Inline Payload is for the Data 
+*             whose Size is Known Only at Run Time. 
+***************************************************************************************/
+#ifndef EVENT_PAYLOAD_ALIGN
+    /***********************************************************************************
+    *   This Constant Defines the Alignment of the Inline Payload in Bytes, which Must 
+    *   Suit Any Type Stored in the Payload. 
+    ***********************************************************************************/
+    #define EVENT_PAYLOAD_ALIGN     8       /* Default is 8 */
+#endif      /* End of EVENT_PAYLOAD_ALIGN */
+
+/* Offset of the Inline Payload from the Start of Event */
+#define EVENT_PAYLOAD_OFFSET    \
+        ((sizeof(event_t) + (EVENT_PAYLOAD_ALIGN - 1)) / EVENT_PAYLOAD_ALIGN * EVENT_PAYLOAD_ALIGN)
+
+/* Pointer to the Inline Payload of the Event "event_" */
+#define event_payload(event_)   \
+        ((void_t *)((uint8_t *)(event_) + EVENT_PAYLOAD_OFFSET))
+
 /***************************************************************************************
 *   Query whether the External Event or Not. 
 *
@@ -0,0 +1,138 @@
+/***************************************************************************************
+*   The MIT License (MIT)
+*   Copyright (C) 2005 JinHui Han, <Email: ferrethan485@sohu.com, QQ: 1901589440>
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in
+*   all copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+*   THE SOFTWARE.
+***************************************************************************************/
+
+
+/***************************************************************************************
+*   Component : Active Object Application FrameWork
+*   Group : Active Object Manager
+*   File Name : executor.h
+*   Version : 1.0
+*   Description : Multi-Core Executor of Active Objects for POSIX_HOST Port
+*   Author : JinHui Han
+*   History : 
+*          Name            Date                    Remarks
+*       JinHui Han      05-18-2005      Created Initial Version 1.0
+*       JinHui Han      05-18-2005      Verified Version 1.0
+***************************************************************************************/
+
+#ifndef _EXECUTOR_H
+#define _EXECUTOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef  EXTERN_GLOBALS
+    #define EXECUTOR_EXT
+#else
+    #define EXECUTOR_EXT    extern
+#endif
+
+#ifdef MANAGER_EXECUTOR_ENABLE
+
+    #ifndef POSIX_HOST
+        #error "MANAGER_EXECUTOR_ENABLE Requires POSIX_HOST"
+    #endif
+    #ifndef MANAGER_READY_SET_ENABLE
+        #error "MANAGER_EXECUTOR_ENABLE Requires MANAGER_READY_SET_ENABLE"
+    #endif
+
+    #ifndef EXECUTOR_WORKERS
+        /*******************************************************************************
+        *   This Constant Defines the Number of Worker Threads, from 1 to 32. 
+        *******************************************************************************/
+        #define EXECUTOR_WORKERS    4       /* Default is 4 */
+    #endif      /* End of EXECUTOR_WORKERS */
+
+    #if (EXECUTOR_WORKERS < 1) || (EXECUTOR_WORKERS > 32)
+        #error "EXECUTOR_WORKERS Must be from 1 to 32"
+    #endif
+
+/***************************************************************************************
+*   State of Active Object in the Executor, Kept in active_t.exec_. 
+***************************************************************************************/
+#define EXECUTOR_IDLE       ((uint8_t)0)    /* Not in Any Run Queue, not Running */
+#define EXECUTOR_QUEUED     ((uint8_t)1)    /* In the Run Queue of a Worker */
+#define EXECUTOR_RUNNING    ((uint8_t)2)    /* Running by a Worker */
+
+/***************************************************************************************
+*   Multi-Core Executor of Active Objects. 
+*
+*   The Manager Thread Still Drains the Event Chain of Manager and Publishes the 
+*   Events, but the Active Objects Marked Ready are Run by EXECUTOR_WORKERS Threads 
+*   Instead of the Manager: 
+*   (1) Each Worker Owns a Run Queue of Active Objects. A Ready Active Object is 
+*       Queued to the Worker (slot % EXECUTOR_WORKERS), so It Stays on the Same 
+*       Worker (and the Same Cache) while the Load is Even. 
+*   (2) A Worker with the Empty Run Queue Steals the Newest Active Object from the 
+*       Queues of the Other Workers. The Sleeping Workers are Woken when a Busy 
+*       Worker Receives the Work. 
+*   (3) An Active Object is Queued or Run by at Most One Worker at a Time, so the 
+*       Run-to-Completion Step is Kept, and the Events of Each Active Object are 
+*       Still Dispatched in the Priority Order of Its Event Chain. The Worker Queues 
+*       the Active Object Again after run() while Its Event Chain is not Empty. 
+*   (4) The Run Queues and the States of Active Objects are Guarded by the Interrupt 
+*       Lock, which is the Mutex of Process on Host, as the Pools, the Event Chains 
+*       and the Subscriber Tables are. 
+*
+*   NOTE: 
+*   (1) The Active Objects may Run Concurrently, the Data Shared between Them 
+*       Outside the Events Must be Guarded by the Application. 
+*   (2) There is no Priority between the Active Objects on Different Workers. 
+*   (3) The Trace Flag of the Spyer Filter is Applied to the Whole Process, so the 
+*       Records of Other Workers may Pass the Filter while a Traced Object Runs. 
+***************************************************************************************/
+
+/***************************************************************************************
+*   Initialize the Executor.
+*
+*   Description: Create the Worker Threads, which Sleep until the Active Objects 
+*                are Ready. 
+*   Argument: none
+*   Return:  1 is True, 0 is False, -1 is Failure 
+*
+*   NOTE: 
+*   (1) Called by man_init(). 
+***************************************************************************************/
+EXECUTOR_EXT int16_t executor_init(void_t); 
+
+/***************************************************************************************
+*   Mark the Active Object Ready.
+*
+*   Description: Queue the Active Object to Its Worker, Unless It is Queued or 
+*                Running Already. 
+*   Argument: active -- The Pointer of Active Object. 
+*   Return:  1 is True (Queued), 0 is False (Queued or Running Already), -1 is Failure 
+*
+*   NOTE: 
+*   (1) Called with the Interrupts Locked, by man_publish() and the Scan Scheduler. 
+***************************************************************************************/
+EXECUTOR_EXT int16_t executor_ready(active_t *active); 
+
+#endif  /* End of MANAGER_EXECUTOR_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif      /* End of _EXECUTOR_H */
@@ -39,10 +39,13 @@
 #include "config.h"
 #include "system.h"
 #include "lock.h"
+#include "assert.h"
 
 #define  EXTERN_GLOBALS
 #include "fault.h"
 
+ASSERT_THIS_FILE(fault.c)
+
 /***************************************************************************************
 *   fault_() Implementation.
 ***************************************************************************************/
@@ -91,7 +94,7 @@ int16_t fault_init(void_t)
     fault.head  = 0; 
     fault.tail  = 0; 
 #endif      /* End of FAULT_ENABLE */
-    return TRUE
+    return TRUE; 
 }
 
 /***************************************************************************************
@@ -43,12 +43,15 @@
 #include "spyer.h"
 #include "ticks.h"
 #include "fault.h"
+#include "mpool.h"
+#include "event.h"
 
 #define  EXTERN_GLOBALS
 #include "fsm.h"
 
 ASSERT_THIS_FILE(fsm.c)
 FAULT_THIS_FILE(fsm.c)
+SPYER_THIS_FILE(7)
 
 /***************************************************************************************
 *   fsm_get_version() Implementation.
@@ -71,7 +74,7 @@ int16_t fsm_destroyer (fsm_t *me)
     /* For the Basal FSM, it is NOP Operation. */
     me->status_ = FSM_IDLE; 
 
-    SPYER_FSM("FSM[%X] is Destroyed, Curr %d, Dest %d. TimeStamp %d", \\
+    SPYER_FSM("FSM[%X] is Destroyed, Curr %d, Dest %d. TimeStamp %d", \
                me, me->curr_state, me->dest_state, ticks_get()); 
     return TRUE; 
 }
@@ -88,7 +91,7 @@ int16_t fsm_constructor (fsm_t *me)
     /* For the Basal FSM, it is NOP Operation */
     me->status_ = FSM_CONSTRUCT; 
 
-    SPYER_FSM("FSM[%X] is Construct, Curr %d, Dest %d. TimeStamp %d", \\
+    SPYER_FSM("FSM[%X] is Construct, Curr %d, Dest %d. TimeStamp %d", \
                me, me->curr_state, me->dest_state, ticks_get()); 
     return TRUE; 
 }
@@ -116,7 +119,7 @@ int16_t fsm_initializer (fsm_t *me)
     me->is_idle     = me->is_idle;      /* NOP Operation */
     me->is_final    = fsm_is_final; 
 
-    SPYER_FSM("FSM[%X] is Initialized, Curr %d, Dest %d. TimeStamp %d", \\
+    SPYER_FSM("FSM[%X] is Initialized, Curr %d, Dest %d. TimeStamp %d", \
                me, me->curr_state, me->dest_state, ticks_get()); 
     return TRUE; 
 }
@@ -132,12 +135,12 @@ int16_t fsm_entry(fsm_t *me)
 
     /* At this Point, The Current State has been Set */
     ret = TRUE; 
-    if (me->curr_state->enter != (fsm_function_t *)0) { 
+    if (me->curr_state->enter != (fsm_function_t)0) { 
         ret = (*(me->curr_state->enter))(me); 
     } 
     ASSERT_ENSURE(ret == TRUE); 
     /* Enter Action Handled */
-    SPYER_FSM("FSM[%X], State[%s] is Entered. TimeStamp %d", \\
+    SPYER_FSM("FSM[%X], State[%s] is Entered. TimeStamp %d", \
                me, me->curr_state->name, ticks_get()); 
     return ret; 
 }
@@ -152,18 +155,13 @@ int16_t fsm_exit(fsm_t *me)
     ASSERT_REQUIRE(me != (fsm_t *)0);
 
     ret = TRUE; 
-    if (me->curr_state->quit != (fsm_function_t *)0) { 
+    if (me->curr_state->quit != (fsm_function_t)0) { 
         ret = (*(me->curr_state->quit))(me); 
     } 
     ASSERT_ENSURE(ret == TRUE); 
     /* Exit Action Handled */
-    SPYER_FSM("FSM[%X], State[%s] is Exited, Super[%s]. TimeStamp %d", \\
-               me, me->curr_state->name, me->curr_state->top->name, ticks_get()); 
-    me->curr_state = me->curr_state->top;   /* Points to Superstate */
-    ASSERT_REQUIRE(me->curr_state != (fsm_state_t *)0); 
-    if (me->curr_state == (fsm_state_t *)0) { 
-        return FAILURE; 
-    } 
+    SPYER_FSM("FSM[%X], State[%s] is Exited. TimeStamp %d", \
+               me, me->curr_state->name, ticks_get()); 
     return ret; 
 }
 
@@ -184,18 +182,15 @@ int16_t fsm_init_trans(fsm_t *me)
 
     /* Set the Work Status */
     me->status_  = FSM_INIT_TRANS;
-    /* Drill into the Target... */
-    if (me->curr_state->down != (fsm_state_t *)0) { 
-        me->curr_state = me->curr_state->down; 
-        ret = fsm_entry(me);
-        if (ret != TRUE) { 
-            return ret; 
-        } 
+    /* Enter the Initial State, No Hierarchy to Drill into */
+    ret = fsm_entry(me);
+    if (ret != TRUE) { 
+        return ret; 
     } 
     /* Set the Work Status */
     me->status_ = FSM_DISPATCH;
 
-    SPYER_FSM("Initial Transition is Done, FSM[%X], Curr[%s]. TimeStamp %d", \\
+    SPYER_FSM("Initial Transition is Done, FSM[%X], Curr[%s]. TimeStamp %d", \
                 me, me->curr_state->name, ticks_get()); 
     return ret; 
 }
@@ -211,10 +206,10 @@ fsm_reaction_t * fsm_find (fsm_t *me, signal_t signal)
     ASSERT_REQUIRE(me != (fsm_t *)0);
 
     /* Search for Real Action */
-    reaction = me->work_state->reaction; 
+    reaction = me->curr_state->reaction; 
     if (reaction != (fsm_reaction_t *)0) { 
-        ASSERT_REQUIRE(me->work_state->rtotal > (int16_t)0);
-        for (index = 0; index < me->work_state->rtotal; index++) { 
+        ASSERT_REQUIRE(me->curr_state->rtotal > (int16_t)0);
+        for (index = 0; index < me->curr_state->rtotal; index++) { 
             if (reaction[index].signal == signal) { 
 
                 SPYER_FSM("Signal[%d]'s Reaction[%X] is Find. TimeStamp %d", 
@@ -279,21 +274,21 @@ int16_t fsm_dispatch(fsm_t *me, event_t *event)
     if((me == (fsm_t *)0) || (event == (event_t *)0)) { 
         return FAILURE; 
     }
-    ASSERT_REQUIRE(me->current_state != (hsm_state_t *)0); 
-    if (me->current_state == (hsm_state_t *)0) { 
+    ASSERT_REQUIRE(me->curr_state != (fsm_state_t *)0); 
+    if (me->curr_state == (fsm_state_t *)0) { 
         return FAILURE; 
     } 
 
     /* State Machine is Running ? */
-    if (me->current_state->top == (hsm_state_t *)0) { 
-        /* The State Machine is in Final State */
+    if (me->curr_state->reaction == (fsm_reaction_t *)0) { 
+        /* The State Machine is in Final State (No Reaction to Leave it) */
         return TRUE; 
     } 
     /* Make Sure that a Transition will be Noticed */
     me->dest_state = (fsm_state_t *)0; 
 
     /***********************************************************************************
-    *   Process the Event Hierarchically... 
+    *   Process the Event in Current State... 
     ***********************************************************************************/
     /* Find the Reaction */
     reaction = fsm_find (me, event->signal); 
@@ -312,29 +307,30 @@ int16_t fsm_dispatch(fsm_t *me, event_t *event)
     /* Set the Target State */
     me->dest_state = reaction->target; 
     me->external   = reaction->external; 
+    if (me->dest_state == (fsm_state_t *)0) { 
+        /* No Target, Stay in Current State */
+        me->dest_state = me->curr_state; 
+    } 
     /***********************************************************************************
     *   Process the State Transition... 
     ***********************************************************************************/
     /* Do the Transitions */
-    /* Target is Itself of Source, or Source is the Ancestor of Target */
-    if ((me->dest_state != me->current_state) || (me->external == (int16_t)1)) { 
+    /* Target is Other State, or Self-Transition is External */
+    if ((me->dest_state != me->curr_state) || (me->external == (int16_t)1)) { 
         /* Self-Transition or External Transition */
         ret = fsm_exit(me);  
         if (ret != TRUE) { 
             return ret; 
         } 
-        if (me->dest_state->top != (hsm_state_t *)0) {  /* Target to Topmost State ? */
-            /* Not Target to Topmost State */ 
-            me->current_state = me->dest_state; 
-            ret = fsm_entry(me);
-            if (ret != TRUE) { 
-                return ret; 
-            } 
+        me->curr_state = me->dest_state; 
+        ret = fsm_entry(me);
+        if (ret != TRUE) { 
+            return ret; 
         } 
     }
     /* At this Point, curr_state == dest_state */
-    ASSERT_ENSURE(me->current_state == me->dest_state); 
-    if (me->current_state != me->dest_state) { 
+    ASSERT_ENSURE(me->curr_state == me->dest_state); 
+    if (me->curr_state != me->dest_state) { 
         return FAILURE; 
     } 
 
@@ -353,8 +349,6 @@ int16_t fsm_dispatch(fsm_t *me, event_t *event)
 ***************************************************************************************/
 int16_t fsm_is_in(fsm_t *me, fsm_state_t *state)
 {
-    fsm_state_t *start;
-
     ASSERT_REQUIRE(me != (fsm_t *)0); 
     ASSERT_REQUIRE(state != (fsm_state_t *)0); 
     if (me == (fsm_t *)0) { 
@@ -381,7 +375,7 @@ int16_t fsm_is_final(fsm_t *me)
         return FAILURE; 
     } 
 
-    if (me->current_state->top == (fsm_state_t *)0) { 
+    if (me->curr_state->reaction == (fsm_reaction_t *)0) { 
         /* The State Machine is in Final State */
         return TRUE; 
     } 
@@ -71,7 +71,7 @@ struct fsm_tag;
 /* The Signature of FSM Function  */
 typedef int16_t (*fsm_function_t)(struct fsm_tag *);   /* True = 1, False = 0, Failure = -1 */
 typedef int16_t (*fsm_dispatch_t)(struct fsm_tag *, event_t *);       /* True = 1, False = 0, Failure = -1 */
-typedef int16_t (*fsm_is_in_t)(struct fsm_tag *, fsm_state_tag *);    /* True = 1, False = 0, Failure = -1 */
+typedef int16_t (*fsm_is_in_t)(struct fsm_tag *, struct fsm_state_tag *);    /* True = 1, False = 0, Failure = -1 */
 
 /***************************************************************************************
 *   FSM Reaction Structure.
@@ -176,7 +176,7 @@ typedef struct fsm_tag
     fsm_dispatch_t dispatch;      /* Dispatches an Event to FSM */
     fsm_is_in_t    is_in;         /* Tests a Given State */
     fsm_function_t is_idle;       /* Is in IDLE State, MUST BE IMPLEMENT BY USER */
-    hsm_function_t is_final;      /* Is in FINAL State */
+    fsm_function_t is_final;      /* Is in FINAL State */
 } fsm_t;
 
 /***************************************************************************************
@@ -309,7 +309,8 @@ FSM_EXT int16_t fsm_is_in(fsm_t *me, fsm_state_t *state);
 FSM_EXT int16_t fsm_is_final(fsm_t *me); 
 
 #ifdef SPYER_FSM_ENABLE   /* Spy Debuger Enabled */
-    #define SPYER_FSM(format, ...)   spyer_((const int8_t *)format, ##__VA_ARGS__)
+    #define SPYER_FSM(format, ...)   \
+        spyer_ch_(SPYER_CH_FSM, (const int8_t *)format, ##__VA_ARGS__)
     #define FSM_STATE_NAME(name)    ,"name"
 #else                       /* Spyer Debuger Disabled */
     #define SPYER_FSM(format, ...)   ((void_t)0)
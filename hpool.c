@@ -49,6 +49,7 @@
 
 ASSERT_THIS_FILE(hpool.c)
 FAULT_THIS_FILE(hpool.c)
+SPYER_THIS_FILE(8)
 
 /***************************************************************************************
 *   hpool_index_lookup[] definition.
@@ -80,7 +81,7 @@ uint32_t const ROM_KEYWORDS hpool_size_lookup[32] = {
     256,      512,      1024,     2048,      4096,      8192,      16384,      32768, 
     65536,    131072,   262144,   524288,    1048576,   2097152,   4194304,    8388608, 
     16777216, 33554432, 67108864, 134217728, 268435456, 536870912, 1073741824, 2147483648
-}
+};
 
 /***************************************************************************************
 *   Internal Constant to Limit the Maximum Block Size that User Can Specified.
@@ -92,20 +93,432 @@ uint32_t const ROM_KEYWORDS hpool_size_lookup[32] = {
 ***************************************************************************************/
 hpool_t hpool; 
 
+#ifdef HPOOL_TLSF_ENABLE
+/***************************************************************************************
+*   Internal Constants for Two-Level Segregated Fit (TLSF) Heap.
+***************************************************************************************/
+/* Number of Second Level Lists in Every First Level */
+#define HPOOL_SL_COUNT_     ((uint32_t)1 << HPOOL_TLSF_SLI)
+/* Units of Block Size in Bytes */
+#define HPOOL_ALIGN_        ((uint32_t)(HPOOL_FACTOR * sizeof(void_t *)))
+/* Size of Block Head in Bytes, the Payload Follows It */
+#define HPOOL_HEAD_         ((uint32_t)(size_t)&(((hpool_block_t *)0)->next_free))
+/* Minimum Size of Payload, It must Hold the Links of Free List */
+#define HPOOL_MIN_SIZE_     (((((uint32_t)sizeof(hpool_block_t) - HPOOL_HEAD_) + \
+                              HPOOL_ALIGN_) - (uint32_t)1) / HPOOL_ALIGN_ * HPOOL_ALIGN_)
+/* Free Flag in the Size of Block */
+#define HPOOL_FREE_         ((uint32_t)1)
+
+/***************************************************************************************
+*   The Size of Payload of the Block "block_". 
+***************************************************************************************/
+#define HPOOL_SIZE_(block_)     ((block_)->size & ~HPOOL_FREE_)
+
+/***************************************************************************************
+*   The Physically Next Block of the Block "block_". 
+*
+*   NOTE: For Some Compiler, the Memory Unit of uint8_t is Two Byte, and is Properly
+*         Aligned at Half-Word Boundary. So At Here, Can't Transform the Block into 
+*         (uint8_t *) for Compute the Address.
+***************************************************************************************/
+#define HPOOL_NEXT_PHYS_(block_)    \
+    ((hpool_block_t *)(((size_t)(block_)) + HPOOL_HEAD_ + HPOOL_SIZE_(block_)))
+
+/***************************************************************************************
+*   hpool_msb_() Implementation. Internal
+*
+*   Return: The 0-Based Index of the Most Significant 1-Bit, "value" MUST not be 0. 
+***************************************************************************************/
+static uint8_t hpool_msb_(uint32_t value) 
+{
+    if ((value & (uint32_t)0xFFFF0000) != (uint32_t)0) { 
+        if ((value & (uint32_t)0xFF000000) != (uint32_t)0) { 
+            return (uint8_t)(hpool_index_lookup[value >> 24] + 23); 
+        } 
+        return (uint8_t)(hpool_index_lookup[value >> 16] + 15); 
+    } 
+    if ((value & (uint32_t)0x0000FF00) != (uint32_t)0) { 
+        return (uint8_t)(hpool_index_lookup[value >> 8] + 7); 
+    } 
+    return (uint8_t)(hpool_index_lookup[value] - 1); 
+}
+
+/***************************************************************************************
+*   hpool_lsb_() Implementation. Internal
+*
+*   Return: The 0-Based Index of the Least Significant 1-Bit, "value" MUST not be 0. 
+***************************************************************************************/
+static uint8_t hpool_lsb_(uint32_t value) 
+{
+    /* Isolate the Least Significant 1-Bit */
+    return hpool_msb_(value & (~value + (uint32_t)1)); 
+}
+
+/***************************************************************************************
+*   hpool_mapping_() Implementation. Internal
+*
+*   Map the Size of Payload into the Index of First Level and Second Level. 
+***************************************************************************************/
+static void_t hpool_mapping_(uint32_t size, uint8_t *fl, uint8_t *sl) 
+{
+    uint32_t units; 
+    uint8_t  msb; 
+
+    units = size / HPOOL_ALIGN_; 
+    if (units < HPOOL_SL_COUNT_) { 
+        /* Small Block, Second Level is Linear */
+        *fl = (uint8_t)0; 
+        *sl = (uint8_t)units; 
+    } 
+    else { 
+        msb = hpool_msb_(units); 
+        *fl = (uint8_t)(msb - HPOOL_TLSF_SLI + 1); 
+        *sl = (uint8_t)((units >> (msb - HPOOL_TLSF_SLI)) - HPOOL_SL_COUNT_); 
+    } 
+    if (*fl >= (uint8_t)HPOOL_AMOUNT) { 
+        /* Larger than the Last First Level, Kept in the Last List */
+        *fl = (uint8_t)(HPOOL_AMOUNT - 1); 
+        *sl = (uint8_t)(HPOOL_SL_COUNT_ - (uint32_t)1); 
+    } 
+}
+
+/***************************************************************************************
+*   hpool_insert_() Implementation. Internal
+*
+*   NOTE: Called with Interrupts Locked. The Block is Marked as Free. 
+***************************************************************************************/
+static void_t hpool_insert_(hpool_t *me, hpool_block_t *block) 
+{
+    uint8_t  fl; 
+    uint8_t  sl; 
+
+    hpool_mapping_(HPOOL_SIZE_(block), &fl, &sl); 
+    block->prev_free = (hpool_block_t *)0; 
+    block->next_free = me->free[fl][sl]; 
+    if (block->next_free != (hpool_block_t *)0) { 
+        block->next_free->prev_free = block; 
+    } 
+    me->free[fl][sl] = block; 
+    me->fl_bitmap     |= (uint32_t)1 << fl; 
+    me->sl_bitmap[fl] |= (uint32_t)1 << sl; 
+    block->size |= HPOOL_FREE_; 
+}
+
+/***************************************************************************************
+*   hpool_remove_() Implementation. Internal
+*
+*   NOTE: Called with Interrupts Locked. The Block is Marked as Allocated. 
+***************************************************************************************/
+static void_t hpool_remove_(hpool_t *me, hpool_block_t *block) 
+{
+    uint8_t  fl; 
+    uint8_t  sl; 
+
+    hpool_mapping_(HPOOL_SIZE_(block), &fl, &sl); 
+    if (block->next_free != (hpool_block_t *)0) { 
+        block->next_free->prev_free = block->prev_free; 
+    } 
+    if (block->prev_free != (hpool_block_t *)0) { 
+        block->prev_free->next_free = block->next_free; 
+    } 
+    else { 
+        /* The Head of the List */
+        me->free[fl][sl] = block->next_free; 
+        if (me->free[fl][sl] == (hpool_block_t *)0) { 
+            me->sl_bitmap[fl] &= ~((uint32_t)1 << sl); 
+            if (me->sl_bitmap[fl] == (uint32_t)0) { 
+                me->fl_bitmap &= ~((uint32_t)1 << fl); 
+            } 
+        } 
+    } 
+    block->size &= ~HPOOL_FREE_; 
+}
+
+/***************************************************************************************
+*   hpool_init() Implementation.
+***************************************************************************************/
+int16_t hpool_init(void_t *begin, uint32_t size, uint32_t max_block_size)
+{
+    uint8_t         fl; 
+    uint8_t         sl; 
+    hpool_t       * me; 
+    hpool_block_t * block; 
+    hpool_block_t * sentinel; 
+
+    ASSERT_REQUIRE(begin != (void_t *)0);
+    ASSERT_REQUIRE(((size_t)begin & (SIZE_OF_PTR - 1)) == (size_t)0);
+    if (begin == (void_t *)0) { 
+        return FAILURE; 
+    }
+    if (((size_t)begin & (SIZE_OF_PTR - 1)) != (size_t)0) { 
+        return FAILURE; 
+    }
+    /* Round Down the Size into the Units of Block Size */
+    size = (size / HPOOL_ALIGN_) * HPOOL_ALIGN_; 
+    /* Must Fit One Block and the Sentinel Head */
+    ASSERT_REQUIRE(size >= ((HPOOL_HEAD_ * (uint32_t)2) + HPOOL_MIN_SIZE_)); 
+    if (size < ((HPOOL_HEAD_ * (uint32_t)2) + HPOOL_MIN_SIZE_)) { 
+        return FAILURE; 
+    }
+
+    me = (hpool_t *)&hpool; 
+    /* Inialize the Memory Start and End Address of this Pool */
+    me->start = begin;
+    me->end   = (void_t *)(((size_t)begin) + size);
+    /* Check for Address Wrap-Back Around */
+    ASSERT_REQUIRE(me->end > me->start);
+    if (me->end <= me->start) { 
+        return FAILURE; 
+    } 
+
+    /* Clear the Bitmaps and the Free Lists */
+    me->fl_bitmap = (uint32_t)0; 
+    for (fl = (uint8_t)0; fl < (uint8_t)HPOOL_AMOUNT; ++fl) { 
+        me->sl_bitmap[fl] = (uint32_t)0; 
+        for (sl = (uint8_t)0; sl < (uint8_t)HPOOL_SL_COUNT_; ++sl) { 
+            me->free[fl][sl] = (hpool_block_t *)0; 
+        } 
+    } 
+    me->allocate_cnt  = (uint32_t)0; 
+    me->max_cnt       = (uint32_t)0; 
+    me->allocate_size = (uint32_t)0; 
+    me->max_size      = (uint32_t)0; 
+
+    /* The Whole Buffer is One Free Block */
+    block = (hpool_block_t *)begin; 
+    block->prev_phys = (hpool_block_t *)0; 
+    block->size      = size - (HPOOL_HEAD_ * (uint32_t)2); 
+
+    /* Check the Maximum Block Size Requested */
+    ASSERT_REQUIRE(max_block_size <= HPOOL_SIZE_(block)); 
+    if (max_block_size > HPOOL_SIZE_(block)) { 
+        return FAILURE; 
+    }
+
+    /* The Sentinel at the End is Always Allocated, It Stops the Coalescing */
+    sentinel = HPOOL_NEXT_PHYS_(block); 
+    sentinel->prev_phys = block; 
+    sentinel->size      = (uint32_t)0; 
+
+    hpool_insert_(me, block); 
+
+    SPYER_HPOOL("HPool %X is Initialized, Start %X, Free Size %d.", \
+                 me, block, HPOOL_SIZE_(block)); 
+    return TRUE; 
+}
+
+/***************************************************************************************
+*   hpool_get() Implementation.
+***************************************************************************************/
+void_t *hpool_get(uint32_t block_size)
+{
+    uint32_t        size; 
+    uint32_t        rest_size; 
+    uint32_t        map; 
+    uint8_t         fl; 
+    uint8_t         sl; 
+    hpool_t       * me; 
+    hpool_block_t * block; 
+    hpool_block_t * rest; 
+
+    INT_LOCK_KEY_
+
+    ASSERT_REQUIRE(block_size > (uint32_t)0); 
+    if (block_size == (uint32_t)0) { 
+        return NULL; 
+    }
+
+    me = (hpool_t *)&hpool; 
+
+    /* Round Up the Size into the Units of Block Size */
+    size = (((uint32_t)block_size + HPOOL_ALIGN_) - (uint32_t)1) / HPOOL_ALIGN_ * HPOOL_ALIGN_; 
+    if (size < HPOOL_MIN_SIZE_) { 
+        size = HPOOL_MIN_SIZE_; 
+    } 
+    /* Round Up to the Next List, Every Block in It is Large Enough */
+    map = size / HPOOL_ALIGN_; 
+    if (map >= HPOOL_SL_COUNT_) { 
+        map += ((uint32_t)1 << (hpool_msb_(map) - HPOOL_TLSF_SLI)) - (uint32_t)1; 
+    } 
+    hpool_mapping_(map * HPOOL_ALIGN_, &fl, &sl); 
+
+    INT_LOCK_();
+    /* Search the Suitable List in the Same First Level */
+    map = me->sl_bitmap[fl] & ((~(uint32_t)0) << sl); 
+    if (map == (uint32_t)0) { 
+        /* Search the Larger First Levels */
+        map = (fl < (uint8_t)31) ? (me->fl_bitmap & ((~(uint32_t)0) << (fl + 1))) : (uint32_t)0; 
+        if (map == (uint32_t)0) { 
+            INT_UNLOCK_();
+            SPYER_HPOOL("Get Block Size %d in HPool %X is Failed, Allocated %d. TimeStamp %d", \
+                        block_size, me, me->allocate_size, ticks_get()); 
+            return NULL; 
+        } 
+        fl  = hpool_lsb_(map); 
+        map = me->sl_bitmap[fl]; 
+    } 
+    sl = hpool_lsb_(map); 
+    block = me->free[fl][sl]; 
+    /* The Last List may Hold the Block Smaller than Requested */
+    if (HPOOL_SIZE_(block) < size) { 
+        INT_UNLOCK_();
+        SPYER_HPOOL("Get Block Size %d in HPool %X is Failed, Allocated %d. TimeStamp %d", \
+                    block_size, me, me->allocate_size, ticks_get()); 
+        return NULL; 
+    } 
+    hpool_remove_(me, block); 
+
+    /* Split the Remainder into a New Free Block */
+    rest_size = HPOOL_SIZE_(block) - size; 
+    if (rest_size >= (HPOOL_HEAD_ + HPOOL_MIN_SIZE_)) { 
+        block->size = size; 
+        rest = HPOOL_NEXT_PHYS_(block); 
+        rest->prev_phys = block; 
+        rest->size      = rest_size - HPOOL_HEAD_; 
+        HPOOL_NEXT_PHYS_(rest)->prev_phys = rest; 
+        hpool_insert_(me, rest); 
+    } 
+
+    me->allocate_size += HPOOL_HEAD_ + HPOOL_SIZE_(block); 
+    if (me->allocate_size > me->max_size) { 
+        /* Remember the Maximum so far */
+        me->max_size = me->allocate_size; 
+    } 
+    if (++me->allocate_cnt > me->max_cnt) { 
+        /* Remember the Maximum so far */
+        me->max_cnt = me->allocate_cnt; 
+    } 
+    INT_UNLOCK_();
+
+    SPYER_HPOOL("Get Block %X Size %d from HPool %X, Allocated %d, Max %d. TimeStamp %d", \
+                block, HPOOL_SIZE_(block), me, \
+                me->allocate_size, me->max_size, ticks_get()); 
+    /* Return the Payload to the Caller */
+    return (void_t *)(((size_t)block) + HPOOL_HEAD_); 
+}
+
+/***************************************************************************************
+*   hpool_put() Implementation.
+***************************************************************************************/
+int16_t hpool_put(void_t *block)
+{
+    hpool_t       * me; 
+    hpool_block_t * current; 
+    hpool_block_t * neighbour; 
+
+    INT_LOCK_KEY_
+
+    ASSERT_REQUIRE(block != (void_t *)0); 
+    if (block == (void_t *)0) { 
+        return FAILURE; 
+    } 
+
+    me = (hpool_t *)&hpool; 
+
+    ASSERT_REQUIRE((me->start < block) && (block < me->end));    /* Must be in Range */
+    if ((me->start >= block) || (block >= me->end)) { 
+        return FAILURE; 
+    }
+
+    /* Get the Head of the Block */
+    current = (hpool_block_t *)(((size_t)block) - HPOOL_HEAD_); 
+
+    INT_LOCK_();
+    /* The Block must be Allocated */
+    if ((current->size & HPOOL_FREE_) != (uint32_t)0) { 
+        INT_UNLOCK_();
+        ASSERT_ERROR();
+        return FAILURE; 
+    }
+    me->allocate_size -= HPOOL_HEAD_ + HPOOL_SIZE_(current); 
+    --me->allocate_cnt; 
+
+    /* Coalesce with the Physically Next Block */
+    neighbour = HPOOL_NEXT_PHYS_(current); 
+    if ((neighbour->size & HPOOL_FREE_) != (uint32_t)0) { 
+        hpool_remove_(me, neighbour); 
+        current->size += HPOOL_HEAD_ + HPOOL_SIZE_(neighbour); 
+        HPOOL_NEXT_PHYS_(current)->prev_phys = current; 
+    } 
+    /* Coalesce with the Physically Previous Block */
+    neighbour = current->prev_phys; 
+    if ((neighbour != (hpool_block_t *)0) && 
+        ((neighbour->size & HPOOL_FREE_) != (uint32_t)0)) { 
+        hpool_remove_(me, neighbour); 
+        neighbour->size += HPOOL_HEAD_ + HPOOL_SIZE_(current); 
+        HPOOL_NEXT_PHYS_(neighbour)->prev_phys = neighbour; 
+        current = neighbour; 
+    } 
+    hpool_insert_(me, current); 
+    INT_UNLOCK_();
+
+    SPYER_HPOOL("Put Block %X into HPool %X, Free Block %X Size %d, Allocated %d. TimeStamp %d", \
+                block, me, current, HPOOL_SIZE_(current), \
+                me->allocate_size, ticks_get()); 
+    return TRUE; 
+}
+
+#ifdef SPYER_HPOOL_ENABLE /* Spy Debuger Enabled */
+/***************************************************************************************
+*   hpool_snap() Implementation.
+***************************************************************************************/
+int16_t hpool_snap(void_t)
+{
+    hpool_t * me; 
+    uint8_t   fl; 
+    struct {
+        uint32_t fl_bitmap;
+        uint32_t sl_bitmap[HPOOL_AMOUNT];
+        uint32_t allocate_cnt;
+        uint32_t max_cnt;
+        uint32_t allocate_size;
+        uint32_t max_size;
+    } record_snap;
+
+    me = (hpool_t *)&hpool; 
+
+    INT_LOCK_KEY_
+    INT_LOCK_();
+    /* Get the Usage Snap View of Heap, MUST be Operated at one Time */
+    record_snap.fl_bitmap = me->fl_bitmap; 
+    for(fl = (uint8_t)0; fl < (uint8_t)HPOOL_AMOUNT; ++fl) {
+        record_snap.sl_bitmap[fl] = me->sl_bitmap[fl]; 
+    }
+    record_snap.allocate_cnt  = me->allocate_cnt; 
+    record_snap.max_cnt       = me->max_cnt; 
+    record_snap.allocate_size = me->allocate_size; 
+    record_snap.max_size      = me->max_size; 
+    INT_UNLOCK_();
+    /* Spyer it Output */
+    SPYER_HPOOL("Snap HPool %X, Allocated %d Blocks (Max %d), %d Bytes (Max %d). TimeStamp %d", \
+                 me, record_snap.allocate_cnt, record_snap.max_cnt, \
+                 record_snap.allocate_size, record_snap.max_size, ticks_get()); 
+    for(fl = (uint8_t)0; fl < (uint8_t)HPOOL_AMOUNT; ++fl) {
+        if ((record_snap.fl_bitmap & ((uint32_t)1 << fl)) != (uint32_t)0) { 
+            SPYER_HPOOL("Snap First Level %d in HPool %X, Free Lists Bitmap %X. TimeStamp %d", \
+                         fl, me, record_snap.sl_bitmap[fl], ticks_get()); 
+        } 
+    }
+    return TRUE; 
+}
+#endif  /* End of SPYER_HPOOL_ENABLE */
+
+#else
+
 /***************************************************************************************
 *   power() Internal Implementation. Compute the Round Up Power. 
 ***************************************************************************************/
-inline uint32_t power (uint32_t value) 
+static inline uint32_t power (uint32_t value) 
 {
     uint32_t ret; 
 
-    if (value & 0xFFFFFF00 == 0) {
+    if ((value & 0xFFFFFF00) == 0) {
         ret = hpool_index_lookup[value];
     }
-    else if (value & 0xFFFF0000 == 0) { 
+    else if ((value & 0xFFFF0000) == 0) { 
         ret = hpool_index_lookup[value >>  8] +  8;
     }
-    else if (value & 0xFF000000 == 0) { 
+    else if ((value & 0xFF000000) == 0) { 
         ret = hpool_index_lookup[value >> 16] + 16;
     }
     else {
@@ -124,12 +537,12 @@ int16_t hpool_init(void_t *begin, uint32_t size, uint32_t max_block_size)
     hpool_t * me; 
 
     ASSERT_REQUIRE(begin != (void_t *)0);
-    ASSERT_REQUIRE((begin & (sizeof(void_t *) - 1)) == (void_t *)0);
+    ASSERT_REQUIRE(((size_t)begin & (sizeof(void_t *) - 1)) == (size_t)0);
     ASSERT_REQUIRE(size >= HPOOL_FACTOR * sizeof(free_hblock_t *)); 
     if (begin == (void_t *)0) { 
         return FAILURE; 
     }
-    if ((begin & (SIZE_OF_PTR - 1)) != (void_t *)0) { 
+    if (((size_t)begin & (SIZE_OF_PTR - 1)) != (size_t)0) { 
         return FAILURE; 
     }
     if (size < HPOOL_FACTOR * sizeof(free_hblock_t *)) { 
@@ -161,7 +574,7 @@ int16_t hpool_init(void_t *begin, uint32_t size, uint32_t max_block_size)
     *   Aligned at Half-Word Boundary. So At Here, Can't Transform the "begin"
     *   into (uint8_t *) for Compute the End Memory Address.
     ***********************************************************************************/
-    me->end   = (void_t *)(((uint32_t)begin) + size);
+    me->end   = (void_t *)(((size_t)begin) + size);
 
     /* Check for Address Wrap-Back Around */
     ASSERT_REQUIRE(me->end > me->start);
@@ -169,8 +582,8 @@ int16_t hpool_init(void_t *begin, uint32_t size, uint32_t max_block_size)
         return FAILURE; 
     } 
     /* Check for Address Wrap-Back Around on One Times or Many Times */
-    ASSERT_REQUIRE(((uint32_t)me->end - (uint32_t)me->start) == (uint32_t)size); 
-    if (((uint32_t)me->end - (uint32_t)me->start) != (uint32_t)size) { 
+    ASSERT_REQUIRE((uint32_t)((size_t)me->end - (size_t)me->start) == size); 
+    if ((uint32_t)((size_t)me->end - (size_t)me->start) != size) { 
         return FAILURE; 
     } 
 
@@ -229,7 +642,7 @@ int16_t hpool_init(void_t *begin, uint32_t size, uint32_t max_block_size)
                 /* Setup the Next Link   */
                 ((free_hblock_t *)begin)->next = &((free_hblock_t *)begin)[n];
                 /* Advance to Next Block */
-                (free_hblock_t *)begin) = ((free_hblock_t *)begin)->next;
+                begin = (void_t *)((free_hblock_t *)begin)->next;
                 ++me->section[index].total_cnt;
                 size -= (uint32_t)max_block_size;
             }
@@ -242,12 +655,12 @@ int16_t hpool_init(void_t *begin, uint32_t size, uint32_t max_block_size)
             /* Maximum Number of Allocated Blocks ever Present in this Section */
             me->section[index].max_cnt  = (uint32_t)0;
             /* Setup the Memory Space for Next Section */
-            ((free_hblock_t *)begin) = &((free_hblock_t *)begin)[n];
+            begin = (void_t *)&((free_hblock_t *)begin)[n];
 
-            SPYER_HPOOL("HPool %X is Initialized, Section %d, Start %X, Block Size %d, Total %d.", \\ 
-                         me, index, \\ 
-                         me->section[index].free, \\ 
-                         me->section[index].block_size, \\ 
+            SPYER_HPOOL("HPool %X is Initialized, Section %d, Start %X, Block Size %d, Total %d.", \
+                         me, index, \
+                         me->section[index].free, \
+                         me->section[index].block_size, \
                          me->section[index].total_cnt); 
         }
     }
@@ -277,14 +690,14 @@ void_t *hpool_get(uint32_t block_size)
     if (n >= (MAX_BLOCK_SIZE_/(HPOOL_FACTOR * sizeof(free_hblock_t *)))) { 
         return NULL; 
     }
+    me = (hpool_t *)&hpool; 
+
     index = power (n);
     ASSERT_REQUIRE(index <= me->max_index);
     if (index > me->max_index) { 
         return NULL; 
     } 
 
-    me = (hpool_t *)&hpool; 
-
     INT_LOCK_KEY_
     INT_LOCK_();
 
@@ -323,10 +736,10 @@ void_t *hpool_get(uint32_t block_size)
             /* Reduce the Total Number of Blocks */
             --me->section[index].total_cnt;
 
-            SPYER_HPOOL("Move Block %X from Section %d in HPool %X, Total %d, Free %d. TimeStamp %d", \\ 
-                         free_block, index, me, \\ 
-                         me->section[index].total_cnt, \\ 
-                         me->section[index].free_cnt, \\ 
+            SPYER_HPOOL("Move Block %X from Section %d in HPool %X, Total %d, Free %d. TimeStamp %d", \
+                         free_block, index, me, \
+                         me->section[index].total_cnt, \
+                         me->section[index].free_cnt, \
                          ticks_get()); 
 
             for(--index; index >= current; --index) {
@@ -339,10 +752,10 @@ void_t *hpool_get(uint32_t block_size)
                 /* Increase the Total Number of Blocks */
                 ++me->section[index].total_cnt;
 
-                SPYER_HPOOL("Move Block %X to Section %d in HPool %X, Total %d, Free %d. TimeStamp %d", \\ 
-                            free_block, index, me, \\ 
-                            me->section[index].total_cnt, \\ 
-                            me->section[index].free_cnt, \\ 
+                SPYER_HPOOL("Move Block %X to Section %d in HPool %X, Total %d, Free %d. TimeStamp %d", \
+                            free_block, index, me, \
+                            me->section[index].total_cnt, \
+                            me->section[index].free_cnt, \
                             ticks_get()); 
 
                 /***********************************************************************
@@ -351,7 +764,7 @@ void_t *hpool_get(uint32_t block_size)
                 *   the "begin" into (uint8_t *) for Compute the End Memory 
                 *   Address.
                 ***********************************************************************/
-                free_block = (free_hblock_t *)(((uint32_t)free_block) + 
+                free_block = (free_hblock_t *)(((size_t)free_block) + 
                                                me->section[index].block_size);
             }
             /* Increase the Total Number of Blocks */
@@ -376,16 +789,20 @@ void_t *hpool_get(uint32_t block_size)
     *   Index is Correct.
     ***********************************************************************************/
     if ((index != -1) && (free_block != (free_hblock_t *)0)) { 
-        SPYER_HPOOL("Get Block %X from Section %d in HPool %X, Total %d, Free %d, Allocated %d, Max %d. TimeStamp %d", \\ 
-                    free_block, index, me, \\ 
-                    me->section[index].total_cnt, \\ 
-                    me->section[index].free_cnt, \\ 
-                    me->section[index].allocate_cnt, \\ 
-                    me->section[index].max_cnt, \\
+        SPYER_HPOOL("Get Block %X from Section %d in HPool %X, Total %d, Free %d, Allocated %d, Max %d. TimeStamp %d", \
+                    free_block, index, me, \
+                    me->section[index].total_cnt, \
+                    me->section[index].free_cnt, \
+                    me->section[index].allocate_cnt, \
+                    me->section[index].max_cnt, \
                     ticks_get()); 
+    } 
+    else { 
+        return (void_t *)0; 
+    } 
 
     /* Backup the Section that the Block Get from */
-    *((uint32_t *)free_block) = (uint32_t)index;    /* 32 Bits Address */
+    *((uint32_t *)free_block) = (uint32_t)index;    /* In the Pointer Sized Header */
     /* Return the Block or NULL Pointer to the Caller */
     return (void_t *)(++free_block);
 }
@@ -404,7 +821,7 @@ int16_t hpool_put(void_t *block)
     } 
 
     /* Get the Section that the Block Get from */
-    ((uint32_t *)block)--;      /* 32 Bits Address */
+    block = (void_t *)((free_hblock_t *)block - 1); 
     section = (int8_t)(*((uint32_t *)block)); 
 
     me = (hpool_t *)&hpool; 
@@ -415,7 +832,7 @@ int16_t hpool_put(void_t *block)
     }
 
     ASSERT_REQUIRE((me->start <= block) && (block < me->end));    /* Must be in Range */
-    if ((me->start > block) && (block >= me->end)) { 
+    if ((me->start > block) || (block >= me->end)) { 
         return FAILURE; 
     }
 
@@ -423,7 +840,7 @@ int16_t hpool_put(void_t *block)
     INT_LOCK_();
 
     /* Free Blocks must be < total_cnt */
-    if(me->section[section].free_cnt >= me->section[section].total_cnt)) {
+    if(me->section[section].free_cnt >= me->section[section].total_cnt) {
         INT_UNLOCK_();
         ASSERT_ERROR();
         return FAILURE; 
@@ -435,10 +852,10 @@ int16_t hpool_put(void_t *block)
     --me->section[section].allocate_cnt;    /* Reduce the Allocated Number of Blocks */
     INT_UNLOCK_();
 
-    SPYER_HPOOL("Put Block %X into Section %d in HPool %X, Free %d, Allocated %d. TimeStamp %d", \\ 
-                block, section, me, \\ 
-                me->section[section].free_cnt, \\ 
-                me->section[section].allocate_cnt, \\ 
+    SPYER_HPOOL("Put Block %X into Section %d in HPool %X, Free %d, Allocated %d. TimeStamp %d", \
+                block, section, me, \
+                me->section[section].free_cnt, \
+                me->section[section].allocate_cnt, \
                 ticks_get()); 
     return TRUE; 
 }
@@ -470,12 +887,14 @@ int16_t hpool_snap(void_t)
     INT_UNLOCK_();
     /* Spyer it Output */
     for(index = 0; index <= me->max_index; ++index) {
-        SPYER_HPOOL("Snap Section %d in HPool %X (Maximum %d), Block Size %d, Total %d, Max %d. TimeStamp %d", \\ 
-                     index, me, me->max_index, \\ 
-                     record_snap[index].block_size, \\
-                     me->section[index].total_cnt, \\ 
-                     me->section[index].max_cnt, \\ 
+        SPYER_HPOOL("Snap Section %d in HPool %X (Maximum %d), Block Size %d, Total %d, Max %d. TimeStamp %d", \
+                     index, me, me->max_index, \
+                     record_snap[index].block_size, \
+                     me->section[index].total_cnt, \
+                     me->section[index].max_cnt, \
                      ticks_get()); 
     }
 }
 #endif  /* End of SPYER_HPOOL_ENABLE */
+
+#endif  /* End of HPOOL_TLSF_ENABLE */
@@ -47,6 +47,47 @@ extern "C" {
     #define HPOOL_EXT   extern
 #endif
 
+#ifdef HPOOL_TLSF_ENABLE
+/***************************************************************************************
+*   Block for Two-Level Segregated Fit (TLSF) Heap.
+*
+*   Every Block (Free or Allocated) Begins with the Head "prev_phys" and "size", the 
+*   Payload Follows the Head. The Links of Free List Only Exist in the Free Block, 
+*   they Occupy the Payload. 
+*
+*               ----------------------
+*               |     prev_phys      |  Physically Previous Block
+*               |   size | Free Bit  |  Size of Payload in Bytes
+*               ----------------------  <-- Pointer Returned by hpool_get()
+*               |     next_free      |  (Only Used in Free Block)
+*               |     prev_free      |  (Only Used in Free Block)
+*               |     ...  ...       |
+*               ----------------------
+***************************************************************************************/
+typedef struct hpool_block_tag { 
+    struct hpool_block_tag * prev_phys;   /* The Physically Previous Block */
+    uint32_t                 size;        /* Size of Payload, Bit 0 is Free Flag */
+    struct hpool_block_tag * next_free;   /* Next Block in the Free List */
+    struct hpool_block_tag * prev_free;   /* Previous Block in the Free List */
+} hpool_block_t;
+
+#ifndef  HPOOL_TLSF_SLI
+    /***********************************************************************************
+    *   This Constant Define the Log2 of the Number of Second Level Lists in Every 
+    *   First Level (Power of 2 Range). 
+    *
+    *   Default is 3, Every Power of 2 Range is Divided into 8 Lists, so the Internal 
+    *   Fragmentation of a Block is Less than 1/8 of Its Size. 
+    ***********************************************************************************/
+    #define HPOOL_TLSF_SLI  3
+#endif
+
+#if (HPOOL_TLSF_SLI > 5)
+    #error "HPOOL_TLSF_SLI Defined Incorrectly, Expected 0 to 5"
+#endif
+
+#endif  /* End of HPOOL_TLSF_ENABLE */
+
 /***************************************************************************************
 *   Section for Variable Size Block Heap.
 *
@@ -111,6 +152,37 @@ typedef struct hpool_section_tag {
     #error "HPOOL_AMOUNT Defined Incorrectly, Expected 1 to 32"
 #endif
 
+#ifdef HPOOL_TLSF_ENABLE
+/***************************************************************************************
+*   Memory Pool for Variable Size Block Heap, Two-Level Segregated Fit (TLSF). 
+*
+*   The Free Blocks are Kept in (HPOOL_AMOUNT * 2^HPOOL_TLSF_SLI) Segregated Lists. 
+*   The First Level is Indexed by the Power of 2 of the Block Size (in Units of 
+*   HPOOL_FACTOR * sizeof(void_t *)), the Second Level Divides the Power of 2 Range 
+*   Linearly. Two Bitmaps Record the Non-Empty Lists, so a Suitable Free Block is 
+*   Found by Two Bit Searches, and hpool_get() and hpool_put() are O(1). The Block 
+*   is Split on hpool_get() and Coalesced with Its Free Physical Neighbours on 
+*   hpool_put() Immediately, so the Heap does not Fragment into Small Blocks. 
+*
+*   NOTE: HPOOL_AMOUNT is the Number of the First Levels in this Backend. The Free 
+*         Block Larger than the Last First Level is Kept in the Last List. 
+***************************************************************************************/
+typedef struct hpool_tag
+{
+    void_t *  start;      /* Start Address of the Memory Managed by this Memory Pool */
+    void_t *  end;        /* End   Address of the Memory Managed by this Memory Pool */
+    uint32_t  fl_bitmap;  /* Bitmap of Non-Empty First Levels */
+    uint32_t  sl_bitmap[HPOOL_AMOUNT];  /* Bitmap of Non-Empty Lists of Every Level */
+    /* The Heads of Free Lists */
+    hpool_block_t * free[HPOOL_AMOUNT][(uint16_t)1 << HPOOL_TLSF_SLI]; 
+    uint32_t  allocate_cnt;   /* Number of Allocated Blocks Currently */
+    uint32_t  max_cnt;        /* Maximum Number of Allocated Blocks ever Present */
+    uint32_t  allocate_size;  /* Bytes Allocated Currently (Include the Head) */
+    uint32_t  max_size;       /* Maximum Bytes Allocated ever Present */
+} hpool_t;
+
+#else
+
 /***************************************************************************************
 *   Memory Pool for Variable Size Block Heap.
 *
@@ -134,6 +206,8 @@ typedef struct hpool_tag
     hpool_section_t     section[HPOOL_AMOUNT];  /* Subsection Array of Pool */
 } hpool_t;
 
+#endif  /* End of HPOOL_TLSF_ENABLE */
+
 /***************************************************************************************
 *   Structure Representing a Free Block in the Native Memory Pool
 ***************************************************************************************/
@@ -194,6 +268,8 @@ typedef struct free_hblock_tag
 *             Internally.
 *         (5) The "max_block_size" MUST Accord With the Formula:
 *             (max_block_size-1) / (HPOOL_FACTOR * sizeof(free_hblock_t *)) < 32768
+*         (6) With HPOOL_TLSF_ENABLE, the Whole Buffer Becomes One Free Block, and 
+*             "max_block_size" is Only Checked Against It. 
 ***************************************************************************************/
 HPOOL_EXT int16_t hpool_init(void_t *begin, uint32_t size, uint32_t max_block_size);
 
@@ -218,8 +294,10 @@ HPOOL_EXT int16_t hpool_init(void_t *begin, uint32_t size, uint32_t max_block_si
 *   (6) When the Return Value of this Function is NULL, You Must Product one Assert
 *       Error for it, So You Can Detect this Error by Spyer at Debug Case.
 *       To Resolve this Error, Increment the Memory-Space Managed by the Pool.
+*   (7) With HPOOL_TLSF_ENABLE, the Time is Bounded and not Depend on the Number 
+*       or the Size of the Free Blocks. 
 ***************************************************************************************/
-HPOOL_EXT void_t *hpool_get(uint16_t block_size);
+HPOOL_EXT void_t *hpool_get(uint32_t block_size);
 
 /***************************************************************************************
 *   Put a Block Back to a Variable-Size Block Heap.
@@ -237,6 +315,11 @@ HPOOL_EXT void_t *hpool_get(uint16_t block_size);
 *   (4) The hpool_put() Function Uses Internally a Critical Section, so You should
 *       be Careful not to Call it from within a Critical Section when Nesting of
 *       Critical Section is not Supported.
+*   (5) With HPOOL_TLSF_ENABLE, the Block is Merged with Its Free Physical 
+*       Neighbours Immediately, in Bounded Time. 
+*   (6) The Section (or the Size with HPOOL_TLSF_ENABLE) is Kept in the Header of 
+*       Block even with MPOOL_HEADERLESS_ENABLE, the Split Block Moves to the 
+*       Smaller Section, so the Address can not Tell Its Section. 
 ***************************************************************************************/
 HPOOL_EXT int16_t hpool_put(void_t *block);
 
@@ -259,7 +342,8 @@ HPOOL_EXT int16_t hpool_put(void_t *block);
 HPOOL_EXT int16_t hpool_snap(void_t);
 
 #ifdef SPYER_HPOOL_ENABLE   /* Spy Debuger Enabled */
-    #define SPYER_HPOOL(format, ...)   spyer_((const int8_t *)format, ##__VA_ARGS__)
+    #define SPYER_HPOOL(format, ...)   \
+        spyer_ch_(SPYER_CH_HPOOL, (const int8_t *)format, ##__VA_ARGS__)
 #else                       /* Spyer Debuger Disabled */
     #define SPYER_HPOOL(format, ...)   ((void_t)0)
 #endif  /* End of SPYER_HPOOL_ENABLE */
@@ -43,12 +43,25 @@
 #include "spyer.h"
 #include "ticks.h"
 #include "fault.h"
+#include "mpool.h"
+#include "event.h"
 
 #define  EXTERN_GLOBALS
 #include "hsm.h"
 
 ASSERT_THIS_FILE(hsm.c)
 FAULT_THIS_FILE(hsm.c)
+SPYER_THIS_FILE(9)
+
+#ifdef HSM_PATH_ENABLE
+/***************************************************************************************
+*   Storage of Cached Transition Paths, Allocated Once and Never Released. 
+***************************************************************************************/
+static hsm_path_t    hsm_path_pool_[HSM_PATH_AMOUNT];   /* Paths */
+static hsm_state_t * hsm_path_state_[HSM_PATH_STATES];  /* Entry States of Paths */
+static int16_t       hsm_path_used_  = (int16_t)0;      /* Paths Used */
+static int16_t       hsm_state_used_ = (int16_t)0;      /* Entry States Used */
+#endif  /* End of HSM_PATH_ENABLE */
 
 /***************************************************************************************
 *   hsm_get_version() Implementation.
@@ -71,7 +84,7 @@ int16_t hsm_destroyer (hsm_t *me)
     /* For the Basal HSM, it is NOP Operation. */
     me->status_ = HSM_IDLE; 
 
-    SPYER_HSM("HSM[%X] is Destroyed, Curr %d, Dest %d. TimeStamp %d", \\
+    SPYER_HSM("HSM[%X] is Destroyed, Curr %d, Dest %d. TimeStamp %d", \
                me, me->curr_state, me->dest_state, ticks_get()); 
     return TRUE; 
 }
@@ -88,7 +101,7 @@ int16_t hsm_constructor (hsm_t *me)
     /* For the Basal HSM, it is NOP Operation */
     me->status_ = HSM_CONSTRUCT; 
 
-    SPYER_HSM("HSM[%X] is Construct, Curr %d, Dest %d. TimeStamp %d", \\
+    SPYER_HSM("HSM[%X] is Construct, Curr %d, Dest %d. TimeStamp %d", \
                me, me->curr_state, me->dest_state, ticks_get()); 
     return TRUE; 
 }
@@ -112,13 +125,13 @@ int16_t hsm_initializer (hsm_t *me)
     me->destroyer   = me->destroyer;    /* NOP Operation */
     me->initializer = me->initializer;  /* NOP Operation */
     me->init_trans  = hsm_init_trans; 
-    me->dispatch    = hsm_dispatch; 
+    me->dispatch    = (hsm_dispatch_t)hsm_dispatch; 
     me->service     = me->service;      /* NOP Operation */
-    me->is_in       = hsm_is_in; 
+    me->is_in       = (hsm_is_in_t)hsm_is_in; 
     me->is_idle     = me->is_idle;      /* NOP Operation */
     me->is_final    = hsm_is_final; 
 
-    SPYER_HSM("HSM[%X] is Initialized, Curr %d, Dest %d. TimeStamp %d", \\
+    SPYER_HSM("HSM[%X] is Initialized, Curr %d, Dest %d. TimeStamp %d", \
                me, me->curr_state, me->dest_state, ticks_get()); 
     return TRUE; 
 }
@@ -139,7 +152,7 @@ int16_t hsm_entry(hsm_t *me)
     } 
     ASSERT_ENSURE(ret == TRUE); 
     /* Enter Action Handled */
-    SPYER_HSM("HSM[%X], State[%s] is Entered. TimeStamp %d", \\
+    SPYER_HSM("HSM[%X], State[%s] is Entered. TimeStamp %d", \
                me, me->curr_state->name, ticks_get()); 
     return ret; 
 }
@@ -159,7 +172,7 @@ int16_t hsm_exit(hsm_t *me)
     } 
     ASSERT_ENSURE(ret == TRUE); 
     /* Exit Action Handled */
-    SPYER_HSM("HSM[%X], State[%s] is Exited, Super[%s]. TimeStamp %d", \\
+    SPYER_HSM("HSM[%X], State[%s] is Exited, Super[%s]. TimeStamp %d", \
                me, me->curr_state->name, me->curr_state->top->name, ticks_get()); 
     me->curr_state = me->curr_state->top;   /* Points to Superstate */
     ASSERT_REQUIRE(me->curr_state != (hsm_state_t *)0); 
@@ -174,6 +187,8 @@ int16_t hsm_exit(hsm_t *me)
 ***************************************************************************************/
 int16_t hsm_drill_target(hsm_t *me)
 {
+    int16_t ret; 
+
     ASSERT_REQUIRE(me != (hsm_t *)0); 
     ASSERT_REQUIRE(me->curr_state != (hsm_state_t *)0); 
 
@@ -210,11 +225,82 @@ int16_t hsm_init_trans(hsm_t *me)
     /* Set the Work Status */
     me->status_ = HSM_DISPATCH;
 
-    SPYER_HSM("Initial Transition is Done, HSM[%X], Curr[%s]. TimeStamp %d", \\
+    SPYER_HSM("Initial Transition is Done, HSM[%X], Curr[%s]. TimeStamp %d", \
                 me, me->curr_state->name, ticks_get()); 
     return ret; 
 }
 
+#ifdef HSM_PATH_ENABLE
+/***************************************************************************************
+*   Internal Function, hsm_path_replay_()
+*   Replay the Cached Transition Path. 
+***************************************************************************************/
+static int16_t hsm_path_replay_(hsm_t *me, hsm_path_t *path)
+{
+    int16_t  ret; 
+    int16_t  index; 
+
+    for (index = (int16_t)0; index < path->exits; ++index) { 
+        ret = hsm_exit(me);  
+        if (ret != TRUE) { 
+            return ret; 
+        } 
+    } 
+    for (index = (int16_t)0; index < path->entries; ++index) { 
+        me->curr_state = path->entry[index]; 
+        ret = hsm_entry(me);
+        if (ret != TRUE) { 
+            return ret; 
+        } 
+    } 
+    /* At this Point, curr_state == dest_state */
+    ASSERT_ENSURE(me->curr_state == me->dest_state); 
+    if (me->curr_state != me->dest_state) { 
+        return FAILURE; 
+    } 
+    return TRUE; 
+}
+
+/***************************************************************************************
+*   Internal Function, hsm_path_record_()
+*   Record the Transition Path of the Reaction, "stack" Holds the Entry States with 
+*   the Innermost at Bottom. 
+***************************************************************************************/
+static void_t hsm_path_record_(hsm_reaction_t *reaction, int16_t exits, 
+                               hsm_state_t **stack, int16_t depth)
+{
+    int16_t     index; 
+    hsm_path_t *path; 
+
+    INT_LOCK_KEY_
+
+    INT_LOCK_();
+    if ((reaction->path != (hsm_path_t *)0) || 
+        (hsm_path_used_ >= (int16_t)HSM_PATH_AMOUNT) || 
+        ((hsm_state_used_ + depth) > (int16_t)HSM_PATH_STATES)
+       ) { 
+        /* Recorded Already, or No Space, Compute the Path Every Time */
+        INT_UNLOCK_();
+        return; 
+    } 
+    path = &hsm_path_pool_[hsm_path_used_++]; 
+    path->entry = &hsm_path_state_[hsm_state_used_]; 
+    hsm_state_used_ += depth; 
+    INT_UNLOCK_();
+
+    path->exits   = exits; 
+    path->entries = depth; 
+    for (index = (int16_t)0; index < depth; ++index) { 
+        path->entry[index] = stack[depth - index - 1]; 
+    } 
+    /* Publish the Path after It is Completed */
+    reaction->path = path; 
+
+    SPYER_HSM("Reaction[%X]'s Path[%X] is Recorded, Exits %d, Entries %d. TimeStamp %d", \
+               reaction, path, exits, depth, ticks_get()); 
+}
+#endif  /* End of HSM_PATH_ENABLE */
+
 /***************************************************************************************
 *   Internal Function, hsm_transition()
 ***************************************************************************************/
@@ -244,27 +330,42 @@ int16_t hsm_init_trans(hsm_t *me)
 *       and "on exit" Executable Content." 
 *       Self-Transition: The Source Targeted Itself. 
 ***************************************************************************************/
-int16_t hsm_transition(hsm_t *me)
+int16_t hsm_transition(hsm_t *me, hsm_reaction_t *reaction)
 {
     int16_t  ret; 
     hsm_state_t *track;                     /* Track State */ 
     hsm_state_t *stack[HSM_MAX_DEPTH+1];    /* Stack for Transition Entry Path */
     int16_t      index;                     /* Stack Index */
+    int16_t      exits;                     /* Number of Exits */
+#ifdef HSM_PATH_ENABLE
+    int16_t      depth;                     /* Number of Entries */
+#endif  /* End of HSM_PATH_ENABLE */
 
     ASSERT_REQUIRE(me != (hsm_t *)0);
 
+#ifdef HSM_PATH_ENABLE
+    if (reaction->path != (hsm_path_t *)0) { 
+        /* Replay the Cached Path */
+        return hsm_path_replay_(me, reaction->path); 
+    } 
+#else
+    (void_t)reaction;       /* Only the Path Cache Takes the Reaction */
+#endif  /* End of HSM_PATH_ENABLE */
+    exits = (int16_t)0; 
+
     ASSERT_REQUIRE(me->dest_state->depth < HSM_MAX_DEPTH);
     index = (int16_t)0;     /* Clear the Stack Index */
     track = me->dest_state; 
     /* If Source Deep than Target, *exit* Up to the Same Level As Target */
-    while(me->current_state->depth > track->depth) {
+    while(me->curr_state->depth > track->depth) {
         ret = hsm_exit(me);  
         if (ret != TRUE) { 
             return ret; 
         } 
+        ++exits; 
     }
     /* If Target Deep than Source, *record* its Path Up to the Same Level As Source */
-    while(track->depth > me->current_state->depth ) {
+    while(track->depth > me->curr_state->depth ) {
         stack[index++]= track;
         track = track->top;
         ASSERT_REQUIRE(track != (hsm_state_t *)0); 
@@ -273,24 +374,26 @@ int16_t hsm_transition(hsm_t *me)
         } 
     } 
     /* Target is Itself of Source, or Source is the Ancestor of Target */
-    if (track == me->current_state) { 
+    if (track == me->curr_state) { 
         if (me->external) {
             /* Self-Transition or External Transition */
             ret = hsm_exit(me);  
             if (ret != TRUE) { 
                 return ret; 
             } 
+            ++exits; 
             stack[index++]= track; 
             track = track->top;
         } 
     }
     /* Keep Going Up Together till Current and Track have Found Each Other. */
     /* Keep Exiting 'current' as it Goes Up, Keep Stracking 'track' as it Goes Up. */
-    while (me->current_state != track) { 
+    while (me->curr_state != track) { 
         ret = hsm_exit(me);  
         if (ret != TRUE) { 
             return ret; 
         } 
+        ++exits; 
         stack[index++]= track;
         track = track->top;
         ASSERT_REQUIRE(track != (hsm_state_t *)0); 
@@ -300,18 +403,25 @@ int16_t hsm_transition(hsm_t *me)
     }      
     /* <--- NOTE: In UML, Transitions Actions would Take Place Here */
     /* Turtles all the Way Down with Path that we Just Recorded */
+#ifdef HSM_PATH_ENABLE
+    depth = index; 
+#endif  /* End of HSM_PATH_ENABLE */
     while (index > 0) {
-        me->current_state = stack[--index]; 
+        me->curr_state = stack[--index]; 
         ret = hsm_entry(me);
         if (ret != TRUE) { 
             return ret; 
         } 
     }
     /* At this Point, curr_state == dest_state */
-    ASSERT_ENSURE(me->current_state == me->dest_state); 
-    if (me->current_state != me->dest_state) { 
+    ASSERT_ENSURE(me->curr_state == me->dest_state); 
+    if (me->curr_state != me->dest_state) { 
         return FAILURE; 
     } 
+#ifdef HSM_PATH_ENABLE
+    /* Record the Path for Replay */
+    hsm_path_record_(reaction, exits, stack, depth); 
+#endif  /* End of HSM_PATH_ENABLE */
     return TRUE; 
 }
 
@@ -327,7 +437,26 @@ hsm_reaction_t * hsm_find (hsm_t *me, signal_t signal)
 
     ASSERT_REQUIRE(me != (hsm_t *)0);
 
-    me->work_state = me->current_state; 
+#ifdef HSM_INDEX_ENABLE
+    /* Single Lookup in the Dispatch Index */
+    if ((me->curr_state->index != (hsm_index_t *)0) && 
+        (signal < (signal_t)HSM_INDEX_SIGNALS)
+       ) { 
+        reaction = me->curr_state->index[signal].reaction; 
+        if (reaction == (hsm_reaction_t *)0) { 
+            me->work_state = (hsm_state_t *)0; 
+            return (hsm_reaction_t *)0; 
+        } 
+        me->work_state = me->curr_state->index[signal].owner; 
+
+        SPYER_HSM("Signal[%d]'s Reaction[%X] is Find in Index. TimeStamp %d", 
+                   signal, reaction, ticks_get()); 
+
+        return reaction; 
+    } 
+#endif  /* End of HSM_INDEX_ENABLE */
+
+    me->work_state = me->curr_state; 
     /* Recursively Find the Dispatch Entry */
     while(me->work_state != (hsm_state_t *)0) { 
         /* Search for Real Action */
@@ -349,6 +478,60 @@ hsm_reaction_t * hsm_find (hsm_t *me, signal_t signal)
     return (hsm_reaction_t *)0; 
 }
 
+#ifdef HSM_INDEX_ENABLE
+/***************************************************************************************
+*   hsm_build_index() Implementation.
+***************************************************************************************/
+int16_t hsm_build_index(hsm_state_t *state, int16_t total, hsm_index_t *index)
+{
+    int16_t      count; 
+    int16_t      item; 
+    signal_t     signal; 
+    hsm_index_t *entry; 
+    hsm_state_t *owner; 
+    hsm_reaction_t *reaction; 
+
+    ASSERT_REQUIRE(state != (hsm_state_t *)0); 
+    ASSERT_REQUIRE(index != (hsm_index_t *)0); 
+    ASSERT_REQUIRE(total > (int16_t)0); 
+    if ((state == (hsm_state_t *)0) || (index == (hsm_index_t *)0)) { 
+        return FAILURE; 
+    } 
+    if (total <= (int16_t)0) { 
+        return FAILURE; 
+    } 
+
+    for (count = (int16_t)0; count < total; ++count) { 
+        entry = &index[count * HSM_INDEX_SIGNALS]; 
+        for (signal = (signal_t)0; signal < (signal_t)HSM_INDEX_SIGNALS; ++signal) { 
+            entry[signal].reaction = (hsm_reaction_t *)0; 
+            entry[signal].owner    = (hsm_state_t *)0; 
+        } 
+        /* Bubble Up from the State, the Innermost and the First Reaction Wins */
+        owner = &state[count]; 
+        while (owner != (hsm_state_t *)0) { 
+            reaction = owner->reaction; 
+            for (item = (int16_t)0; 
+                 (reaction != (hsm_reaction_t *)0) && (item < owner->rtotal); ++item) { 
+                signal = reaction[item].signal; 
+                if ((signal < (signal_t)HSM_INDEX_SIGNALS) && 
+                    (entry[signal].reaction == (hsm_reaction_t *)0)
+                   ) { 
+                    entry[signal].reaction = (hsm_reaction_t *)&reaction[item]; 
+                    entry[signal].owner    = owner; 
+                } 
+            } 
+            owner = owner->top; 
+        } 
+        state[count].index = entry; 
+
+        SPYER_HSM("State[%s]'s Dispatch Index[%X] is Built. TimeStamp %d", \
+                   state[count].name, entry, ticks_get()); 
+    } 
+    return TRUE; 
+}
+#endif  /* End of HSM_INDEX_ENABLE */
+
 /***************************************************************************************
 *   Internal Function, hsm_guard()
 ***************************************************************************************/
@@ -401,13 +584,13 @@ int16_t hsm_dispatch(hsm_t *me, event_t *event)
     if((me == (hsm_t *)0) || (event == (event_t *)0)) { 
         return FAILURE; 
     }
-    ASSERT_REQUIRE(me->current_state != (hsm_state_t *)0); 
-    if (me->current_state == (hsm_state_t *)0) { 
+    ASSERT_REQUIRE(me->curr_state != (hsm_state_t *)0); 
+    if (me->curr_state == (hsm_state_t *)0) { 
         return FAILURE; 
     } 
 
     /* State Machine is Running ? */
-    if (me->current_state->top == (hsm_state_t *)0) { 
+    if (me->curr_state->top == (hsm_state_t *)0) { 
         /* The State Machine is in Final State */
         return TRUE; 
     } 
@@ -441,7 +624,7 @@ int16_t hsm_dispatch(hsm_t *me, event_t *event)
     /* NOTE: In UML, The External Transitions Actions would Take after "on exit" 
      *       Handlers. 
      */
-    while (me->work_state != me->current_state) { 
+    while (me->work_state != me->curr_state) { 
         hsm_exit(me); 
     } 
     /* Invoke the Event Action */
@@ -454,7 +637,7 @@ int16_t hsm_dispatch(hsm_t *me, event_t *event)
     *   Process the State Transition... 
     ***********************************************************************************/
     /* Do the Transitions */
-    ret = hsm_transition(hsm_t *me); 
+    ret = hsm_transition(me, reaction); 
     ASSERT_ENSURE(ret == TRUE); 
     if ((ret != TRUE)) { 
         return ret; 
@@ -513,7 +696,7 @@ int16_t hsm_is_final(hsm_t *me)
         return FAILURE; 
     } 
 
-    if (me->current_state->top == (hsm_state_t *)0) { 
+    if (me->curr_state->top == (hsm_state_t *)0) { 
         /* The State Machine is in Final State */
         return TRUE; 
     } 
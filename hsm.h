@@ -65,7 +65,7 @@ struct hsm_tag;
 /* The Signature of HSM Function  */
 typedef int16_t (*hsm_function_t)(struct hsm_tag *);    /* True = 1, False = 0, Failure = -1 */
 typedef int16_t (*hsm_dispatch_t)(struct hsm_tag *, event_t const *);       /* True = 1, False = 0, Failure = -1 */
-typedef int16_t (*hsm_is_in_t)(struct hsm_tag *, hsm_state_tag const *);    /* True = 1, False = 0, Failure = -1 */
+typedef int16_t (*hsm_is_in_t)(struct hsm_tag *, struct hsm_state_tag const *);    /* True = 1, False = 0, Failure = -1 */
 typedef event_t *(*hsm_event_t)(struct hsm_tag *);      /* Used by User's Application */
 
 /***************************************************************************************
@@ -83,8 +83,68 @@ typedef struct hsm_reaction_tag {
     hsm_function_t  action;         /* Action Function */
     int16_t         external;       /* Distinguish, 1 = External Transition, 0 = Internal Transition */ 
     struct hsm_state_tag * target;  /* Target State */
+#ifdef HSM_PATH_ENABLE
+    struct hsm_path_tag  * path;    /* Cached Transition Path, Recorded at First Use */
+#endif  /* End of HSM_PATH_ENABLE */
 } hsm_reaction_t; 
 
+#ifdef HSM_PATH_ENABLE
+/***************************************************************************************
+*   HSM Transition Path Structure.
+*
+*   hsm_path_t Represents the Exit and Entry Sequence of the Transition Taken by a 
+*   Reaction. The Transition Starts at the State which Owns the Reaction, so the 
+*   Sequence is Fixed for Every Reaction. It is Recorded by hsm_transition() at 
+*   the First Use, and Replayed Later without Any Depth Comparison or Path Building. 
+***************************************************************************************/
+typedef struct hsm_path_tag { 
+    int16_t                exits;   /* Number of Exits from the Source State */
+    int16_t                entries; /* Number of Entries down to the Target State */
+    struct hsm_state_tag **entry;   /* States to be Entered, Outermost First */
+} hsm_path_t; 
+
+#ifndef HSM_PATH_AMOUNT
+    /***********************************************************************************
+    *   This Constant Defines the Maximum Number of Cached Transition Paths, the 
+    *   Reaction without Cached Path Falls Back to Compute the Path Every Time. 
+    ***********************************************************************************/
+    #define HSM_PATH_AMOUNT     32      /* Default is 32 */
+#endif      /* End of HSM_PATH_AMOUNT */
+
+#ifndef HSM_PATH_STATES
+    /***********************************************************************************
+    *   This Constant Defines the Total Entry States Shared by All Cached Paths. 
+    ***********************************************************************************/
+    #define HSM_PATH_STATES     128     /* Default is 128 */
+#endif      /* End of HSM_PATH_STATES */
+
+#endif  /* End of HSM_PATH_ENABLE */
+
+
+#ifdef HSM_INDEX_ENABLE
+/***************************************************************************************
+*   HSM Dispatch Index Entry.
+*
+*   hsm_index_t Represents the Resolved Reaction of One Signal in One State, that is 
+*   the First Reaction Found when the Signal Bubbles Up from the State, and the 
+*   State (the State Itself or Its Superstate) which Owns the Reaction. 
+***************************************************************************************/
+typedef struct hsm_index_tag { 
+    struct hsm_reaction_tag * reaction;   /* Resolved Reaction, NULL If Not Handled */
+    struct hsm_state_tag    * owner;      /* State which Owns the Reaction */
+} hsm_index_t; 
+
+#ifndef HSM_INDEX_SIGNALS
+    /***********************************************************************************
+    *   This Constant Defines the Number of Entries in the Dispatch Index of Every 
+    *   State, the Signals from 0 to (HSM_INDEX_SIGNALS - 1) are Indexed. The Other 
+    *   Signals are Found by Bubbling Up the Hierarchy. 
+    ***********************************************************************************/
+    #define HSM_INDEX_SIGNALS   64      /* Default is 64 */
+#endif      /* End of HSM_INDEX_SIGNALS */
+
+#endif  /* End of HSM_INDEX_ENABLE */
+
 /***************************************************************************************
 *   HSM State Structure.
 *
@@ -104,6 +164,9 @@ typedef struct hsm_state_tag {
     hsm_reaction_t *reaction;       /* Event Reaction Table  */
     int16_t  rtotal;                /* Total of Items in Event Reaction Table */
     int8_t*  name;                  /* Strings of State Name, Used for Spyer  */
+#ifdef HSM_INDEX_ENABLE
+    hsm_index_t    *index;          /* Dispatch Index, Built by hsm_build_index() */
+#endif  /* End of HSM_INDEX_ENABLE */
 } hsm_state_t; 
 
 /***************************************************************************************
@@ -323,8 +386,36 @@ HSM_EXT int16_t hsm_is_in(hsm_t *me, hsm_state_t *state);
 ***************************************************************************************/
 HSM_EXT int16_t hsm_is_final(hsm_t *me); 
 
+#ifdef HSM_INDEX_ENABLE
+/***************************************************************************************
+*   Description: Builds the Dispatch Index of the States of a HSM. 
+*   Argument: state -- Pointer to the State Table, e.g., &tbl_hsm_calc[0]. 
+*             total -- Total of States in the State Table. 
+*             index -- Storage of the Dispatch Index, It MUST has 
+*                      (total * HSM_INDEX_SIGNALS) Entries. 
+*   Return: 1 is True, 0 is False, -1 is Failure
+*
+*   NOTE: (1) Every State Gets the Entries from 
+*             &index[Position in Table * HSM_INDEX_SIGNALS]. After that, hsm_find() 
+*             Resolves the Signal which is Less than HSM_INDEX_SIGNALS by a Single 
+*             Lookup, Instead of Scanning the Reaction Table of the State and All 
+*             Its Superstates. 
+*         (2) The Index is Shared by All the HSM Instance Using the State Table, 
+*             so It is Built Only ONCE, e.g., in the "Initializer" of the First 
+*             Instance, or Offline as the Constant Table. 
+*         (3) The Size of Storage is 
+*             (total * HSM_INDEX_SIGNALS * sizeof(hsm_index_t)) Bytes. 
+*
+*   The Following Example Illustrates How to Build the Dispatch Index:
+*       static hsm_index_t idx_hsm_calc[CALC_STATES * HSM_INDEX_SIGNALS]; 
+*       hsm_build_index(&tbl_hsm_calc[0], CALC_STATES, &idx_hsm_calc[0]); 
+***************************************************************************************/
+HSM_EXT int16_t hsm_build_index(hsm_state_t *state, int16_t total, hsm_index_t *index); 
+#endif  /* End of HSM_INDEX_ENABLE */
+
 #ifdef SPYER_HSM_ENABLE   /* Spy Debuger Enabled */
-    #define SPYER_HSM(format, ...)   spyer_((const int8_t *)format, ##__VA_ARGS__)
+    #define SPYER_HSM(format, ...)   \
+        spyer_ch_(SPYER_CH_HSM, (const int8_t *)format, ##__VA_ARGS__)
     #define HSM_STATE_NAME(name)    ,"name"
 #else                       /* Spyer Debuger Disabled */
     #define SPYER_HSM(format, ...)   ((void_t)0)
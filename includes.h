@@ -50,11 +50,15 @@ extern "C" {
 #include "spyer.h"
 #include "ticks.h"
 #include "fault.h"
+#include "lookup.h"
+#include "sche.h"
 #include "mpool.h" 
+#include "magazine.h"
 #include "event.h"
 #include "epool.h"
 #include "cpool.h"
 #include "echain.h"
+#include "ering.h"
 #include "rchain.h"
 #include "fsm.h"
 #include "hsm.h"
@@ -62,11 +66,14 @@ extern "C" {
 #include "achain.h"
 #include "callback.h"
 #include "manager.h"
+#include "executor.h"
 #include "activex.h" 
 #include "timer.h"
 #include "hpool.h"
 #include "queue.h"
 #include "uchain.h"
+#include "cycles.h"
+#include "sim.h"
 
 #ifdef __cplusplus
 }
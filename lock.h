@@ -74,6 +74,46 @@ LOCK_EXT  cpu_sr_t interrupt_disable(void_t);
 ***************************************************************************************/
 LOCK_EXT  void_t   interrupt_restore(cpu_sr_t cpu_sr); 
 
+#ifdef POSIX_HOST
+/***************************************************************************************
+*   Enter the Interrupt Context on Host.
+*
+*   Description: Called by the Thread which Plays an Interrupt (the Ticker, or the 
+*                Producer of Test) at the Beginning of Its "ISR". 
+*   Argument: none
+*   Return: The Key which MUST be Passed to interrupt_leave(). 
+*
+*   NOTE: 
+*   (1) Blocks while the Interrupts are Locked by INT_LOCK_(), and before 
+*       interrupt_enable() is Called. 
+***************************************************************************************/
+LOCK_EXT  cpu_sr_t interrupt_enter(void_t); 
+
+/***************************************************************************************
+*   Leave the Interrupt Context on Host.
+*
+*   Description: Called at the End of the "ISR" Entered by interrupt_enter(). 
+*   Argument: cpu_sr -- The Key Returned by interrupt_enter(). 
+*             wake -- TRUE If the "ISR" Posted Events, the Idle Manager is Woken Up. 
+*   Return: none
+***************************************************************************************/
+LOCK_EXT  void_t   interrupt_leave(cpu_sr_t cpu_sr, int16_t wake); 
+
+/***************************************************************************************
+*   Wait for the Interrupt on Host.
+*
+*   Description: Sleep until an "ISR" Leaves with Wake-Up, the Counterpart of the 
+*                Wait-For-Interrupt Instruction. 
+*   Argument: none
+*   Return: none
+*
+*   NOTE: 
+*   (1) Called by on_idle() with the Interrupts Locked Exactly Once, the Lock is 
+*       Released during the Sleep and Held Again on Return. 
+***************************************************************************************/
+LOCK_EXT  void_t   interrupt_wait(void_t); 
+#endif  /* End of POSIX_HOST */
+
 /***************************************************************************************
 *   Interrupt Enable/Disable Control.
 *
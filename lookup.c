@@ -34,6 +34,8 @@
 *       JinHui Han      02-18-2005      Verified Version 1.0
 ***************************************************************************************/
 
+#include "std_type.h"
+#include "std_def.h"
 #include "config.h"
 
 #define  EXTERN_GLOBALS
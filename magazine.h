@@ -0,0 +1,161 @@
+/***************************************************************************************
+*   The MIT License (MIT)
+*   Copyright (C) 2005 JinHui Han, <Email: ferrethan485@sohu.com, QQ: 1901589440>
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in
+*   all copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+*   THE SOFTWARE.
+***************************************************************************************/
+
+
+/***************************************************************************************
+*   Component : Active Object Application FrameWork
+*   Group : Memory Pool
+*   File Name : magazine.h
+*   Version : 1.0
+*   Description : Per-Thread Magazines of Memory Pools for POSIX_HOST Port
+*   Author : JinHui Han
+*   History : 
+*          Name            Date                    Remarks
+*       JinHui Han      05-23-2005      Created Initial Version 1.0
+*       JinHui Han      05-23-2005      Verified Version 1.0
+***************************************************************************************/
+
+#ifndef _MAGAZINE_H
+#define _MAGAZINE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef  EXTERN_GLOBALS
+    #define MAGAZINE_EXT
+#else
+    #define MAGAZINE_EXT    extern
+#endif
+
+#ifdef MPOOL_MAGAZINE_ENABLE
+
+    #ifndef POSIX_HOST
+        #error "MPOOL_MAGAZINE_ENABLE Requires POSIX_HOST"
+    #endif
+
+    #ifndef MAGAZINE_SIZE
+        /*******************************************************************************
+        *   This Constant Defines the Number of Blocks Cached per Pool per Thread, the 
+        *   Half of which is Refilled or Drained in One Batch. 
+        *******************************************************************************/
+        #define MAGAZINE_SIZE   32      /* Default is 32 */
+    #endif      /* End of MAGAZINE_SIZE */
+
+    #ifndef MAGAZINE_POOLS
+        /*******************************************************************************
+        *   This Constant Defines the Number of Pools Cached per Thread, the Thread 
+        *   Uses More Pools Goes to the Pool Directly for the Others. 
+        *******************************************************************************/
+        #define MAGAZINE_POOLS  4       /* Default is 4 */
+    #endif      /* End of MAGAZINE_POOLS */
+
+    #if (MAGAZINE_SIZE < 2)
+        #error "MAGAZINE_SIZE Must be 2 at Least"
+    #endif
+
+/***************************************************************************************
+*   Per-Thread Magazines of Memory Pools. 
+*
+*   Each Thread Keeps a Magazine (a Stack of Free Blocks) for Each Pool It Uses, so 
+*   the Most of magazine_get() and magazine_put() Touch Only the Memory of the Thread: 
+*   (1) magazine_get() Takes from the Magazine, the Empty Magazine is Refilled with 
+*       MAGAZINE_SIZE / 2 Blocks from the Pool in One Critical Section. 
+*   (2) magazine_put() Gives to the Magazine of the Owner Pool of the Block, the Full 
+*       Magazine is Drained to MAGAZINE_SIZE / 2 Blocks in One Critical Section. 
+*   (3) The Cached Blocks were Obtained by mpool_get(), and Keep Their Header, so 
+*       the Block Obtained by One Thread can be Put by Another Thread, or by 
+*       mpool_put() Directly. 
+*   (4) The Magazines of the Thread are Drained when the Thread Exits. 
+*
+*   NOTE: 
+*   (1) The Blocks Cached in the Magazines are not Free in the Pool, so the Pool 
+*       Must be Larger by the Cached Blocks, "max_cached" of the Global Statistics 
+*       Tells How Much. mpool_all_recycled() is True Only after magazine_flush() 
+*       in All the Threads. 
+*   (2) With MPOOL_MAGAZINE_ENABLE, the Event Pools Allocate and Recycle the Events 
+*       through the Magazines. 
+***************************************************************************************/
+
+/***************************************************************************************
+*   Statistics of Magazines, of the Thread or of the Whole Process. 
+***************************************************************************************/
+typedef struct magazine_stat_tag { 
+    uint32_t  cached;       /* Blocks Held in the Magazines Now */
+    uint32_t  max_cached;   /* High-Water Mark of "cached" */
+    uint32_t  refills;      /* Batches Taken from the Pools */
+    uint32_t  drains;       /* Batches Given Back to the Pools */
+    uint32_t  bypass;       /* Calls Passed to the Pool, no Magazine is Free */
+} magazine_stat_t; 
+
+/***************************************************************************************
+*   Obtains a Memory Block through the Magazine.
+*
+*   Description: Obtains a Memory Block of the Pool from the Magazine of the Calling 
+*                Thread, Refill the Magazine from the Pool when It is Empty. 
+*   Argument: me -- Pointer to the mpool_t from which the Block is Requested. 
+*   Return: Returns a Pointer to the Memory Block or NULL if no Free Blocks are 
+*           Available. 
+***************************************************************************************/
+MAGAZINE_EXT void_t *magazine_get(mpool_t *me); 
+
+/***************************************************************************************
+*   Put a Memory Block Back through the Magazine.
+*
+*   Description: Put a Memory Block into the Magazine of the Calling Thread for Its 
+*                Owner Pool, Drain the Magazine to the Pool when It is Full. 
+*   Argument: block -- The Pointer to the Memory Block which will be Put Back. 
+*   Return: 1 is True, 0 is False, -1 is Failure
+***************************************************************************************/
+MAGAZINE_EXT int16_t magazine_put(void_t *block); 
+
+/***************************************************************************************
+*   Drain All the Magazines of the Calling Thread.
+*
+*   Description: Put All the Cached Blocks of the Calling Thread Back to Their Pools. 
+*   Argument: none
+*   Return: none
+***************************************************************************************/
+MAGAZINE_EXT void_t magazine_flush(void_t); 
+
+/***************************************************************************************
+*   Snapshot the Statistics of Magazines. 
+*
+*   Description: Copy the Statistics of the Calling Thread and of the Whole Process. 
+*   Argument: thread -- Receives the Statistics of the Calling Thread, or NULL. 
+*             global -- Receives the Statistics of the Whole Process, or NULL. 
+*   Return: none
+*
+*   NOTE: 
+*   (1) "max_cached" of the Whole Process is the High-Water Mark of the Sum of All 
+*       the Threads, not the Sum of Their High-Water Marks. 
+***************************************************************************************/
+MAGAZINE_EXT void_t magazine_snap(magazine_stat_t *thread, magazine_stat_t *global); 
+
+#endif  /* End of MPOOL_MAGAZINE_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif      /* End of _MAGAZINE_H */
@@ -49,6 +49,7 @@
 #include "epool.h"
 #include "cpool.h"
 #include "echain.h"
+#include "ering.h"
 #include "rchain.h"
 #include "fsm.h"
 #include "hsm.h"
@@ -56,6 +57,8 @@
 #include "achain.h"
 #include "stack.h"
 #include "callback.h"
+#include "lookup.h"
+#include "sche.h"
 #include "manager.h"
 #include "activex.h" 
 #include "timer.h"
@@ -63,6 +66,7 @@
 #include "watchdog.h"
 #include "hpool.h"
 #include "queue.h"
+#include "cycles.h"
 
 /***************************************************************************************
 *   main_() Implementation.
@@ -71,16 +75,20 @@ int32_t main_(void_t)
 {
     /* Initialize the System Hardware */
     system_init(); 
+    /* Initialize the Cycle Counter */
+    cycles_init(); 
     /* Initialize the Failure Logging */
     fault_init();
     /* Initialize the Debug Port */
     debug_init();
+    /* Initialize the Runtime Filter of Spyer */
+    spyer_filter(SPYER_FILTER_DEFAULT); 
     /* Initialize the Ticks, TimeStamp */
     ticks_init(); 
     /* Initialize the Chain Pools */
     cpool_init(); 
     /* Initialize the Manager */
-    man_init(void_t);
+    man_init();
     /* Initialize the Ticker, Ticks and Timer */
     ticker_init(); 
     /* Enable the Interrupt */
@@ -94,4 +102,14 @@ int32_t main_(void_t)
     } 
     /* Fault Return */
     return FAILURE; 
-}
\ No newline at end of file
+}
+
+#if defined(POSIX_HOST) && !defined(BENCH_ENABLE)
+/***************************************************************************************
+*   main() Implementation. The Process Entry of the POSIX_HOST Port.
+***************************************************************************************/
+int main(void)
+{
+    return (int)main_(); 
+}
+#endif  /* End of POSIX_HOST && !BENCH_ENABLE */
@@ -43,23 +43,33 @@
 #include "spyer.h"
 #include "ticks.h"
 #include "fault.h"
+#include "lookup.h"
 #include "mpool.h"
 #include "event.h"
 #include "epool.h"
 #include "cpool.h"
 #include "echain.h"
+#include "ering.h"
 #include "rchain.h"
 #include "fsm.h"
 #include "hsm.h"
 #include "active.h"
 #include "achain.h"
+#include "stack.h"
 #include "callback.h"
+#include "timer.h"
+#include "cycles.h"
+#include "executor.h"
+#include "sim.h"
 
 #define  EXTERN_GLOBALS
+#include "sche.h"
 #include "manager.h"
+#include "activex.h" 
 
 ASSERT_THIS_FILE(manager.c)
 FAULT_THIS_FILE(manager.c)
+SPYER_THIS_FILE(10)
 
 /***************************************************************************************
 *   man_version() Implementation.
@@ -86,11 +96,42 @@ int16_t man_init(void_t)
     /***********************************************************************************
     *   Priority Based Event Scheduler.
     ***********************************************************************************/
-    manager -> event    = (chain_t *)0; 
+    ret = echain_init((echain_t *)&(manager -> event)); 
+    ASSERT_ENSURE(ret == TRUE); 
     manager -> priority = (uint16_t)65535;  /* Lowest Priority */
     manager -> head     = (chain_t *)0; 
     manager -> current  = (chain_t *)0; 
     manager -> stack    = (stack_t *)&man_stack; 
+#ifdef MANAGER_RING_ENABLE
+    /***********************************************************************************
+    *   Lock-Free Event Rings.
+    ***********************************************************************************/
+    for (ret = (int16_t)0; ret < (int16_t)MAX_RING; ++ret) { 
+        manager -> ring[ret] = (ering_t *)0; 
+    } 
+    manager -> rings = (uint8_t)0; 
+#endif  /* End of MANAGER_RING_ENABLE */
+#ifdef MANAGER_READY_SET_ENABLE
+    /***********************************************************************************
+    *   Ready Set Scheduler.
+    ***********************************************************************************/
+    for (ret = (int16_t)0; ret < (int16_t)MAX_ACTIVE; ++ret) { 
+        manager -> ready[ret] = (active_t *)0; 
+    } 
+    set_init(&os_ready_set_); 
+#endif  /* End of MANAGER_READY_SET_ENABLE */
+#ifdef MANAGER_SIGNAL_TABLE_ENABLE
+    /***********************************************************************************
+    *   Signal Indexed Subscriber Table.
+    ***********************************************************************************/
+    for (ret = (int16_t)0; ret < (int16_t)MAX_SIGNAL; ++ret) { 
+        set_init(&man_table[ret]); 
+    } 
+    for (ret = (int16_t)0; ret < (int16_t)sizeof(man_signals); ++ret) { 
+        ((uint8_t *)man_signals)[ret] = (uint8_t)0; 
+    } 
+    manager -> scan_slot = (uint8_t)0; 
+#endif  /* End of MANAGER_SIGNAL_TABLE_ENABLE */
     /***********************************************************************************
     *   Priority Based Scan Scheduler.
     ***********************************************************************************/
@@ -102,7 +143,7 @@ int16_t man_init(void_t)
     *   Failure Logging Event. 
     ***********************************************************************************/
     event_init((event_t*)&((manager -> logger_event).super), 
-               (signal_t)SIG_FAULT, PRIO_EVT_FAULT, PRIO_EVT_FAULT); 
+               (signal_t)SIGNAL_FAULT_, PRIO_EVT_FAULT, PRIO_EVT_FAULT); 
     ((manager -> logger_event).logger).file[0] = (int8_t)0; 
     ((manager -> logger_event).logger).line  = ( int16_t)0; 
     ((manager -> logger_event).logger).time  = (uint32_t)0; 
@@ -123,6 +164,14 @@ int16_t man_init(void_t)
                     );
     ASSERT_ENSURE(ret == TRUE); 
 
+#ifdef MANAGER_EXECUTOR_ENABLE
+    /***********************************************************************************
+    *   Start the Workers of Executor. 
+    ***********************************************************************************/
+    ret = executor_init(); 
+    ASSERT_ENSURE(ret == TRUE); 
+#endif  /* End of MANAGER_EXECUTOR_ENABLE */
+
     SPYER_MANAGER("The Active Object Manager %X is Initialized.", manager); 
 
     /* Callback for Initialize the Active Objects Defined by Application */
@@ -130,6 +179,141 @@ int16_t man_init(void_t)
     return TRUE; 
 }
 
+#ifdef MANAGER_SIGNAL_TABLE_ENABLE
+
+/***************************************************************************************
+*   man_subscribe() Implementation. Signal Indexed Subscriber Table. 
+***************************************************************************************/
+int16_t man_subscribe(event_t *event, active_t *active)
+{
+    int16_t   ret; 
+    signal_t  signal;
+    manager_t *manager; 
+
+    INT_LOCK_KEY_
+
+    ASSERT_REQUIRE(event  != ( event_t *)0);
+    ASSERT_REQUIRE(active != (active_t *)0);
+    if ((event == (event_t *)0) || (active == (active_t *)0)) { 
+        return FAILURE; 
+    } 
+    ASSERT_REQUIRE(event->signal < (signal_t)MAX_SIGNAL); 
+    ASSERT_REQUIRE(active->slot  < (uint8_t)MAX_ACTIVE); 
+    if ((event->signal >= (signal_t)MAX_SIGNAL) || (active->slot >= (uint8_t)MAX_ACTIVE)) { 
+        return FAILURE; 
+    } 
+
+    /* Get the Manager */
+    manager = (manager_t *)&man; 
+    /* Get the Signal of Event */
+    signal = event->signal; 
+    /* Release the Event, Only the Signal is Required */
+    ret = epool_release(event); 
+    ASSERT_ENSURE(ret >= (int16_t)0); 
+    if (ret < (int16_t)0) { 
+        return FAILURE; 
+    } 
+    /* Register the Active Object and Insert it into the Subscribers Set */
+    INT_LOCK_(); 
+    ASSERT_REQUIRE((manager->ready[active->slot] == (active_t *)0) || 
+                   (manager->ready[active->slot] == active)); 
+    manager->ready[active->slot] = active; 
+    set_insert(&man_table[signal], active->slot); 
+    man_signals[active->slot][signal >> 3] |= ROM_BYTE(&lookup_bit_or[signal & 0x07]); 
+    INT_UNLOCK_(); 
+
+    SPYER_MANAGER("The Event (Signal %d) is Subscribed by the Active Object %X. TimeStamp %d", \
+                  signal, active, ticks_get()); 
+
+    return TRUE; 
+}
+
+/***************************************************************************************
+*   man_unsubscribe() Implementation. Signal Indexed Subscriber Table. 
+***************************************************************************************/
+int16_t man_unsubscribe(event_t *event, active_t *active)
+{
+    int16_t   ret; 
+    signal_t  signal;
+
+    INT_LOCK_KEY_
+
+    ASSERT_REQUIRE(event  != ( event_t *)0);
+    ASSERT_REQUIRE(active != (active_t *)0);
+    if ((event == (event_t *)0) || (active == (active_t *)0)) { 
+        return FAILURE; 
+    } 
+    ASSERT_REQUIRE(event->signal < (signal_t)MAX_SIGNAL); 
+    ASSERT_REQUIRE(active->slot  < (uint8_t)MAX_ACTIVE); 
+    if ((event->signal >= (signal_t)MAX_SIGNAL) || (active->slot >= (uint8_t)MAX_ACTIVE)) { 
+        return FAILURE; 
+    } 
+
+    /* Get the Signal of Event */
+    signal = event->signal; 
+    /* Release the Event */
+    ret = epool_release(event); 
+    ASSERT_ENSURE(ret >= (int16_t)0); 
+    if (ret < (int16_t)0) { 
+        return FAILURE; 
+    } 
+    /* Remove the Active Object from the Subscribers Set */
+    INT_LOCK_(); 
+    ASSERT_REQUIRE(set_has_element(&man_table[signal], active->slot)); 
+    set_remove(&man_table[signal], active->slot); 
+    man_signals[active->slot][signal >> 3] &= ROM_BYTE(&lookup_bit_and[signal & 0x07]); 
+    INT_UNLOCK_(); 
+
+    SPYER_MANAGER("The Event (Signal %d) is Un-Subscribed by the Active Object %X. TimeStamp %d", \
+                  signal, active, ticks_get()); 
+
+    return TRUE; 
+}
+
+/***************************************************************************************
+*   man_unsubscribe_all() Implementation. Signal Indexed Subscriber Table. 
+*
+*   NOTE: The Cost is One Bit Clear per Subscribed Signal, No Chain is Travelled. 
+*         The Signals are Found in man_signals[slot], Eight in One Critical Section. 
+***************************************************************************************/
+int16_t man_unsubscribe_all(active_t *active)
+{
+    uint16_t  index;
+    uint8_t   bits; 
+    uint8_t   bit; 
+
+    INT_LOCK_KEY_
+
+    ASSERT_REQUIRE(active != (active_t *)0);
+    if (active == (active_t *)0) { 
+        return FAILURE; 
+    } 
+    ASSERT_REQUIRE(active->slot < (uint8_t)MAX_ACTIVE); 
+    if (active->slot >= (uint8_t)MAX_ACTIVE) { 
+        return FAILURE; 
+    } 
+
+    /* Un-Subscribe All Event associated with the Active Object, a Byte at a Time */
+    for (index = (uint16_t)0; index < (uint16_t)sizeof(man_signals[0]); ++index) { 
+        INT_LOCK_(); 
+        bits = man_signals[active->slot][index]; 
+        man_signals[active->slot][index] = (uint8_t)0; 
+        while (bits != (uint8_t)0) { 
+            bit = ROM_BYTE(&lookup_unmap[bits]); 
+            set_remove(&man_table[(index << 3) + bit], active->slot); 
+            bits &= ROM_BYTE(&lookup_bit_and[bit]); 
+        } 
+        INT_UNLOCK_(); 
+    } 
+
+    SPYER_MANAGER("All the Event is Un-Subscribed by the Active Object %X. TimeStamp %d", \
+                   active, ticks_get()); 
+
+    return TRUE; 
+}
+
+#else
+
 /***************************************************************************************
 *   man_subscribe() Implementation.
 ***************************************************************************************/
@@ -152,7 +336,7 @@ int16_t man_subscribe(event_t *event, active_t *active)
     /* Get the Enroll Book */
     enroll = (chain_t **)&(manager -> enrool);
     /* Has the Event with Same "signal" in the Subscribes List ? */
-    chain = rchain_find(enroll, event->signal)
+    chain = rchain_find(enroll, event->signal); 
     if (chain != (chain_t *)0) { 
         /* Release the Event */
         ret = epool_release(event); 
@@ -185,7 +369,7 @@ int16_t man_subscribe(event_t *event, active_t *active)
         return FAILURE; 
     } 
 
-    SPYER_MANAGER("The Event (Signal %d) is Subscribed by the Active Object %X. TimeStamp %d", \\
+    SPYER_MANAGER("The Event (Signal %d) is Subscribed by the Active Object %X. TimeStamp %d", \
                   event->signal, active, ticks_get()); 
 
     return TRUE; 
@@ -222,7 +406,7 @@ int16_t man_unsubscribe(event_t *event, active_t *active)
         return FAILURE; 
     } 
     /* Has the Event with Same "signal" in the Subscribes List ? */
-    chain = rchain_find(enroll, signal)
+    chain = rchain_find(enroll, signal); 
     ASSERT_REQUIRE(chain != (chain_t *)0); 
     if (chain == (chain_t *)0) { 
         return FAILURE; 
@@ -248,7 +432,7 @@ int16_t man_unsubscribe(event_t *event, active_t *active)
         ASSERT_ENSURE(ret == TRUE); 
     } 
 
-    SPYER_MANAGER("The Event (Signal %d) is Un-Subscribed by the Active Object %X. TimeStamp %d", \\
+    SPYER_MANAGER("The Event (Signal %d) is Un-Subscribed by the Active Object %X. TimeStamp %d", \
                   signal, active, ticks_get()); 
 
     return TRUE; }
@@ -260,6 +444,7 @@ int16_t man_unsubscribe_all(active_t *active)
 {
     int16_t   ret; 
     event_t * event; 
+    int16_t   last; 
     chain_t * chain; 
     chain_t * next; 
     chain_t **head; 
@@ -277,7 +462,7 @@ int16_t man_unsubscribe_all(active_t *active)
     enroll = (chain_t **)&(manager -> enrool);
     /* Un-Subscribe All Event associated with the Active Object */
     chain = *enroll; 
-    do { 
+    while (chain != (chain_t *)0) { 
         /* Get List Head of Active Object Chain */
         event = (event_t *)(chain->builtin); 
         head  = (chain_t **)&(event->record); 
@@ -285,20 +470,22 @@ int16_t man_unsubscribe_all(active_t *active)
         /* Remove the Active Object from the Subscribes List */
         ret = achain_unbind(head, active); 
         ASSERT_ENSURE(ret == TRUE); 
-        /* Backup the Next Chain Cell */
+        /* Backup the Next Chain Cell, the Cell may be Unbind Below */
         next = chain->next; 
+        last = (next == *enroll) ? TRUE : FALSE; 
         /* The Subscribes List of Active Object become Empty ? */
         if (*head == (chain_t *)0) { 
             /* Unbind the Event from Register Chain */
             ret = rchain_unbind(enroll, chain); 
             ASSERT_ENSURE(ret == TRUE); 
         } 
-        /* Pointer to Next Chain Cell */
-        chain = next; 
 
-        SPYER_MANAGER("The Event (Signal %d) is Un-Subscribed by the Active Object %X. TimeStamp %d", \\
+        SPYER_MANAGER("The Event (Signal %d) is Un-Subscribed by the Active Object %X. TimeStamp %d", \
                        event->signal, active, ticks_get()); 
-    } while (chain != *enroll); 
+
+        /* Pointer to Next Chain Cell, Stop after the Last One */
+        chain = (last == TRUE) ? (chain_t *)0 : next; 
+    } 
 
     return TRUE; 
 }
@@ -308,7 +495,7 @@ int16_t man_unsubscribe_all(active_t *active)
 ***************************************************************************************/
 chain_t *man_subscribe_find(event_t *event)
 {
-    chian_t * active; 
+    chain_t * active; 
     chain_t * chain; 
     chain_t * enroll; 
     manager_t *manager; 
@@ -322,14 +509,18 @@ chain_t *man_subscribe_find(event_t *event)
     manager = (manager_t *)&man; 
     /* Get the Enroll Book */
     enroll  = manager->enrool;
+    if (enroll == (chain_t *)0) { 
+        /* The Enroll Book is Empty */
+        return (chain_t *)0; 
+    } 
     /* Find the Active Object Chain which Subscribe this Event */
     chain = enroll; 
     do { 
         /* Is the Want Event ? */
         if (((event_t *)(chain->builtin))->signal == event->signal) { 
-            active = (chian_t *)(((event_t *)(chain->builtin))->record); 
+            active = (chain_t *)(((event_t *)(chain->builtin))->record); 
 
-            SPYER_MANAGER("The Event (Signal %d) is Find, The Active Object Chain %X is Return. TimeStamp %d", \\
+            SPYER_MANAGER("The Event (Signal %d) is Find, The Active Object Chain %X is Return. TimeStamp %d", \
                        event->signal, active, ticks_get()); 
 
             return active; 
@@ -341,6 +532,8 @@ chain_t *man_subscribe_find(event_t *event)
     return (chain_t *)0; 
 }
 
+#endif  /* End of MANAGER_SIGNAL_TABLE_ENABLE */
+
 /***************************************************************************************
 *   man_post() Implementation.
 ***************************************************************************************/
@@ -356,7 +549,7 @@ int16_t man_post(event_t *event)
 
     /* Get the Manager */
     manager = (manager_t *)&man; 
-    ret = echain_post((chain_t **)&(manager -> event), event); 
+    ret = echain_post((echain_t *)&(manager -> event), event); 
     ASSERT_ENSURE(ret == TRUE); 
     if (ret != TRUE) { 
         return FAILURE; 
@@ -364,17 +557,280 @@ int16_t man_post(event_t *event)
     return TRUE; 
 }
 
+#ifdef MANAGER_RING_ENABLE
+/***************************************************************************************
+*   man_ring_bind() Implementation.
+***************************************************************************************/
+int16_t man_ring_bind(ering_t *ring) 
+{
+    manager_t *manager; 
+
+    INT_LOCK_KEY_
+
+    ASSERT_REQUIRE(ring != (ering_t *)0); 
+    if (ring == (ering_t *)0) { 
+        return FAILURE; 
+    }
+
+    /* Get the Manager */
+    manager = (manager_t *)&man; 
+    INT_LOCK_(); 
+    ASSERT_REQUIRE(manager -> rings < (uint8_t)MAX_RING); 
+    if (manager -> rings >= (uint8_t)MAX_RING) { 
+        INT_UNLOCK_(); 
+        return FAILURE; 
+    } 
+    manager -> ring[manager -> rings] = ring; 
+    ++(manager -> rings); 
+    INT_UNLOCK_(); 
+
+    SPYER_MANAGER("The Event Ring %X is Bound to Manager. TimeStamp %d", ring, ticks_get()); 
+    return TRUE; 
+}
+
+/***************************************************************************************
+*   man_ring_drain_() Implementation. Internal
+*
+*   Return: TRUE if All the Bound Rings are Empty after Drain, or else FALSE. 
+***************************************************************************************/
+static int16_t man_ring_drain_(manager_t *manager) 
+{
+    int16_t  ret; 
+    int16_t  empty; 
+    uint8_t  index; 
+
+    empty = TRUE; 
+    for (index = (uint8_t)0; index < manager -> rings; ++index) { 
+        ret = ering_drain(manager -> ring[index], (echain_t *)&(manager -> event), 
+                          (uint16_t)ERING_BATCH); 
+        ASSERT_ENSURE(ret >= (int16_t)0); 
+        if (!ering_is_empty(manager -> ring[index])) { 
+            empty = FALSE; 
+        } 
+    } 
+    return empty; 
+}
+
+/***************************************************************************************
+*   man_ring_is_empty_() Implementation. Internal
+***************************************************************************************/
+static int16_t man_ring_is_empty_(manager_t *manager) 
+{
+    uint8_t  index; 
+
+    for (index = (uint8_t)0; index < manager -> rings; ++index) { 
+        if (!ering_is_empty(manager -> ring[index])) { 
+            return FALSE; 
+        } 
+    } 
+    return TRUE; 
+}
+
+#define MAN_RING_IS_EMPTY_(manager_)    man_ring_is_empty_(manager_)
+#else
+#define MAN_RING_IS_EMPTY_(manager_)    (TRUE)
+#endif  /* End of MANAGER_RING_ENABLE */
+
+/***************************************************************************************
+*   The Ticks the CPU may Sleep in on_idle(). Called with Interrupts Locked.
+***************************************************************************************/
+#ifdef TICKER_TICKLESS_ENABLE
+#define MAN_IDLE_TICKS_()               timer_next()
+#else
+#define MAN_IDLE_TICKS_()               ((uint32_t)1)
+#endif  /* End of TICKER_TICKLESS_ENABLE */
+
+#ifdef SPYER_FILTER_ENABLE
+/***************************************************************************************
+*   man_spyer_() Implementation. Internal
+*   Apply the Command Event of Spyer Filter, and Release It. 
+***************************************************************************************/
+static void_t man_spyer_(event_t *event) 
+{
+    spyer_event_t *command; 
+
+    command = (spyer_event_t *)event; 
+    if (command -> active == (active_t *)0) { 
+        spyer_filter(command -> mask); 
+    } 
+    else { 
+        command -> active -> trace = (command -> trace != (uint8_t)0) ? 
+                                     (uint8_t)1 : (uint8_t)0; 
+    } 
+    SPYER_MANAGER("Spyer Filter is Changed, Mask %X, Active Object %X, Trace %d. TimeStamp %d", \
+                   command->mask, command->active, command->trace, ticks_get()); 
+    /* Never Published, Take the Reference which epool_release() Drops */
+    ++event->dynamic_; 
+    epool_release(event); 
+}
+
+#endif  /* End of SPYER_FILTER_ENABLE */
+
+#if defined(SPYER_FILTER_ENABLE) || defined(ACTIVE_PROFILE_ENABLE) || defined(SIM_ENABLE)
+/***************************************************************************************
+*   man_run_() Implementation. Internal
+*   Run the Active Object with the Mask of Channels in Effect for It, and Account 
+*   the Cycles Spent into Its Profile. In the Simulation, the Virtual Clock Advances 
+*   by the Cost of the Step. 
+***************************************************************************************/
+static int16_t man_run_(active_t *active) 
+{
+    int16_t  ret; 
+#ifdef ACTIVE_PROFILE_ENABLE
+    uint32_t start; 
+#endif  /* End of ACTIVE_PROFILE_ENABLE */
+
+    spyer_enter_(active -> trace); 
+#ifdef ACTIVE_PROFILE_ENABLE
+    start = cycles_get(); 
+#endif  /* End of ACTIVE_PROFILE_ENABLE */
+    ret = (active->run)(active); 
+#ifdef SIM_ENABLE
+    sim_step(active); 
+#endif  /* End of SIM_ENABLE */
+#ifdef ACTIVE_PROFILE_ENABLE
+    active_profile_run(active, cycles_get() - start); 
+#endif  /* End of ACTIVE_PROFILE_ENABLE */
+    spyer_leave_(); 
+    return ret; 
+}
+
+#define MAN_RUN_(active_)               man_run_(active_)
+#else
+#define MAN_RUN_(active_)               (((active_)->run)(active_))
+#endif  /* End of SPYER_FILTER_ENABLE || ACTIVE_PROFILE_ENABLE || SIM_ENABLE */
+
+#ifdef MANAGER_EXECUTOR_ENABLE
+/***************************************************************************************
+*   man_run() Implementation.
+***************************************************************************************/
+int16_t man_run(active_t *active) 
+{
+    ASSERT_REQUIRE(active != (active_t *)0); 
+    if (active == (active_t *)0) { 
+        return FAILURE; 
+    } 
+    return MAN_RUN_(active); 
+}
+
+/***************************************************************************************
+*   man_scan_() Implementation. Internal
+*   The Scan Scheduler Queues the Active Object to the Executor, Never Runs It. 
+***************************************************************************************/
+static int16_t man_scan_(active_t *active) 
+{
+    INT_LOCK_KEY_
+
+    INT_LOCK_(); 
+    executor_ready(active); 
+    INT_UNLOCK_(); 
+    return TRUE; 
+}
+
+/* The Workers Release the Event Concurrently, the Counter is Changed under Lock */
+#define MAN_REF_(event_)                \
+    do { INT_LOCK_(); ++((event_)->dynamic_); INT_UNLOCK_(); } while (0)
+#define MAN_REF_N_(event_, n_)          \
+    do { INT_LOCK_(); (event_)->dynamic_ += (int16_t)(n_); INT_UNLOCK_(); } while (0)
+#define MAN_READY_(active_)             executor_ready(active_)
+#define MAN_SCAN_(active_)              man_scan_(active_)
+#else
+#define MAN_REF_(event_)                (++((event_)->dynamic_))
+#define MAN_REF_N_(event_, n_)          ((event_)->dynamic_ += (int16_t)(n_))
+#define MAN_READY_(active_)             set_insert(&os_ready_set_, (active_)->slot)
+#define MAN_SCAN_(active_)              MAN_RUN_(active_)
+#endif  /* End of MANAGER_EXECUTOR_ENABLE */
+
+#ifdef MANAGER_READY_SET_ENABLE
+/***************************************************************************************
+*   man_ready() Implementation.
+***************************************************************************************/
+int16_t man_ready(active_t *active) 
+{
+    INT_LOCK_KEY_
+
+    ASSERT_REQUIRE(active != (active_t *)0); 
+    if (active == (active_t *)0) { 
+        return FAILURE; 
+    } 
+
+    INT_LOCK_(); 
+    if (echain_is_empty(&(active->event))) { 
+        INT_UNLOCK_(); 
+        /* Nothing to Run, the Next Post Marks It Ready */
+        return FALSE; 
+    } 
+    MAN_READY_(active); 
+    INT_UNLOCK_(); 
+    return TRUE; 
+}
+#endif  /* End of MANAGER_READY_SET_ENABLE */
+
+/***************************************************************************************
+*   man_fanout_() Implementation. Internal
+*   Post the Event to a Batch of Subscribers (not More than MPOOL_BATCH), the Chain 
+*   Cells are Taken in One Batch, and the Subscribers are Marked Ready in One 
+*   Critical Section. When the Chain Pool Runs Short, the Subscribers Served Keep 
+*   the Event, and FAILURE is Returned for the Others. 
+***************************************************************************************/
+static int16_t man_fanout_(event_t *event, active_t *actives[], uint16_t n) 
+{
+    uint16_t  index; 
+    uint16_t  posted; 
+    echain_t *chains[MPOOL_BATCH]; 
+
+    INT_LOCK_KEY_
+
+    for (index = (uint16_t)0; index < n; ++index) { 
+        ASSERT_REQUIRE(actives[index] != (active_t *)0); 
+        chains[index] = (echain_t *)&(actives[index] -> event); 
+    } 
+    /* Increment the Reference Counter, before the Subscribers can Release It */
+    MAN_REF_N_(event, n); 
+    /* Post the Event Directly to the Event Chains of the Acitve Objects */
+    posted = echain_multicast(chains, n, event); 
+    ASSERT_ENSURE(posted == n); 
+    if (posted != n) { 
+        /* Posted to the First Ones Only, Give Back the References of the Others */
+        MAN_REF_N_(event, -(int16_t)(n - posted)); 
+    } 
+#ifdef MANAGER_READY_SET_ENABLE
+    /* Mark the Active Objects are Ready to Run */
+    INT_LOCK_(); 
+    for (index = (uint16_t)0; index < posted; ++index) { 
+        ASSERT_REQUIRE(actives[index] -> slot < (uint8_t)MAX_ACTIVE); 
+        man.ready[actives[index] -> slot] = actives[index]; 
+        MAN_READY_(actives[index]); 
+    } 
+    INT_UNLOCK_(); 
+#endif  /* End of MANAGER_READY_SET_ENABLE */
+
+    for (index = (uint16_t)0; index < posted; ++index) { 
+        SPYER_MANAGER("The Event (Signal %d) is Published to Active Object %X, dynamic %d. TimeStamp %d", \
+                       event->signal, actives[index], event->dynamic_, ticks_get()); 
+    } 
+    return (posted == n) ? TRUE : FAILURE; 
+}
+
 /***************************************************************************************
 *   man_publish() Implementation.
 ***************************************************************************************/
 int16_t man_publish(event_t *event) 
 {
     int16_t   ret; 
-    event_t * event; 
-    chain_t * chain; 
-    chain_t * head; 
+    uint16_t  count; 
     active_t  *active; 
+    active_t  *actives[MPOOL_BATCH]; 
     manager_t *manager; 
+#ifdef MANAGER_SIGNAL_TABLE_ENABLE
+    uint8_t   slot; 
+    set_t     subscribers; 
+#else
+    chain_t * chain; 
+    chain_t * head; 
+#endif  /* End of MANAGER_SIGNAL_TABLE_ENABLE */
+
+    INT_LOCK_KEY_
 
     ASSERT_REQUIRE(event != (event_t *)0); 
     if(event == (event_t *)0) { 
@@ -383,8 +839,48 @@ int16_t man_publish(event_t *event)
 
     /* Get the Manager */
     manager = (manager_t *)&man; 
-    /* Get the Active Object Chain Head */
-    head = (chain_t *)(manager -> head); 
+#ifdef MANAGER_SIGNAL_TABLE_ENABLE
+    ASSERT_REQUIRE(event->signal < (signal_t)MAX_SIGNAL); 
+    if (event->signal >= (signal_t)MAX_SIGNAL) { 
+        return FAILURE; 
+    } 
+    /* Snapshot the Subscribers Set of the Signal */
+    INT_LOCK_(); 
+    subscribers = man_table[event->signal]; 
+    INT_UNLOCK_(); 
+    if (set_is_empty(&subscribers)) { 
+        /* Not Find */
+        return FALSE; 
+    } 
+#ifdef MANAGER_EXECUTOR_ENABLE
+    /* Hold a Reference during Multicasting, the Workers may Release the Event */
+    MAN_REF_(event); 
+#endif  /* End of MANAGER_EXECUTOR_ENABLE */
+    /* Multicasting the Event to the Subscribers in Batches, from Highest Priority Slot */
+    count = (uint16_t)0; 
+    do { 
+        set_find_max(&subscribers, slot); 
+        set_remove(&subscribers, slot); 
+        /* Get the Active Object */ 
+        active = manager->ready[slot]; 
+        ASSERT_REQUIRE(active != (active_t *)0); 
+        actives[count++] = active; 
+        if ((count == (uint16_t)MPOOL_BATCH) || !set_has_elements(&subscribers)) { 
+            ret = man_fanout_(event, actives, count); 
+            if (ret != TRUE) { 
+                /* Stop, the Reference Held is Dropped Below */
+                break; 
+            } 
+            count = (uint16_t)0; 
+        } 
+    } while (set_has_elements(&subscribers)); 
+#else
+    /* Find the Active Object Chain which Subscribe this Event in the Enroll Book */
+    head = man_subscribe_find(event); 
+    if (head == (chain_t *)0) { 
+        /* Not Find */
+        return FALSE; 
+    } 
 
     /***********************************************************************************
     *   Perform Multicasting with the Scheduler Locked.
@@ -398,7 +894,12 @@ int16_t man_publish(event_t *event)
     *   (3) Using Scheduler Lock at Here Can Avoid the Lose of External Event which 
     *       is Producted by External Peripheral of Device.
     ***********************************************************************************/
-    /* Multicasting the Event to All the Avtive Object */
+#ifdef MANAGER_EXECUTOR_ENABLE
+    /* Hold a Reference during Multicasting, the Workers may Release the Event */
+    MAN_REF_(event); 
+#endif  /* End of MANAGER_EXECUTOR_ENABLE */
+    /* Multicasting the Event to All the Avtive Object, in Batches */
+    count = (uint16_t)0; 
     chain = head; 
     do { 
         /* Get the Active Object */ 
@@ -417,19 +918,25 @@ int16_t man_publish(event_t *event)
         *       Event Dispatching is Synchronous. Direct Event Dispatching Occurs when 
         *       You Call hsm_dispatch() Function.
         *******************************************************************************/
-        ret = echain_post((chain_t **)&(active -> event), event); 
-        ASSERT_ENSURE(ret == TRUE); 
-        if (ret != TRUE) { 
-            return FAILURE; 
+        actives[count++] = active; 
+        /* Pointer to Next Active Object */
+        chain = chain -> next; 
+        if ((count == (uint16_t)MPOOL_BATCH) || (chain == head)) { 
+            ret = man_fanout_(event, actives, count); 
+            if (ret != TRUE) { 
+                /* Stop, the Reference Held is Dropped Below */
+                break; 
+            } 
+            count = (uint16_t)0; 
         } 
-        /* Increment the Reference Counter */
-        ++event->dynamic_;
-
-        SPYER_MANAGER("The Event (Signal %d) is Published to Active Object %X, dynamic %d. TimeStamp %d", \\
-                       event->signal, active, event->dynamic_, ticks_get()); 
     } while (chain != head); 
+#endif  /* End of MANAGER_SIGNAL_TABLE_ENABLE */
 
-    return TRUE; 
+#ifdef MANAGER_EXECUTOR_ENABLE
+    /* Drop the Reference Held, Recycle the Event if All the Subscribers are Done */
+    epool_release(event); 
+#endif  /* End of MANAGER_EXECUTOR_ENABLE */
+    return (ret == TRUE) ? TRUE : FAILURE; 
 }
 
 /***************************************************************************************
@@ -437,6 +944,12 @@ int16_t man_publish(event_t *event)
 ***************************************************************************************/
 void_t man_reset_context(void_t) 
 {
+    int16_t    ret; 
+    manager_t *manager; 
+
+    /* Get the Manager */
+    manager = (manager_t *)&man; 
+
     manager -> priority = (uint16_t)65535;  /* Lowest Priority */
     manager -> head     = (chain_t *)0; 
     manager -> current  = (chain_t *)0; 
@@ -453,8 +966,12 @@ void_t man_reset_context(void_t)
 int16_t man_scheduler(void_t)
 {
     int16_t  ret; 
-    event_t *event; 
+#ifdef MANAGER_READY_SET_ENABLE
+    uint8_t  slot; 
+#else
     chain_t *chain; 
+#endif  /* End of MANAGER_READY_SET_ENABLE */
+    event_t *event; 
     active_t  *active; 
     manager_t *manager; 
     logger_t  *logger; 
@@ -480,26 +997,97 @@ int16_t man_scheduler(void_t)
             } 
         } 
     } 
+#ifdef MANAGER_RING_ENABLE
+    /* Move the Events Posted by ISRs into the Event Chain, in Batches */
+    man_ring_drain_(manager); 
+#endif  /* End of MANAGER_RING_ENABLE */
     /* Execute the Scheduler */
     switch(manager->state) { 
+#ifdef MANAGER_READY_SET_ENABLE
+        case 0: 
+        if (echain_is_empty(&(manager->event))) { 
+            /* Have not Event need to Deal With */
+            manager->state = 1; 
+            break; 
+        } 
+        /* Get the Highest Priority Event from Event Chain */
+        event = echain_get((echain_t *)&(manager->event)); 
+        ASSERT_ENSURE(event != (event_t *)0); 
+        if (event == (event_t *)0) { 
+            /* Deal With Fault at Here */
+
+            manager->state = 1; 
+            break; 
+        } 
+#ifdef SPYER_FILTER_ENABLE
+        if (event->signal == SIGNAL_SPYER) { 
+            /* Command of Spyer Filter, Applied and not Published */
+            man_spyer_(event); 
+            manager->state = 1; 
+            break; 
+        } 
+#endif  /* End of SPYER_FILTER_ENABLE */
+        /* Publish the Event, Mark the Subscribers Ready */
+        ret = man_publish(event); 
+        ASSERT_ENSURE(ret >= (int16_t)0); 
+        manager->state = 1; 
+        break; 
+        case 1: 
+        INT_LOCK_(); 
+        if (set_is_empty(&os_ready_set_)) { 
+            INT_UNLOCK_(); 
+            /* Have No Ready Active Object need to Deal With */
+            manager->state = 2; 
+            break; 
+        } 
+        /* Find the Highest Priority Ready Active Object */
+        set_find_max(&os_ready_set_, slot); 
+        active = manager->ready[slot]; 
+        INT_UNLOCK_(); 
+        ASSERT_REQUIRE(active != (active_t *)0); 
+        if (active != (active_t *)0) { 
+            /* Callback the Active Object */
+            MAN_RUN_(active); 
+        } 
+        INT_LOCK_(); 
+        if ((active == (active_t *)0) || echain_is_empty(&(active->event)) || 
+            (active->pause == (int16_t)1)) { 
+            /* The Event Chain is Empty or the Step Took no Event (Paused), Not Ready */
+            /* Again until the Next Post or active_resume() */
+            set_remove(&os_ready_set_, slot); 
+        } 
+        INT_UNLOCK_(); 
+        /* Re-Check the Event Chain of Manager after Each RTC Step */
+        manager->state = 0; 
+        break; 
+#else
         case 0: 
-        if (manager->event == (chain_t *)0) { 
+        if (echain_is_empty(&(manager->event))) { 
             /* Have not Event need to Deal With */
             manager->state = 1; 
             break; 
         } 
         /* Get the Event Pointer*/
-        event = (event_t *)(manager->event->builtin); 
+        event = echain_front((echain_t *)&(manager->event)); 
         ASSERT_REQUIRE(event != (event_t *)0); 
         if (event == (event_t *)0) { 
             /* Deal With Fault at Here */
 
             /* Fault Tolerance at Here */
             /* Discard the Event Simply */
-            echain_get((chain_t **)&(manager->event)); 
+            echain_get((echain_t *)&(manager->event)); 
             manager->state = 1;
             break; 
         } 
+#ifdef SPYER_FILTER_ENABLE
+        if (event->signal == SIGNAL_SPYER) { 
+            /* Command of Spyer Filter, Applied and not Published */
+            echain_get((echain_t *)&(manager->event)); 
+            man_spyer_(event); 
+            manager->state = 1; 
+            break; 
+        } 
+#endif  /* End of SPYER_FILTER_ENABLE */
         if (event->priority < manager->priority) { 
             /* Have the Higher Event need to Deal With */
             ret = (int16_t)stack_margin(manager->stack); 
@@ -513,7 +1101,7 @@ int16_t man_scheduler(void_t)
                 break; 
             } 
             /* Get the Event from Event Chain */
-            event = echain_get((chain_t **)&(manager->event)); 
+            event = echain_get((echain_t *)&(manager->event)); 
             ASSERT_ENSURE(event != (event_t *)0); 
             /* Find the Active Object Chain which Subscribe this Event */
             chain = man_subscribe_find(event); 
@@ -527,7 +1115,7 @@ int16_t man_scheduler(void_t)
             stack_push(manager->stack, (void_t *)(manager->head)); 
             stack_push(manager->stack, (void_t *)(manager->current)); 
             /* Set Higher Priority Context */
-    `       manager->priority = event->threshold; 
+            manager->priority = event->threshold; 
             manager->head     = chain; 
             manager->current  = chain; 
             /* Publish the Event */
@@ -561,7 +1149,7 @@ int16_t man_scheduler(void_t)
         /* Scheduler the Active Object */
         active = (active_t *)(manager->current->builtin); 
         /* Callback the Active Object */
-        (active->run)(active); 
+        MAN_RUN_(active); 
         /* Pointer to Next Active Object */
         manager->current = manager->current->next; 
         /* Finish ? */
@@ -585,8 +1173,25 @@ int16_t man_scheduler(void_t)
         } 
         manager->state = 0; 
         break; 
+#endif  /* End of MANAGER_READY_SET_ENABLE */
         default: 
-        if (manager->enroll == (chain_t *)0) { 
+#ifdef MANAGER_SIGNAL_TABLE_ENABLE
+        /* Scan the Registered Active Objects One by One According to the Slot */
+        active = manager->ready[manager->scan_slot]; 
+        if (active != (active_t *)0) { 
+            ret = MAN_SCAN_(active); 
+            if (ret != TRUE) { 
+                ++(manager->idle); 
+            } 
+        } 
+        ++(manager->scan_slot); 
+        if (manager->scan_slot >= (uint8_t)MAX_ACTIVE) { 
+            manager->scan_slot = (uint8_t)0; 
+        } 
+        manager->state = 0; 
+        break; 
+#else
+        if (manager->enrool == (chain_t *)0) { 
             /* Reset the Scan Scheduler */
             manager->scan_event   = (chain_t *)0; 
             manager->scan_head    = (chain_t *)0; 
@@ -601,7 +1206,7 @@ int16_t man_scheduler(void_t)
            ) { 
             /* Have Unbind Operations of Event Cell in the Scan Schedule Process */
             /* Initialize the Scan Scheduler */
-            manager->scan_event = manager->enroll; 
+            manager->scan_event = manager->enrool; 
             manager->scan_head    = (chain_t *)(manager->scan_event->builtin); 
             manager->scan_current = (chain_t *)(manager->scan_event->builtin); 
             manager->idle = (uint16_t)0; 
@@ -613,7 +1218,7 @@ int16_t man_scheduler(void_t)
             manager->scan_current = manager->scan_head; 
         } 
         active = (active_t *)(manager->scan_current->builtin); 
-        ret = (active->run)(active); 
+        ret = MAN_SCAN_(active); 
         if (ret != TRUE) { 
             ++(manager->idle); 
         } 
@@ -625,25 +1230,47 @@ int16_t man_scheduler(void_t)
         } 
         manager->state = 0; 
         break; 
+#endif  /* End of MANAGER_SIGNAL_TABLE_ENABLE */
     } 
     INT_LOCK_(); 
-    if ((manager->event == (chain_t *)0) { 
-        if (manager->enroll == (chain_t *)0) { 
-            /* No Event in Event Chain and the Enroll is Empty */
-            on_idle(int_lock_key_); 
-        } 
-        if ((manager->scan_event == manager->enroll) && 
-            (manager->idle == (uint16_t)0) 
+#ifdef MANAGER_SIGNAL_TABLE_ENABLE
+    if (echain_is_empty(&(manager->event)) && set_is_empty(&os_ready_set_) && 
+        (manager->scan_slot == (uint8_t)0) && (manager->idle == (uint16_t)0) && 
+        MAN_RING_IS_EMPTY_(manager)
+       ) { 
+        /* No Event in Event Chain and All the Active Object is in IDLE State */
+        /* on_idle() Unlocks the Interrupts Internally, "idle" is 0 Already */
+        on_idle(int_lock_key_, MAN_IDLE_TICKS_()); 
+        return TRUE; 
+    } 
+    INT_UNLOCK_(); 
+    if (manager->scan_slot == (uint8_t)0) { 
+        manager->idle = (uint16_t)0; 
+    } 
+    return TRUE; 
+#else
+#ifdef MANAGER_READY_SET_ENABLE
+    if (echain_is_empty(&(manager->event)) && set_is_empty(&os_ready_set_) && 
+        MAN_RING_IS_EMPTY_(manager)) { 
+#else
+    if (echain_is_empty(&(manager->event)) && MAN_RING_IS_EMPTY_(manager)) { 
+#endif  /* End of MANAGER_READY_SET_ENABLE */
+        if ((manager->enrool == (chain_t *)0) || 
+            ((manager->scan_event == manager->enrool) && 
+             (manager->idle == (uint16_t)0)) 
            ) { 
-            /* No Event in Event Chain and All the Active Object is in IDLE State */
-            on_idle(int_lock_key_); 
+            /* No Event in Event Chain, the Enroll is Empty or All the Active Object */
+            /* is in IDLE State. on_idle() Unlocks the Interrupts Internally */
+            on_idle(int_lock_key_, MAN_IDLE_TICKS_()); 
+            return TRUE; 
         } 
     } 
     INT_UNLOCK_(); 
-    if (manager->scan_event == manager->enroll) { 
+    if (manager->scan_event == manager->enrool) { 
         manager->idle = (uint16_t)0; 
     } 
     return TRUE; 
+#endif  /* End of MANAGER_SIGNAL_TABLE_ENABLE */
 }
 
 
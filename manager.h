@@ -53,6 +53,43 @@ extern "C" {
 
 
 
+/***************************************************************************************
+*   Lock-Free Event Rings. 
+***************************************************************************************/
+#ifdef MANAGER_RING_ENABLE
+
+    #ifndef MAX_RING
+        /*******************************************************************************
+        *   This Constant Defines the Maximum Number of Event Rings Bound to Manager. 
+        *******************************************************************************/
+        #define MAX_RING        4       /* Default is 4 */
+    #endif      /* End of MAX_RING */
+
+    #ifndef ERING_BATCH
+        /*******************************************************************************
+        *   This Constant Defines the Maximum Number of Events Moved from One Event 
+        *   Ring into the Event Chain of Manager at Each Scheduling. 
+        *******************************************************************************/
+        #define ERING_BATCH     8       /* Default is 8 */
+    #endif      /* End of ERING_BATCH */
+
+#endif  /* End of MANAGER_RING_ENABLE */
+
+/***************************************************************************************
+*   Runtime Filter of Spyer. 
+***************************************************************************************/
+#ifdef SPYER_FILTER_ENABLE
+
+    #ifndef SIGNAL_SPYER
+        /*******************************************************************************
+        *   This Constant Defines the Signal of Command Event for the Spyer Filter, 
+        *   which is Reserved by the Manager and MUST NOT be Subscribed. 
+        *******************************************************************************/
+        #define SIGNAL_SPYER    ((signal_t)0xFFFF)  /* Default is 0xFFFF */
+    #endif      /* End of SIGNAL_SPYER */
+
+#endif  /* End of SPYER_FILTER_ENABLE */
+
 /***************************************************************************************
 *   Manager for the Active Object Application FrameWork
 *
@@ -69,6 +106,21 @@ extern "C" {
 *       for Previous Event and Continue. 
 *   (2) Priority Based Scan Scheduler.
 *   (3) Failure Logging. 
+*   (4) Ready Set Scheduler (MANAGER_READY_SET_ENABLE). Instead of Item (1), Each 
+*       Active Object Owns an Unique Slot in the Ready Set "os_ready_set_", the Slot 
+*       is Marked when an Event is Posted into the Event Chain of the Active Object, 
+*       and the Highest Priority Ready Active Object is Selected by set_find_max() 
+*       in Constant Time. 
+*   (5) Lock-Free Event Rings (MANAGER_RING_ENABLE). ISRs Post the Events into Their 
+*       Own Single-Producer Single-Consumer Rings, the Scheduler Drains the Rings 
+*       into the Event Chain "event" in Batches. 
+*   (6) Runtime Filter of Spyer (SPYER_FILTER_ENABLE). The Command Event with the 
+*       Signal SIGNAL_SPYER Changes the Mask of Channels or the Trace Flag of an 
+*       Active Object, and the Manager Switches the Mask in Effect around the RTC 
+*       Step of Every Active Object. 
+*   (7) Multi-Core Executor (MANAGER_EXECUTOR_ENABLE). Instead of the Manager, the 
+*       Ready Active Objects are Run by the Worker Threads of executor.h, and the 
+*       Scan Scheduler Queues the Active Objects to the Workers. 
 ***************************************************************************************/
 typedef struct manager_tag { 
     /* State Machine */
@@ -83,7 +135,7 @@ typedef struct manager_tag {
     *   Priority Based Event Scheduler.
     ***********************************************************************************/
     /* Priority Based Event Chain */
-    chain_t * event; 
+    echain_t  event; 
     /* Priority of Current Executed Event */
     uint16_t  priority; 
     /* Active Object Chain Head */
@@ -92,6 +144,22 @@ typedef struct manager_tag {
     chain_t * current; 
     /* Stack for Priority Based Event Schedule */
     stack_t * stack; 
+#ifdef MANAGER_READY_SET_ENABLE
+    /***********************************************************************************
+    *   Ready Set Scheduler.
+    ***********************************************************************************/
+    /* Active Objects Indexed by the Slot in Ready Set */
+    active_t * ready[MAX_ACTIVE]; 
+#endif  /* End of MANAGER_READY_SET_ENABLE */
+#ifdef MANAGER_RING_ENABLE
+    /***********************************************************************************
+    *   Lock-Free Event Rings Posted by ISRs. 
+    ***********************************************************************************/
+    /* The Rings Bound to Manager */
+    ering_t * ring[MAX_RING]; 
+    /* Number of the Rings Bound to Manager */
+    uint8_t   rings; 
+#endif  /* End of MANAGER_RING_ENABLE */
     /***********************************************************************************
     *   Priority Based Scan Scheduler.
     ***********************************************************************************/
@@ -103,6 +171,10 @@ typedef struct manager_tag {
     chain_t * scan_current; 
     /* Idle Counter */
     uint16_t  idle; 
+#ifdef MANAGER_SIGNAL_TABLE_ENABLE
+    /* Slot of Active Object in Scan */
+    uint8_t   scan_slot; 
+#endif  /* End of MANAGER_SIGNAL_TABLE_ENABLE */
     /***********************************************************************************
     *   Failure Logging Event. 
     ***********************************************************************************/
@@ -137,12 +209,12 @@ MANAGER_EXT stack_t  man_stack;
 *   Signal Internal Constants for System Use Only
 ***************************************************************************************/
 enum {
-    SIGNAL_QUIT_ = 1;      /* Signal for Quit   the Active Object */
-    SIGNAL_START_;         /* Signal for Start  the Active Object */
-    SIGNAL_RESET_;         /* Signal for Reset  the Active Object */
-    SIGNAL_PAUSE_;         /* Signal for Pause  the Active Object */
-    SIGNAL_RESUME_;        /* Signal for Resume the Active Object */
-    SIGNAL_FAULT_;         /* Signal for Fault */
+    SIGNAL_QUIT_ = 1,      /* Signal for Quit   the Active Object */
+    SIGNAL_START_,         /* Signal for Start  the Active Object */
+    SIGNAL_RESET_,         /* Signal for Reset  the Active Object */
+    SIGNAL_PAUSE_,         /* Signal for Pause  the Active Object */
+    SIGNAL_RESUME_,        /* Signal for Resume the Active Object */
+    SIGNAL_FAULT_          /* Signal for Fault */
 };
 
 #define PRIO_EVT_FAULT      ((uint16_t)0)   /* Event Priority for Fault, Highest */
@@ -168,9 +240,44 @@ typedef struct subscribe_tag {
 #endif      /* End of MAX_SUBSCRIBE_EVENTS */
 
 /* Buffer for Subscribe Event Pool */
-MANAGER_EXT  uint8_t buff_subscribe[(sizeof(event_t) + sizeof(void_t *)) * MAX_SUBSCRIBE_EVENTS + 4]; 
+MANAGER_EXT  uint8_t buff_subscribe[(sizeof(event_t) + MPOOL_HEADER) * MAX_SUBSCRIBE_EVENTS + 4]; 
 MANAGER_EXT  mpool_t epool_subscribe; 
 
+/***************************************************************************************
+*   Signal Indexed Subscriber Table. 
+*
+*   Each Entry is the Set of Slots of the Active Objects which Subscribe the Signal, 
+*   the Table Replace the Enroll Book "enrool", so that Subscribe, Un-Subscribe and 
+*   Publish don't Need to Travel the Enroll Book. 
+*
+*   NOTE: 
+*   (1) The Signal Indexed Subscriber Table Requires the Ready Set Scheduler, the 
+*       Active Objects are Found by Slot through man.ready[]. 
+*   (2) The Signal of Subscribed Event Must be Less than MAX_SIGNAL. 
+*   (3) The Size of Table is (sizeof(set_t) * MAX_SIGNAL) Bytes. 
+*   (4) Each Active Object Keeps the Bits of the Signals it Subscribes in 
+*       man_signals[slot], so man_unsubscribe_all() Visits Only Those Signals. The 
+*       Size is (MAX_ACTIVE * ((MAX_SIGNAL + 7) / 8)) Bytes. 
+***************************************************************************************/
+#ifdef MANAGER_SIGNAL_TABLE_ENABLE
+
+    #ifndef MANAGER_READY_SET_ENABLE
+        #error "MANAGER_SIGNAL_TABLE_ENABLE Requires MANAGER_READY_SET_ENABLE"
+    #endif
+
+    #ifndef MAX_SIGNAL
+        /*******************************************************************************
+        *   This Constant Defines the Maximum Signal Value of Event Subscribe, Default 
+        *   is MAX_SUBSCRIBE_EVENTS. 
+        *******************************************************************************/
+        #define MAX_SIGNAL      MAX_SUBSCRIBE_EVENTS
+    #endif      /* End of MAX_SIGNAL */
+
+    MANAGER_EXT  set_t man_table[MAX_SIGNAL]; 
+    MANAGER_EXT  uint8_t man_signals[MAX_ACTIVE][(MAX_SIGNAL + 7) / 8]; 
+
+#endif  /* End of MANAGER_SIGNAL_TABLE_ENABLE */
+
 /***************************************************************************************
 *   Return the Pointer of Active Object Manager's Version.
 *
@@ -213,6 +320,8 @@ MANAGER_EXT int16_t man_init(void_t);
 *   NOTE: 
 *   (1) Subscribing to an Event means that the Framework will Start Posting
 *       Published Events with a Given Signal to the Event Chain of the Active Object. 
+*   (2) With the Signal Indexed Subscriber Table, the "event" is Released at Once, 
+*       Only the Slot of Active Object is Inserted into Entry "signal" of Table. 
 ***************************************************************************************/
 MANAGER_EXT int16_t man_subscribe(event_t *event, active_t *active);
 
@@ -271,8 +380,12 @@ MANAGER_EXT int16_t man_unsubscribe_all(active_t *active);
 *
 *   NOTE: 
 *   (1) This Function Call by Manager Internally ONLY.
+*   (2) Not Available with the Signal Indexed Subscriber Table, Since the Table is 
+*       Indexed by the Signal Directly. 
 ***************************************************************************************/
+#ifndef MANAGER_SIGNAL_TABLE_ENABLE
 MANAGER_EXT chain_t *man_subscribe_find(event_t *event);
+#endif  /* End of MANAGER_SIGNAL_TABLE_ENABLE */
 
 /***************************************************************************************
 *   Post an Event to the Manager.
@@ -285,6 +398,57 @@ MANAGER_EXT chain_t *man_subscribe_find(event_t *event);
 ***************************************************************************************/
 MANAGER_EXT int16_t man_post(event_t *event); 
 
+#ifdef MANAGER_RING_ENABLE
+/***************************************************************************************
+*   Bind the Lock-Free Event Ring to the Manager.
+*
+*   Description: Bind the Event Ring, which is Initialized by ering_init(), to the 
+*                Manager. man_scheduler() Drains the Bound Rings into the Event Chain 
+*                of Manager in Batches. 
+*   Argument: ring -- The Pointer of Event Ring. 
+*   Return:  1 is True, 0 is False, -1 is Failure 
+*
+*   NOTE: 
+*   (1) Each ISR (or Producer Thread of Host Port) Must Own Its Ring, and Post Events 
+*       through man_post_ring() Instead of man_post(). 
+*   (2) Called before the Producer is Enabled. 
+***************************************************************************************/
+MANAGER_EXT int16_t man_ring_bind(ering_t *ring); 
+
+/***************************************************************************************
+*   Post an Event to the Manager through the Lock-Free Event Ring.
+*
+*   Description: Post an Event into the Event Ring without Locking the Interrupts. 
+*   Argument: ring  -- The Pointer of Event Ring Owned by the Caller. 
+*             event -- The Pointer of Event which will be Post. 
+*   Return:  1 is True, 0 is False (the Ring is Full), -1 is Failure 
+*
+*   NOTE: 
+*   (1) The Cost is Bounded, No List Walk and No Allocation at Here. 
+***************************************************************************************/
+#define man_post_ring(ring_, event_)    ering_post((ring_), (event_))
+#endif  /* End of MANAGER_RING_ENABLE */
+
+#ifdef SPYER_FILTER_ENABLE
+/***************************************************************************************
+*   Command Event of the Spyer Filter. 
+*
+*   Posted to the Manager by man_post() (or man_post_ring()) with the Signal 
+*   SIGNAL_SPYER, man_scheduler() Applies It and Never Publishes It: 
+*   (1) If "active" is NULL, the "mask" Becomes the Global Mask of Channels. 
+*   (2) Otherwise, the "trace" Becomes the Trace Flag of the Active Object. 
+*
+*   NOTE: (1) The Event may be Static or Allocated from the Event Pool, It is 
+*             Released after Applied. 
+***************************************************************************************/
+typedef struct spyer_event_tag { 
+    event_t    super;       /* Derives from event_t */
+    uint32_t   mask;        /* Global Mask of Channels, SPYER_CH_XXX Ored Together */
+    active_t * active;      /* The Active Object to be Traced, or NULL */
+    uint8_t    trace;       /* Trace Flag of the Active Object, 1 is On, 0 is Off */
+} spyer_event_t; 
+#endif  /* End of SPYER_FILTER_ENABLE */
+
 /***************************************************************************************
 *   Publish an Event to the Active Objects.
 *
@@ -298,6 +462,9 @@ MANAGER_EXT int16_t man_post(event_t *event);
 *       Multiple Subscribers. 
 *   (2) This Function ONLY Used in Active Object Manager.
 *   (2) The Subscriber Lists is Indexed by Event's Signal. 
+*   (3) When the Ready Set Scheduler is Enabled, the Subscribers are Found by this 
+*       Function Itself, and the Slot of Each Subscriber is Marked in the Ready Set. 
+*       FALSE is Returned if the Event has not been Subscribed. 
 ***************************************************************************************/
 MANAGER_EXT int16_t man_publish(event_t *event); 
 
@@ -346,8 +513,40 @@ MANAGER_EXT int16_t man_publish(event_t *event);
 ***************************************************************************************/
 MANAGER_EXT int16_t man_scheduler(void_t);
 
+#ifdef MANAGER_EXECUTOR_ENABLE
+/***************************************************************************************
+*   Run the Active Object for One RTC Step.
+*
+*   Description: Call run() of the Active Object as the Scheduler Does, with the 
+*                Spyer Filter and the Profile of Active Object Applied. 
+*   Argument: active -- The Pointer of Active Object. 
+*   Return:  The Return of run(), 1 is True, 0 is False, -1 is Failure 
+*
+*   NOTE: 
+*   (1) Used by the Workers of Executor. 
+***************************************************************************************/
+MANAGER_EXT int16_t man_run(active_t *active);
+#endif  /* End of MANAGER_EXECUTOR_ENABLE */
+
+#ifdef MANAGER_READY_SET_ENABLE
+/***************************************************************************************
+*   Mark the Active Object Ready Again.
+*
+*   Description: Set the Slot of Active Object in the Ready Set (or Queue It to the 
+*                Executor) if Its Event Chain is not Empty. 
+*   Argument: active -- The Pointer of Active Object. 
+*   Return:  1 is True (Marked Ready), 0 is False (No Event), -1 is Failure 
+*
+*   NOTE: 
+*   (1) The Scheduler Drops the Slot of a Paused Active Object, active_resume() 
+*       Calls This to Schedule the Events Posted during the Pause. 
+***************************************************************************************/
+MANAGER_EXT int16_t man_ready(active_t *active);
+#endif  /* End of MANAGER_READY_SET_ENABLE */
+
 #ifdef SPYER_MANAGER_ENABLE   /* Spy Debuger Enabled */
-    #define SPYER_MANAGER(format, ...)   spyer_((const int8_t *)format, ##__VA_ARGS__)
+    #define SPYER_MANAGER(format, ...)   \
+        spyer_ch_(SPYER_CH_MANAGER, (const int8_t *)format, ##__VA_ARGS__)
 #else                         /* Spy Debuger Disabled */
     #define SPYER_MANAGER(format, ...)   ((void_t)0)
 #endif  /* End of SPYER_MANAGER_ENABLE */
@@ -43,12 +43,357 @@
 #include "spyer.h"
 #include "ticks.h"
 #include "fault.h"
+#include "hpool.h"
 
 #define  EXTERN_GLOBALS 
 #include "mpool.h" 
 
 ASSERT_THIS_FILE(mpool.c)
 FAULT_THIS_FILE(mpool.c)
+SPYER_THIS_FILE(11)
+
+#ifdef MPOOL_HEADERLESS_ENABLE
+/***************************************************************************************
+*   Range Table of Pools, Sorted by the Start Address. 
+***************************************************************************************/
+static mpool_t * mpool_range_[MPOOL_RANGES]; 
+static uint16_t  mpool_ranges_;     /* Number of Registered Pools */
+
+/***************************************************************************************
+*   mpool_register_() Implementation. Internal
+*   Insert the Pool into the Range Table, or Move It when It is Initialized Again. 
+***************************************************************************************/
+static int16_t mpool_register_(mpool_t *me)
+{
+    uint16_t index; 
+
+    INT_LOCK_KEY_
+    INT_LOCK_();
+    /* Remove the Pool Initialized Before */
+    for (index = (uint16_t)0; index < mpool_ranges_; ++index) { 
+        if (mpool_range_[index] == me) { 
+            break; 
+        } 
+    } 
+    if (index < mpool_ranges_) { 
+        for (--mpool_ranges_; index < mpool_ranges_; ++index) { 
+            mpool_range_[index] = mpool_range_[index + 1]; 
+        } 
+    } 
+    if (mpool_ranges_ >= (uint16_t)MPOOL_RANGES) { 
+        INT_UNLOCK_();
+        return FALSE; 
+    } 
+    /* Insertion Sort by the Start Address */
+    index = mpool_ranges_; 
+    while ((index > (uint16_t)0) && (mpool_range_[index - 1]->start > me->start)) { 
+        mpool_range_[index] = mpool_range_[index - 1]; 
+        --index; 
+    } 
+    /* The Ranges must not Overlap */
+    if (((index > (uint16_t)0) && (mpool_range_[index - 1]->end >= me->start)) || 
+        ((index < mpool_ranges_) && (mpool_range_[index]->start <= me->end))) { 
+        while (index < mpool_ranges_) {     /* Undo the Shift */
+            mpool_range_[index] = mpool_range_[index + 1]; 
+            ++index; 
+        } 
+        INT_UNLOCK_();
+        return FAILURE; 
+    } 
+    mpool_range_[index] = me; 
+    ++mpool_ranges_; 
+    INT_UNLOCK_();
+    return TRUE; 
+}
+#endif  /* End of MPOOL_HEADERLESS_ENABLE */
+
+#ifdef MPOOL_LOCKFREE_ENABLE
+/***************************************************************************************
+*   Fields of the Tagged Head, see mpool_t. 
+***************************************************************************************/
+#define MPOOL_SLOT_MASK_    ((uint32_t)0x0000FFFF)
+#define MPOOL_TAG_MASK_     ((uint32_t)0xFFFF0000)
+#define MPOOL_TAG_ONE_      ((uint32_t)0x00010000)
+
+/***************************************************************************************
+*   mpool_block_() Implementation. Internal
+*   Return the Block (its Header) of the Slot, the Slot is 1-Based. 
+***************************************************************************************/
+static free_mblock_t *mpool_block_(mpool_t *me, uint32_t slot)
+{
+    return (free_mblock_t *)((uint8_t *)me->start + 
+        (slot - (uint32_t)1) * ((uint32_t)me->block_size + (uint32_t)MPOOL_HEADER)); 
+}
+
+/***************************************************************************************
+*   mpool_slot_() Implementation. Internal
+*   Return the Slot of the Block (its Header), the Slot is 1-Based. 
+***************************************************************************************/
+static uint32_t mpool_slot_(mpool_t *me, void_t *block)
+{
+    return (uint32_t)(((uint8_t *)block - (uint8_t *)me->start) / 
+        ((uint32_t)me->block_size + (uint32_t)MPOOL_HEADER)) + (uint32_t)1; 
+}
+
+/***************************************************************************************
+*   mpool_pop_() Implementation. Internal
+*   Pop the Head of the Free List, NULL if It is Empty. 
+***************************************************************************************/
+static free_mblock_t *mpool_pop_(mpool_t *me)
+{
+    uint32_t head; 
+    uint32_t next; 
+    free_mblock_t *free; 
+
+    /* Pop the Head, Retry when Another Caller Swapped It First */
+    head = MPOOL_LOAD_(&me->head); 
+    while ((head & MPOOL_SLOT_MASK_) != (uint32_t)0) { 
+        free = mpool_block_(me, head & MPOOL_SLOT_MASK_); 
+        /* The Link may be Stale if the Block is Gone, then the Tag Fails the Swap */
+        next = ((head + MPOOL_TAG_ONE_) & MPOOL_TAG_MASK_) | 
+               (MPOOL_LOAD_((uint32_t *)free) & MPOOL_SLOT_MASK_); 
+        if (MPOOL_CAS_(&me->head, &head, next)) { 
+            return free; 
+        } 
+    } 
+    return (free_mblock_t *)0; 
+}
+
+/***************************************************************************************
+*   mpool_take_() Implementation. Internal
+*   Reserve up to "n" Blocks from free_cnt before They are Popped, and Account the 
+*   Low Water-Mark. The free_cnt is Decremented before the Pop and Incremented after 
+*   the Push, so It never Counts More than the Free List Holds: a Reserved Block is 
+*   Always there to be Popped, and the Check of mpool_put() never Fails Falsely. 
+***************************************************************************************/
+static uint16_t mpool_take_(mpool_t *me, uint16_t n)
+{
+    uint16_t free; 
+    uint16_t count; 
+    uint16_t min; 
+
+    free = MPOOL_LOAD_(&me->free_cnt); 
+    do { 
+        count = (n < free) ? n : free; 
+        if (count == (uint16_t)0) { 
+            return (uint16_t)0; 
+        } 
+    } while (!MPOOL_CAS_(&me->free_cnt, &free, (uint16_t)(free - count))); 
+    free -= count; 
+
+    min = MPOOL_LOAD_(&me->min_cnt); 
+    while ((free < min) && !MPOOL_CAS_(&me->min_cnt, &min, free)) { 
+        /* "min" is Reloaded by the Failed Swap */
+    } 
+    return count; 
+}
+
+/***************************************************************************************
+*   mpool_push_() Implementation. Internal
+*   Push the Segment from "first" to "last" (Linked by the Slots) as the Head. 
+***************************************************************************************/
+static void_t mpool_push_(mpool_t *me, void_t *first, void_t *last, uint16_t count)
+{
+    uint32_t head; 
+    uint32_t slot; 
+
+    /* Retry when Another Caller Swapped It First */
+    slot = mpool_slot_(me, first); 
+    head = MPOOL_LOAD_(&me->head); 
+    do { 
+        MPOOL_STORE_((uint32_t *)last, head & MPOOL_SLOT_MASK_); 
+    } while (!MPOOL_CAS_(&me->head, &head, 
+                         ((head + MPOOL_TAG_ONE_) & MPOOL_TAG_MASK_) | slot)); 
+    MPOOL_ADD_(&me->free_cnt, count); 
+}
+#endif  /* End of MPOOL_LOCKFREE_ENABLE */
+
+#ifdef MPOOL_ELASTIC_ENABLE
+/***************************************************************************************
+*   Head of the Extent Borrowed from hpool, the MPOOL_ELASTIC_BATCH Blocks Follow It. 
+***************************************************************************************/
+typedef struct mpool_extent_tag
+{
+    struct mpool_extent_tag * next;     /* The Next (Older) Extent of the Pool */
+    void_t * end;                       /* The Last Block of the Extent */
+} mpool_extent_t;
+
+/* The Low Water-Mark of Free Blocks, an Extent can Go with One Batch Spare */
+#define MPOOL_LOW_WATER_    ((uint16_t)(2 * MPOOL_ELASTIC_BATCH))
+
+/* The Block (its Header) is in the Buffer of Pool ? */
+#define MPOOL_IN_BUFFER_(me_, block_)   \
+    (((me_)->start <= (void_t *)(block_)) && ((void_t *)(block_) <= (me_)->end))
+
+/* The Block (its Header) is in the Extent ? */
+#define MPOOL_IN_EXTENT_(extent_, block_)    \
+    (((void_t *)((extent_) + 1) <= (void_t *)(block_)) && ((void_t *)(block_) <= (extent_)->end))
+
+/***************************************************************************************
+*   mpool_extent_() Implementation. Internal
+*   The Extent which Holds the Block (its Header), 0 for the Buffer of Pool or None. 
+*   The Extent of a Block in Use is never Given Back, so the List is Walked Unlocked. 
+***************************************************************************************/
+static mpool_extent_t *mpool_extent_(mpool_t *me, void_t *block)
+{
+    mpool_extent_t *extent; 
+
+    if (MPOOL_IN_BUFFER_(me, block)) { 
+        return (mpool_extent_t *)0;     /* The Buffer of Pool, No Extent is Walked */
+    } 
+    for (extent = (mpool_extent_t *)me->extent; extent != (mpool_extent_t *)0; 
+         extent = extent->next) { 
+        if (MPOOL_IN_EXTENT_(extent, block)) { 
+            return extent; 
+        } 
+    } 
+    return (mpool_extent_t *)0; 
+}
+
+/***************************************************************************************
+*   mpool_within_() Implementation. Internal
+*   The Block (its Header) is in the Buffer of Pool, or in One of Its Extents ? 
+***************************************************************************************/
+static int16_t mpool_within_(mpool_t *me, void_t *block)
+{
+    if (MPOOL_IN_BUFFER_(me, block)) { 
+        return TRUE; 
+    } 
+    return (mpool_extent_(me, block) != (mpool_extent_t *)0) ? TRUE : FALSE; 
+}
+
+#define MPOOL_WITHIN_(me_, block_)  (mpool_within_((me_), (block_)) == TRUE)
+
+/***************************************************************************************
+*   mpool_unlink_() Implementation. Internal, Called with Lock, free_cnt > 0.
+*   Take a Free Block, from the Buffer of Pool First, then from the Extents, so the 
+*   Blocks of Extents Fall Free while the Pool is Calm. 
+***************************************************************************************/
+static free_mblock_t *mpool_unlink_(mpool_t *me)
+{
+    free_mblock_t *free; 
+
+    if (me->free != (void_t *)0) { 
+        free = (free_mblock_t *)me->free; 
+        me->free = (void_t *)free->next; 
+    } 
+    else { 
+        free = (free_mblock_t *)me->spare; 
+        me->spare = (void_t *)free->next; 
+        --me->spare_cnt; 
+    } 
+    return free; 
+}
+
+/***************************************************************************************
+*   mpool_link_() Implementation. Internal, Called with Lock.
+*   Link the Run of "count" Free Blocks from "first" to "last", All in the Buffer of 
+*   Pool or All in the Extents, into the Free List They Belong to. The Address is 
+*   Compared with the Buffer Only, No Extent is Walked. 
+***************************************************************************************/
+static void_t mpool_link_(mpool_t *me, void_t *first, void_t *last, uint16_t count)
+{
+    if (MPOOL_IN_BUFFER_(me, first)) { 
+        ((free_mblock_t *)last)->next = (free_mblock_t *)me->free; 
+        me->free = first; 
+    } 
+    else { 
+        ((free_mblock_t *)last)->next = (free_mblock_t *)me->spare; 
+        me->spare = first; 
+        me->spare_cnt += count; 
+    } 
+    me->free_cnt += count; 
+}
+
+/***************************************************************************************
+*   mpool_grow_() Implementation. Internal
+*   Borrow an Extent from hpool, and Splice Its Blocks into the Free List. The Heap 
+*   is Called and the Blocks are Linked Outside the Critical Section of the Pool, 
+*   which Re-checks the Free Blocks: when Another Caller has Grown the Pool to "need" 
+*   Meanwhile, the Extent is Given Back. 
+*   Return: 1 is True (Grown, or "need" Met Already), 0 is False (the Heap is 
+*           Exhausted), -1 is Failure (the Pool is Full)
+***************************************************************************************/
+static int16_t mpool_grow_(mpool_t *me, uint16_t need)
+{
+    int16_t  ret; 
+    uint16_t index; 
+    uint16_t stride; 
+    uint32_t size; 
+    mpool_extent_t *extent; 
+    free_mblock_t  *first; 
+    free_mblock_t  *block; 
+
+    INT_LOCK_KEY_
+
+    /* The Extent must Fit One Block of hpool, and the Counters must not Wrap */
+    stride = (uint16_t)(me->block_size + (uint16_t)MPOOL_HEADER); 
+    size = (uint32_t)sizeof(mpool_extent_t) + (uint32_t)stride * (uint32_t)MPOOL_ELASTIC_BATCH; 
+    ASSERT_REQUIRE(size <= (uint32_t)0xFFFF); 
+    if ((size > (uint32_t)0xFFFF) || 
+        ((uint32_t)me->total_cnt + (uint32_t)MPOOL_ELASTIC_BATCH > (uint32_t)0xFFFF)) { 
+        return FAILURE; 
+    } 
+
+    extent = (mpool_extent_t *)hpool_get((uint16_t)size); 
+    if (extent == (mpool_extent_t *)0) { 
+        return FALSE;   /* The Heap is Exhausted too */
+    } 
+
+    /* Chain the Blocks of Extent Together */
+    first = (free_mblock_t *)(extent + 1); 
+    block = first; 
+    for (index = (uint16_t)1; index < (uint16_t)MPOOL_ELASTIC_BATCH; ++index) { 
+        block->next = (free_mblock_t *)((uint8_t *)block + stride); 
+        block = block->next; 
+    } 
+    extent->end = (void_t *)block; 
+
+    INT_LOCK_();
+    if ((me->free_cnt >= need) || 
+        ((uint32_t)me->total_cnt + (uint32_t)MPOOL_ELASTIC_BATCH > (uint32_t)0xFFFF)) { 
+        /* Grown by Another Caller Meanwhile, or Full, the Extent is not Needed */
+        ret = (me->free_cnt >= need) ? TRUE : FAILURE; 
+        INT_UNLOCK_();
+        (void_t)hpool_put((void_t *)extent); 
+        return ret; 
+    } 
+    mpool_link_(me, (void_t *)first, (void_t *)block, (uint16_t)MPOOL_ELASTIC_BATCH); 
+    me->total_cnt  += (uint16_t)MPOOL_ELASTIC_BATCH; 
+    me->extent_cnt += (uint16_t)MPOOL_ELASTIC_BATCH; 
+    extent->next = (mpool_extent_t *)me->extent; 
+    me->extent = (void_t *)extent; 
+    me->calm = (uint32_t)0; 
+    INT_UNLOCK_();
+
+    SPYER_MPOOL("MPool %X Borrows Extent %X of %d Blocks from HPool, Total %d. TimeStamp %d", \
+                 me, extent, MPOOL_ELASTIC_BATCH, me->total_cnt, ticks_get()); 
+    return TRUE; 
+}
+
+/***************************************************************************************
+*   mpool_calm_() Implementation. Internal, Called with Lock.
+*   Return TRUE when the Pool has Extents, and Its Free Blocks have Stayed above the 
+*   Low Water-Mark for MPOOL_ELASTIC_PERIOD Ticks. 
+***************************************************************************************/
+static int16_t mpool_calm_(mpool_t *me)
+{
+    uint32_t now; 
+
+    if ((me->extent == (void_t *)0) || (me->free_cnt < MPOOL_LOW_WATER_)) { 
+        me->calm = (uint32_t)0; 
+        return FALSE; 
+    } 
+    now = ticks_get(); 
+    if (me->calm == (uint32_t)0) { 
+        me->calm = (now != (uint32_t)0) ? now : (uint32_t)1;    /* 0 is Reserved */
+        return FALSE; 
+    } 
+    return ((uint32_t)(now - me->calm) >= (uint32_t)MPOOL_ELASTIC_PERIOD) ? TRUE : FALSE; 
+}
+#else
+#define MPOOL_WITHIN_(me_, block_)  (((me_)->start <= (block_)) && ((block_) <= (me_)->end))
+#endif  /* End of MPOOL_ELASTIC_ENABLE */
 
 /***************************************************************************************
 *   mpool_init() Implementation.
@@ -57,10 +402,16 @@ int16_t mpool_init(mpool_t *me, void_t *begin, uint32_t size, uint16_t block_siz
 {
     free_mblock_t *free;
     uint16_t n;
+#ifdef MPOOL_LOCKFREE_ENABLE
+    uint32_t slot; 
+#endif  /* End of MPOOL_LOCKFREE_ENABLE */
+#ifdef MPOOL_HEADERLESS_ENABLE
+    int16_t  ret; 
+#endif  /* End of MPOOL_HEADERLESS_ENABLE */
 
     ASSERT_REQUIRE(me != (mpool_t *)0);
     ASSERT_REQUIRE(begin != (void_t *)0);
-    ASSERT_REQUIRE((begin & (sizeof(void_t *) - 1)) == (void_t *)0); 
+    ASSERT_REQUIRE(((size_t)begin & (sizeof(void_t *) - 1)) == (size_t)0); 
     ASSERT_REQUIRE(size != 0);
     /* The block_size must not be too Close to the Top of the Dynamic Range   */
     /* Such as, If the block_size Value is 65533, 65533 + 4 will equal to 1,  */ 
@@ -72,7 +423,7 @@ int16_t mpool_init(mpool_t *me, void_t *begin, uint32_t size, uint16_t block_siz
     if (size == 0) {
         return FAILURE; 
     } 
-    if ((uint16_t)(block_size + (uint16_t)sizeof(void_t *)) > block_size) { 
+    if ((uint16_t)(block_size + (uint16_t)sizeof(void_t *)) <= block_size) { 
         return FAILURE; 
     }
 
@@ -85,9 +436,12 @@ int16_t mpool_init(mpool_t *me, void_t *begin, uint32_t size, uint16_t block_siz
         ++n;
     }
     block_size  = me->block_size;    /* Use the Rounded-Up Value from Here On */
+#ifndef MPOOL_HEADERLESS_ENABLE
     /* Reserve the Storage Location  for Remeber the Memory Pool which Block */
     /* is Allocated from, Size is (sizeof (void_t *). */
     block_size += (uint16_t)sizeof (void_t *); 
+    ++n;    /* The Stride of Blocks Counts the Header too */
+#endif  /* End of MPOOL_HEADERLESS_ENABLE */
 
     /* The Whole Pool Buffer must Fit at least One Round Up Block */
     ASSERT_REQUIRE(size >= (uint32_t)block_size); 
@@ -113,8 +467,38 @@ int16_t mpool_init(mpool_t *me, void_t *begin, uint32_t size, uint16_t block_siz
 
     me->free_cnt = me->total_cnt;           /* Store Number of Free Blocks */
     me->min_cnt  = me->total_cnt;           /* The Minimum Number of Free Blocks */
+#ifdef MPOOL_ELASTIC_ENABLE
+    me->extent   = (void_t *)0;             /* Nothing Borrowed from hpool */
+    me->spare    = (void_t *)0; 
+    me->spare_cnt  = (uint16_t)0; 
+    me->extent_cnt = (uint16_t)0; 
+    me->calm     = (uint32_t)0; 
+#endif  /* End of MPOOL_ELASTIC_ENABLE */
+
+#ifdef MPOOL_HEADERLESS_ENABLE
+    /* Register the Range for Finding the Owner of Block */
+    ret = mpool_register_(me); 
+    ASSERT_REQUIRE(ret == TRUE);    /* The Range Table is Full, or the Pools Overlap */
+    if (ret != TRUE) { 
+        return FAILURE; 
+    } 
+#endif  /* End of MPOOL_HEADERLESS_ENABLE */
 
-    SPYER_MPOOL("MPool %X is Initialized, Start %X, Block Size %d, Total %d.", \\
+#ifdef MPOOL_LOCKFREE_ENABLE
+    /* The Slot must Fit in the Tagged Head */
+    ASSERT_REQUIRE(me->total_cnt < (uint16_t)MPOOL_SLOT_MASK_); 
+    if (me->total_cnt >= (uint16_t)MPOOL_SLOT_MASK_) { 
+        return FAILURE; 
+    } 
+    /* Relink the Free List by the Slots, the Header of Block Holds the Next Slot */
+    for (slot = (uint32_t)1; slot <= (uint32_t)me->total_cnt; ++slot) { 
+        *((uint32_t *)mpool_block_(me, slot)) = 
+            (slot < (uint32_t)me->total_cnt) ? (slot + (uint32_t)1) : (uint32_t)0; 
+    } 
+    me->head = (uint32_t)1;     /* Tag 0, the First Block */
+#endif  /* End of MPOOL_LOCKFREE_ENABLE */
+
+    SPYER_MPOOL("MPool %X is Initialized, Start %X, Block Size %d, Total %d.", \
                  me, begin, me->block_size, me->total_cnt); 
 
     return TRUE; 
@@ -134,32 +518,58 @@ void_t *mpool_get(mpool_t *me)
 
     free = (free_mblock_t *)0;     /* No Free Block Available */
 
+#ifdef MPOOL_LOCKFREE_ENABLE
+    if (mpool_take_(me, (uint16_t)1) != (uint16_t)0) { 
+        free = mpool_pop_(me); 
+    } 
+#else
     INT_LOCK_KEY_
+#ifdef MPOOL_ELASTIC_ENABLE
+    if (me->free_cnt == (uint16_t)0) { 
+        /* Exhausted, Borrow a Batch from hpool */
+        (void_t)mpool_grow_(me, (uint16_t)1); 
+    } 
+#endif  /* End of MPOOL_ELASTIC_ENABLE */
     INT_LOCK_();
     if (me->free_cnt > (uint16_t)0) {       /* Free Block Available ? Block is Depletion */
+#ifdef MPOOL_ELASTIC_ENABLE
+        free = mpool_unlink_(me);           /* Get the Free Block, the Buffer First */
+#else
         free = (free_mblock_t *)me->free;   /* Get the Free Block */
         /* Adjust List Head to the Next Free Block */
         me->free = (void_t *)free->next;
+#endif  /* End of MPOOL_ELASTIC_ENABLE */
         if (--me->free_cnt < me->min_cnt) { 
             /* One Less Block */
             me->min_cnt = me->free_cnt;     /* Remember the Minimum so far */
         }
+#ifdef MPOOL_ELASTIC_ENABLE
+        if (me->free_cnt < MPOOL_LOW_WATER_) { 
+            me->calm = (uint32_t)0;         /* Below the Low Water-Mark */
+        } 
+#endif  /* End of MPOOL_ELASTIC_ENABLE */
     }
     INT_UNLOCK_();
+#endif  /* End of MPOOL_LOCKFREE_ENABLE */
 
     ASSERT_ENSURE(free != (free_mblock_t *)0); 
     if (free == (free_mblock_t *)0) { 
         return NULL; 
     } 
 
-    /* Backup the Memory Pool Pointer */
-    *((uint32_t *)free) = (uint32_t)me;     /* 32 Bits Address */ 
-
-    SPYER_MPOOL("Block %X is Obtained from MPool %X, Free %d, Min %d. TimeStamp %d", \\ 
+    SPYER_MPOOL("Block %X is Obtained from MPool %X, Free %d, Min %d. TimeStamp %d", \
                 free, me, me->free_cnt, me->min_cnt, ticks_get()); 
 
+#ifdef MPOOL_HEADERLESS_ENABLE
+    /* The Owner is Found by the Address */
+    return (void_t *)free;
+#else
+    /* Backup the Memory Pool Pointer */
+    *((mpool_t **)free) = me; 
+
     /* Return the Block or NULL Pointer to the Caller */
     return (void_t *)(++free);
+#endif  /* End of MPOOL_HEADERLESS_ENABLE */
 }
 
 /***************************************************************************************
@@ -168,6 +578,9 @@ void_t *mpool_get(mpool_t *me)
 int16_t mpool_put(void_t *block)
 {
     mpool_t * mpool; 
+#ifdef MPOOL_ELASTIC_ENABLE
+    int16_t   calm; 
+#endif  /* End of MPOOL_ELASTIC_ENABLE */
 
     ASSERT_REQUIRE(block != ( void_t *)0);
     if (block == ( void_t *)0) { 
@@ -175,19 +588,31 @@ int16_t mpool_put(void_t *block)
     } 
 
     /* Get the Memory Pool Pointer */
-    ((uint32_t *)block)--; 
-    mpool = (mpool_t *)(*((uint32_t *)block));  /* 32 Bits Address */
+#ifdef MPOOL_HEADERLESS_ENABLE
+    mpool = mpool_owner(block); 
+#else
+    block = (void_t *)((free_mblock_t *)block - 1); 
+    mpool = *((mpool_t **)block); 
+#endif  /* End of MPOOL_HEADERLESS_ENABLE */
     ASSERT_REQUIRE(mpool != (mpool_t *)0); 
     if (mpool == (mpool_t *)0) { 
         return FAILURE; 
     } 
 
     /* Must be in Range */
-    ASSERT_REQUIRE((mpool->start <= block) && (block <= mpool->end));  
-    if ((mpool->start > block) || (block > mpool->end)) { 
+    ASSERT_REQUIRE(MPOOL_WITHIN_(mpool, block));  
+    if (!MPOOL_WITHIN_(mpool, block)) { 
         return FAILURE; 
     }
 
+#ifdef MPOOL_LOCKFREE_ENABLE
+    /* Free Blocks must be < total_cnt */
+    if (MPOOL_LOAD_(&mpool->free_cnt) >= mpool->total_cnt) { 
+        ASSERT_ERROR();
+        return FAILURE; 
+    } 
+    mpool_push_(mpool, block, block, (uint16_t)1); 
+#else
     INT_LOCK_KEY_
     INT_LOCK_();
     /* Free Blocks must be < total_cnt */
@@ -196,18 +621,258 @@ int16_t mpool_put(void_t *block)
         ASSERT_ERROR();
         return FAILURE; 
     }
+#ifdef MPOOL_ELASTIC_ENABLE
+    /* Link into the Free List of the Buffer, or of the Extents */
+    mpool_link_(mpool, block, block, (uint16_t)1); 
+    calm = mpool_calm_(mpool); 
+#else
     /* Link into Free List */
     ((free_mblock_t *)block)->next = (free_mblock_t *)mpool->free;
     mpool->free = block;           /* Set as New Head of the Free List */
     ++mpool->free_cnt;             /* One more Free Block in this Pool */
+#endif  /* End of MPOOL_ELASTIC_ENABLE */
     INT_UNLOCK_();
+#endif  /* End of MPOOL_LOCKFREE_ENABLE */
 
-    SPYER_MPOOL("Block %X is Put Back into MPool %X, Free %d. TimeStamp %d", \\ 
+    SPYER_MPOOL("Block %X is Put Back into MPool %X, Free %d. TimeStamp %d", \
                  block, mpool, mpool->free_cnt, ticks_get()); 
 
+#ifdef MPOOL_ELASTIC_ENABLE
+    if (calm == TRUE) { 
+        /* Calm for a Period, Give an Extent Back to hpool */
+        (void_t)mpool_trim(mpool); 
+    } 
+#endif  /* End of MPOOL_ELASTIC_ENABLE */
     return TRUE; 
 }
 
+/***************************************************************************************
+*   mpool_get_n() Implementation.
+***************************************************************************************/
+uint16_t mpool_get_n(mpool_t *me, uint16_t n, void_t *out[])
+{
+    uint16_t count; 
+    uint16_t index; 
+    free_mblock_t *free;
+
+    ASSERT_REQUIRE((me != (mpool_t *)0) && (out != (void_t **)0));
+    if ((me == (mpool_t *)0) || (out == (void_t **)0)) { 
+        return (uint16_t)0; 
+    }
+
+#ifdef MPOOL_LOCKFREE_ENABLE
+    /* Reserve the Blocks at Once, then Pop Them One by One */
+    count = mpool_take_(me, n); 
+    for (index = (uint16_t)0; index < count; ++index) { 
+        free = mpool_pop_(me); 
+        ASSERT_ENSURE(free != (free_mblock_t *)0); 
+        out[index] = (void_t *)free; 
+    } 
+#else
+    INT_LOCK_KEY_
+#ifdef MPOOL_ELASTIC_ENABLE
+    /* Running Short, Borrow Batches from hpool until Enough */
+    while ((me->free_cnt < n) && (mpool_grow_(me, n) == TRUE)) { 
+        /* One More Extent Spliced */
+    } 
+#endif  /* End of MPOOL_ELASTIC_ENABLE */
+    INT_LOCK_();
+    count = (n < me->free_cnt) ? n : me->free_cnt; 
+#ifdef MPOOL_ELASTIC_ENABLE
+    /* Take the Blocks of the Buffer First, then of the Extents */
+    for (index = (uint16_t)0; index < count; ++index) { 
+        out[index] = (void_t *)mpool_unlink_(me); 
+    } 
+#else
+    /* Splice the Segment of "count" Blocks off the Head */
+    free = (free_mblock_t *)me->free; 
+    for (index = (uint16_t)0; index < count; ++index) { 
+        out[index] = (void_t *)free; 
+        free = free->next; 
+    } 
+    me->free = (void_t *)free; 
+#endif  /* End of MPOOL_ELASTIC_ENABLE */
+    me->free_cnt -= count; 
+    if (me->free_cnt < me->min_cnt) { 
+        me->min_cnt = me->free_cnt;     /* Remember the Minimum so far */
+    } 
+#ifdef MPOOL_ELASTIC_ENABLE
+    if (me->free_cnt < MPOOL_LOW_WATER_) { 
+        me->calm = (uint32_t)0;         /* Below the Low Water-Mark */
+    } 
+#endif  /* End of MPOOL_ELASTIC_ENABLE */
+    INT_UNLOCK_();
+#endif  /* End of MPOOL_LOCKFREE_ENABLE */
+
+#ifndef MPOOL_HEADERLESS_ENABLE
+    /* Backup the Memory Pool Pointer, Outside the Critical Section */
+    for (index = (uint16_t)0; index < count; ++index) { 
+        free = (free_mblock_t *)out[index]; 
+        *((mpool_t **)free) = me; 
+        out[index] = (void_t *)(++free); 
+    } 
+#endif  /* End of MPOOL_HEADERLESS_ENABLE */
+
+    SPYER_MPOOL("%d Blocks are Obtained from MPool %X, Free %d, Min %d. TimeStamp %d", \
+                count, me, me->free_cnt, me->min_cnt, ticks_get()); 
+    return count; 
+}
+
+/***************************************************************************************
+*   mpool_put_n() Implementation.
+***************************************************************************************/
+int16_t mpool_put_n(void_t *blocks[], uint16_t n)
+{
+    int16_t   ret; 
+    uint16_t  index; 
+    uint16_t  count; 
+    void_t  * first; 
+    void_t  * last; 
+    void_t  * block; 
+    mpool_t * mpool; 
+    mpool_t * owner; 
+#ifdef MPOOL_ELASTIC_ENABLE
+    int16_t   calm; 
+#endif  /* End of MPOOL_ELASTIC_ENABLE */
+
+    ASSERT_REQUIRE((blocks != (void_t **)0) || (n == (uint16_t)0));
+    if ((blocks == (void_t **)0) && (n != (uint16_t)0)) { 
+        return FAILURE; 
+    } 
+
+    ret = TRUE; 
+    index = (uint16_t)0; 
+    while (index < n) { 
+        /* Link the Run of the Blocks of the Same Pool, Outside the Critical Section */
+        first = (void_t *)0; 
+        last  = (void_t *)0; 
+        mpool = (mpool_t *)0; 
+        count = (uint16_t)0; 
+        for (; index < n; ++index) { 
+            block = blocks[index]; 
+            ASSERT_REQUIRE(block != (void_t *)0);
+#ifdef MPOOL_HEADERLESS_ENABLE
+            owner = (block != (void_t *)0) ? mpool_owner(block) : (mpool_t *)0; 
+#else
+            owner = (mpool_t *)0; 
+            if (block != (void_t *)0) { 
+                block = (void_t *)((free_mblock_t *)block - 1); 
+                owner = *((mpool_t **)block); 
+            } 
+#endif  /* End of MPOOL_HEADERLESS_ENABLE */
+            ASSERT_REQUIRE(owner != (mpool_t *)0); 
+            if ((owner == (mpool_t *)0) || !MPOOL_WITHIN_(owner, block)) { 
+                ASSERT_ERROR();     /* Must be in Range */
+                ret = FAILURE; 
+                continue; 
+            } 
+            if ((mpool != (mpool_t *)0) && (owner != mpool)) { 
+                break;      /* The Next Run */
+            } 
+#ifdef MPOOL_ELASTIC_ENABLE
+            if ((first != (void_t *)0) && 
+                (MPOOL_IN_BUFFER_(owner, block) != MPOOL_IN_BUFFER_(owner, first))) { 
+                break;      /* The Blocks of Extents Run apart from the Buffer */
+            } 
+#endif  /* End of MPOOL_ELASTIC_ENABLE */
+            if (first == (void_t *)0) { 
+                first = block; 
+                mpool = owner; 
+            } 
+            else { 
+#ifdef MPOOL_LOCKFREE_ENABLE
+                *((uint32_t *)last) = mpool_slot_(mpool, block); 
+#else
+                ((free_mblock_t *)last)->next = (free_mblock_t *)block; 
+#endif  /* End of MPOOL_LOCKFREE_ENABLE */
+            } 
+            last = block; 
+            ++count; 
+        } 
+        if (count == (uint16_t)0) { 
+            continue; 
+        } 
+
+#ifdef MPOOL_LOCKFREE_ENABLE
+        /* Free Blocks must be <= total_cnt */
+        if ((uint32_t)MPOOL_LOAD_(&mpool->free_cnt) + (uint32_t)count > (uint32_t)mpool->total_cnt) { 
+            ASSERT_ERROR();
+            ret = FAILURE; 
+            continue; 
+        } 
+        mpool_push_(mpool, first, last, count); 
+#else
+        {
+            INT_LOCK_KEY_
+            INT_LOCK_();
+            /* Free Blocks must be <= total_cnt */
+            if ((uint32_t)mpool->free_cnt + (uint32_t)count > (uint32_t)mpool->total_cnt) { 
+                INT_UNLOCK_();
+                ASSERT_ERROR();
+                ret = FAILURE; 
+                continue; 
+            } 
+#ifdef MPOOL_ELASTIC_ENABLE
+            /* Splice the Run into the Free List of the Buffer, or of the Extents */
+            mpool_link_(mpool, first, last, count); 
+            calm = mpool_calm_(mpool); 
+#else
+            /* Splice the Run into Free List */
+            ((free_mblock_t *)last)->next = (free_mblock_t *)mpool->free; 
+            mpool->free = first; 
+            mpool->free_cnt += count; 
+#endif  /* End of MPOOL_ELASTIC_ENABLE */
+            INT_UNLOCK_();
+        }
+#endif  /* End of MPOOL_LOCKFREE_ENABLE */
+
+        SPYER_MPOOL("%d Blocks are Put Back into MPool %X, Free %d. TimeStamp %d", \
+                     count, mpool, mpool->free_cnt, ticks_get()); 
+#ifdef MPOOL_ELASTIC_ENABLE
+        if (calm == TRUE) { 
+            /* Calm for a Period, Give an Extent Back to hpool */
+            (void_t)mpool_trim(mpool); 
+        } 
+#endif  /* End of MPOOL_ELASTIC_ENABLE */
+    } 
+    return ret; 
+}
+
+/***************************************************************************************
+*   mpool_owner() Implementation.
+***************************************************************************************/
+mpool_t *mpool_owner(void_t *block)
+{
+#ifdef MPOOL_HEADERLESS_ENABLE
+    uint16_t low; 
+    uint16_t high; 
+    uint16_t mid; 
+
+    /* Binary Search for the Last Pool Starts at or before the Block */
+    low  = (uint16_t)0; 
+    high = mpool_ranges_; 
+    while (low < high) { 
+        mid = (uint16_t)((low + high) >> 1); 
+        if (mpool_range_[mid]->start <= block) { 
+            low = (uint16_t)(mid + 1); 
+        } 
+        else { 
+            high = mid; 
+        } 
+    } 
+    if ((low == (uint16_t)0) || (mpool_range_[low - 1]->end < block)) { 
+        return (mpool_t *)0; 
+    } 
+    return mpool_range_[low - 1]; 
+#else
+    ASSERT_REQUIRE(block != (void_t *)0);
+    if (block == (void_t *)0) { 
+        return (mpool_t *)0; 
+    } 
+    return *((mpool_t **)((free_mblock_t *)block - 1)); 
+#endif  /* End of MPOOL_HEADERLESS_ENABLE */
+}
+
 /***************************************************************************************
 *   mpool_all_recycled() Implementation.
 ***************************************************************************************/
@@ -220,7 +885,6 @@ int16_t mpool_all_recycled(mpool_t *me)
     return  TRUE; 
 }
 
-#ifdef SPYER_MPOOL_ENABLE   /* Spy Debuger Enabled */
 /***************************************************************************************
 *   mpool_margin() Implementation.
 ***************************************************************************************/
@@ -233,12 +897,78 @@ uint16_t mpool_margin(mpool_t *me)
         return (uint16_t)0; 
     }
 
+#ifdef MPOOL_LOCKFREE_ENABLE
+    margin = MPOOL_LOAD_(&me->min_cnt); 
+#else
     INT_LOCK_KEY_
     INT_LOCK_();
     margin = (uint16_t)(me->min_cnt);
     INT_UNLOCK_();
+#endif  /* End of MPOOL_LOCKFREE_ENABLE */
 
     return margin;
 }
-#endif  /* End of SPYER_MPOOL_ENABLE */
+
+#ifdef MPOOL_ELASTIC_ENABLE
+/***************************************************************************************
+*   mpool_trim() Implementation.
+***************************************************************************************/
+int16_t mpool_trim(mpool_t *me)
+{
+    int16_t  ret; 
+    int16_t  put; 
+    uint16_t count; 
+    mpool_extent_t *extent; 
+    mpool_extent_t *next; 
+
+    INT_LOCK_KEY_
+
+    ASSERT_REQUIRE(me != (mpool_t *)0);
+    if (me == (mpool_t *)0) { 
+        return FAILURE; 
+    }
+
+    INT_LOCK_();
+    extent = (mpool_extent_t *)me->extent; 
+    if (extent == (mpool_extent_t *)0) { 
+        INT_UNLOCK_();
+        return FALSE; 
+    } 
+    /* All the Blocks of Extents must be Free, and the Buffer Keeps a Batch Spare */
+    count = me->extent_cnt; 
+    if ((me->spare_cnt != count) || 
+        ((uint16_t)(me->free_cnt - count) < (uint16_t)MPOOL_ELASTIC_BATCH)) { 
+        me->calm = (uint32_t)0;     /* Still in Use, Try again after Another Period */
+        INT_UNLOCK_();
+        return FALSE; 
+    } 
+    /* The Free List of Extents Holds Their Blocks Only, Drop It Whole */
+    me->extent = (void_t *)0; 
+    me->spare  = (void_t *)0; 
+    me->spare_cnt  = (uint16_t)0; 
+    me->extent_cnt = (uint16_t)0; 
+    me->free_cnt  -= count; 
+    me->total_cnt -= count; 
+    if (me->free_cnt < me->min_cnt) { 
+        me->min_cnt = me->free_cnt; 
+    } 
+    me->calm = (uint32_t)0; 
+    INT_UNLOCK_();
+
+    /* Give the Extents Back, Outside the Critical Section of the Pool */
+    ret = TRUE; 
+    for (; extent != (mpool_extent_t *)0; extent = next) { 
+        next = extent->next; 
+        put = hpool_put((void_t *)extent); 
+        ASSERT_ENSURE(put == TRUE); 
+        if (put != TRUE) { 
+            ret = put; 
+        } 
+    } 
+
+    SPYER_MPOOL("MPool %X Gives %d Blocks of Extents Back to HPool, Total %d. TimeStamp %d", \
+                 me, count, me->total_cnt, ticks_get()); 
+    return ret; 
+}
+#endif  /* End of MPOOL_ELASTIC_ENABLE */
 
@@ -47,6 +47,62 @@ extern "C" {
     #define MPOOL_EXT   extern
 #endif
 
+#ifdef MPOOL_HEADERLESS_ENABLE
+    #ifndef MPOOL_RANGES
+        /*******************************************************************************
+        *   This Constant Defines the Maximum Number of Memory Pools, whose Ranges are 
+        *   Registered for Finding the Owner of Block. 
+        *******************************************************************************/
+        #define MPOOL_RANGES    16      /* Default is 16 */
+    #endif      /* End of MPOOL_RANGES */
+#endif  /* End of MPOOL_HEADERLESS_ENABLE */
+
+#ifdef MPOOL_ELASTIC_ENABLE
+    #ifndef MPOOL_ELASTIC_BATCH
+        /*******************************************************************************
+        *   This Constant Defines the Number of Blocks Borrowed from hpool at Once 
+        *   when the Pool is Exhausted, the Extent must Fit One Block of hpool. 
+        *******************************************************************************/
+        #define MPOOL_ELASTIC_BATCH     8       /* Default is 8 */
+    #endif      /* End of MPOOL_ELASTIC_BATCH */
+    #ifndef MPOOL_ELASTIC_PERIOD
+        /*******************************************************************************
+        *   This Constant Defines the Ticks which the Free Blocks must Stay above the 
+        *   Low Water-Mark (2 * MPOOL_ELASTIC_BATCH), before the Extents are Given Back. 
+        *******************************************************************************/
+        #define MPOOL_ELASTIC_PERIOD    100     /* Default is 100 */
+    #endif      /* End of MPOOL_ELASTIC_PERIOD */
+    #ifdef MPOOL_LOCKFREE_ENABLE
+        #error "MPOOL_ELASTIC_ENABLE can not be Used with MPOOL_LOCKFREE_ENABLE"
+    #endif
+    #ifdef MPOOL_HEADERLESS_ENABLE
+        #error "MPOOL_ELASTIC_ENABLE Requires the Block Header, not MPOOL_HEADERLESS_ENABLE"
+    #endif
+#endif  /* End of MPOOL_ELASTIC_ENABLE */
+
+#ifndef MPOOL_BATCH
+    /***********************************************************************************
+    *   This Constant Defines the Number of Blocks Handled in One Batch, by the 
+    *   Callers which Collect the Blocks on the Stack for mpool_get_n() and 
+    *   mpool_put_n(), Such as echain_flush() and epool_release_n(). 
+    ***********************************************************************************/
+    #define MPOOL_BATCH     16      /* Default is 16 */
+#endif      /* End of MPOOL_BATCH */
+
+/***************************************************************************************
+*   Size of the Header before Every Block, which Remembers the Owner Pool. 
+*
+*   Without the Header (MPOOL_HEADERLESS_ENABLE), mpool_put() Finds the Owner by the 
+*   Address of Block in the Range Table of Pools, so the Same Buffer Holds More 
+*   Blocks, Such as 1/3 More of the chain_t (Three Pointers). 
+*   Size the Buffer of Pool by ((block_size + MPOOL_HEADER) * Amount). 
+***************************************************************************************/
+#ifdef MPOOL_HEADERLESS_ENABLE
+    #define MPOOL_HEADER    0
+#else
+    #define MPOOL_HEADER    sizeof(void_t *)
+#endif  /* End of MPOOL_HEADERLESS_ENABLE */
+
 /***************************************************************************************
 *   Native Memory Pool
 *
@@ -69,6 +125,18 @@ typedef struct mpool_tag
     void_t * start;     /* Start Block of the Memory Managed by this Memory Pool */
     void_t * end;       /* End   Block of the Memory Managed by this Memory Pool */
     void_t * free;      /* The Head of the Linked List of Free Blocks */
+#ifdef MPOOL_LOCKFREE_ENABLE
+    /***********************************************************************************
+    *   Tagged Head of the Lock-Free Free List, which Replaces "free". 
+    *
+    *   The Low 16 Bits are the Slot of the Head Block (Index Plus 1, 0 is Empty), the 
+    *   High 16 Bits are the Tag Increased by Every Successful Swap, so the Stale Head 
+    *   Read by a Preempted Caller Never Compares Equal (the ABA Problem). The Head 
+    *   Fits in 32 Bits, so the Single-Word Compare-And-Swap (LDREX/STREX on Cortex-M3 
+    *   and Later, CMPXCHG on the Host) is Enough on Both the 32 and 64 Bits Cores. 
+    ***********************************************************************************/
+    uint32_t volatile head; 
+#endif  /* End of MPOOL_LOCKFREE_ENABLE */
     uint16_t block_size;    /* Block Size (in Bytes) */
     uint16_t total_cnt;     /* Total Number of Blocks */
     uint16_t free_cnt;      /* Number of Free Blocks Remaining */
@@ -79,8 +147,43 @@ typedef struct mpool_tag
     *   a Valuable Information for Sizing Memory Pools.
     ***********************************************************************************/
     uint16_t min_cnt;
+#ifdef MPOOL_ELASTIC_ENABLE
+    /***********************************************************************************
+    *   Extents Borrowed from hpool when the Pool is Exhausted. 
+    *
+    *   "extent" is the List of Borrowed Extents (the Newest First), Each Holds 
+    *   MPOOL_ELASTIC_BATCH Blocks after Its Head. The Free Blocks of Extents are 
+    *   Kept in Their Own Free List "spare", "spare_cnt" of the "extent_cnt" Blocks 
+    *   of Extents are Free, and "free_cnt" Counts Both Lists. "calm" is the Tick 
+    *   when the Free Blocks Rose above the Low Water-Mark, 0 when They are below It. 
+    ***********************************************************************************/
+    void_t * extent; 
+    void_t * spare; 
+    uint16_t spare_cnt; 
+    uint16_t extent_cnt; 
+    uint32_t calm; 
+#endif  /* End of MPOOL_ELASTIC_ENABLE */
 } mpool_t;
 
+#ifdef MPOOL_LOCKFREE_ENABLE
+/***************************************************************************************
+*   Atomic Access of the Lock-Free Memory Pool. 
+*
+*   The "free_cnt" and "min_cnt" are Maintained with the Atomics too, so They are 
+*   Exact when the Pool is Quiet, and never Count More than the Free List Holds. 
+***************************************************************************************/
+#if defined(__GNUC__)
+    #define MPOOL_LOAD_(ptr_)           __atomic_load_n((ptr_), __ATOMIC_ACQUIRE)
+    #define MPOOL_STORE_(ptr_, val_)    __atomic_store_n((ptr_), (val_), __ATOMIC_RELAXED)
+    #define MPOOL_CAS_(ptr_, old_, new_)    \
+        __atomic_compare_exchange_n((ptr_), (old_), (new_), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+    #define MPOOL_ADD_(ptr_, val_)      __atomic_add_fetch((ptr_), (val_), __ATOMIC_RELEASE)
+    #define MPOOL_SUB_(ptr_, val_)      __atomic_sub_fetch((ptr_), (val_), __ATOMIC_RELAXED)
+#else
+    #error "MPOOL_LOCKFREE_ENABLE Requires the __atomic Builtins of GCC"
+#endif
+#endif  /* End of MPOOL_LOCKFREE_ENABLE */
+
 /***************************************************************************************
 *   Structure Representing a Free Block in the Native Memory Pool
 ***************************************************************************************/
@@ -89,6 +192,16 @@ typedef struct free_mblock_tag
     struct free_mblock_tag *next;
 }free_mblock_t;
 
+/***************************************************************************************
+*   The Pool which the Block is Obtained from, Remembered in the Header of Block 
+*   by mpool_get(), or Found by mpool_owner() without the Header. 
+***************************************************************************************/
+#ifdef MPOOL_HEADERLESS_ENABLE
+    #define MPOOL_OWNER(block_)     mpool_owner(block_)
+#else
+    #define MPOOL_OWNER(block_)     (*((mpool_t **)((free_mblock_t *)(block_) - 1)))
+#endif  /* End of MPOOL_HEADERLESS_ENABLE */
+
 /***************************************************************************************
 *   Initializes the Native Memory Pool
 *
@@ -139,6 +252,9 @@ typedef struct free_mblock_tag
 *             ("block_size" + sizeof(void_t *))*(Blocks Amount you Need). 
 *         (3) The Whole Pool Buffer must Fit at least One Block. 
 *         (4) Must be Called Exactly once before the Memory Pool can be Used. 
+*         (5) With MPOOL_HEADERLESS_ENABLE, the Range Table Keeps the Pointer "me", 
+*             so the mpool_t must not be an Automatic (Stack) Variable. Calling It 
+*             again with the Same "me" Moves the Pool in the Table. 
 ***************************************************************************************/
 MPOOL_EXT int16_t mpool_init(mpool_t *me, void_t *begin, uint32_t size, uint16_t block_size);
 
@@ -159,10 +275,15 @@ MPOOL_EXT int16_t mpool_init(mpool_t *me, void_t *begin, uint32_t size, uint16_t
 *   (3) This Function can be Called from Any Task Level or ISR Level.
 *   (4) The mpool_get() Function Uses Internally a Critical Section, so You should 
 *       be Careful not to Call it within a Critical Section when Nesting of 
-*       Critical Section is not Supported.
+*       Critical Section is not Supported. With MPOOL_LOCKFREE_ENABLE It Locks 
+*       Nothing, and Concurrent Callers on Different Cores Proceed in Parallel. 
 *   (5) The Obtained Block must be Put Back to the Same Memory Pool which it is 
 *       Allocated from. The Originated Memory Pool Information is Stored in the 
-*       Returned Pointer Minus sizeof(void_t *). 
+*       Returned Pointer Minus sizeof(void_t *), or Found by the Address without 
+*       the Header (MPOOL_HEADERLESS_ENABLE). 
+*   (6) With MPOOL_ELASTIC_ENABLE, the Exhausted Pool Borrows MPOOL_ELASTIC_BATCH 
+*       Blocks from hpool (which must be Initialized), NULL is Returned Only when 
+*       the Heap is Exhausted too. 
 ***************************************************************************************/
 MPOOL_EXT void_t *mpool_get(mpool_t *me);
 
@@ -180,9 +301,56 @@ MPOOL_EXT void_t *mpool_get(mpool_t *me);
 *   (3) The mpool_put() Function Uses Internally a Critical Section, so You should 
 *       be Careful not to Call it from within a Critical Section when Nesting of 
 *       Critical Section is not Supported.
+*   (4) With MPOOL_ELASTIC_ENABLE, It Calls mpool_trim() when the Free Blocks have 
+*       Stayed above the Low Water-Mark for MPOOL_ELASTIC_PERIOD Ticks. 
 ***************************************************************************************/
 MPOOL_EXT int16_t mpool_put(void_t *block);
 
+/***************************************************************************************
+*   Obtains Several Memory Blocks from a Memory Pool.
+*
+*   Description: Obtains up to "n" Memory Blocks from a Memory Pool, the Segment of 
+*                the Free List is Spliced off in One Critical Section. 
+*   Argument: me -- Pointer to the mpool_t from which the Blocks are Requested. 
+*             n -- The Number of Blocks Requested. 
+*             out -- Receives the Pointers to the Blocks. 
+*   Return: The Number of Blocks Obtained, Less than "n" when the Pool Runs Short. 
+*
+*   NOTE: 
+*   (1) Running Short is not Asserted, the Caller Decides. 
+*   (2) With MPOOL_LOCKFREE_ENABLE, the Blocks are Popped One by One without Lock. 
+***************************************************************************************/
+MPOOL_EXT uint16_t mpool_get_n(mpool_t *me, uint16_t n, void_t *out[]);
+
+/***************************************************************************************
+*   Put Several Memory Blocks Back to Their Memory Pools.
+*
+*   Description: Put "n" Memory Blocks Back, Each Run of the Blocks of the Same 
+*                Pool is Linked Outside the Critical Section and Spliced into the 
+*                Free List in One. 
+*   Argument: blocks -- The Pointers to the Memory Blocks which will be Put Back. 
+*             n -- The Number of Blocks. 
+*   Return: 1 is True, -1 is Failure (Some Blocks are not Put Back)
+*
+*   NOTE: 
+*   (1) The Blocks may Belong to Different Pools, Group Them by the Pool for the 
+*       Longest Runs. 
+***************************************************************************************/
+MPOOL_EXT int16_t mpool_put_n(void_t *blocks[], uint16_t n);
+
+/***************************************************************************************
+*   Find the Memory Pool of a Memory Block. 
+*
+*   Description: Find the Memory Pool which the Block is Obtained from. 
+*   Argument: block -- The Pointer to the Memory Block Returned by mpool_get(). 
+*   Return: The Pointer to the Memory Pool, or NULL if the Block is not in Any Pool. 
+*
+*   NOTE: 
+*   (1) Without the Header (MPOOL_HEADERLESS_ENABLE), It Searches the Range Table, 
+*       which is Filled by mpool_init(), so Initialize the Pools at the Start-Up. 
+***************************************************************************************/
+MPOOL_EXT mpool_t *mpool_owner(void_t *block); 
+
 /***************************************************************************************
 *   All Block are Recycled for the Given Memory Pool ? 
 *
@@ -212,8 +380,31 @@ MPOOL_EXT int16_t mpool_all_recycled(mpool_t *me);
 ***************************************************************************************/
 MPOOL_EXT uint16_t mpool_margin(mpool_t *me); 
 
+#ifdef MPOOL_ELASTIC_ENABLE
+/***************************************************************************************
+*   Give Back the Extents Borrowed from hpool. 
+*
+*   Description: Give All the Extents of the Given Memory Pool Back to hpool, if 
+*                All Their Blocks are Free. 
+*   Argument: me -- Pointer to the mpool_t Struct to be Trimmed. 
+*   Return: 1 is True, 0 is False (No Extent, Some of Their Blocks in Use, or the 
+*           Buffer of Pool would be Left without a Batch Spare), -1 is Failure
+*
+*   NOTE: 
+*   (1) The Blocks of Extents are Kept in Their Own Free List and Counted by 
+*       get/put, and mpool_get() Takes the Blocks of the Buffer of Pool First, so 
+*       the Extents Fall Free while the Pool is Calm. The Free List is not Walked, 
+*       the Critical Section is O(1), hpool is Called Outside It. mpool_put() 
+*       Calls It at Most once per MPOOL_ELASTIC_PERIOD Ticks, the Idle Loop may 
+*       Call It too. 
+*   (2) The Extents still in Use are Tried again after Another Period. 
+***************************************************************************************/
+MPOOL_EXT int16_t mpool_trim(mpool_t *me); 
+#endif  /* End of MPOOL_ELASTIC_ENABLE */
+
 #ifdef SPYER_MPOOL_ENABLE   /* Spy Debuger Enabled */
-    #define SPYER_MPOOL(format, ...)   spyer_((const int8_t *)format, ##__VA_ARGS__)
+    #define SPYER_MPOOL(format, ...)   \
+        spyer_ch_(SPYER_CH_MPOOL, (const int8_t *)format, ##__VA_ARGS__)
 #else                       /* Spyer Debuger Disabled */
     #define SPYER_MPOOL(format, ...)   ((void_t)0)
 #endif  /* End of SPYER_MPOOL_ENABLE */
@@ -49,6 +49,7 @@
 
 ASSERT_THIS_FILE(queue.c)
 FAULT_THIS_FILE(queue.c)
+SPYER_THIS_FILE(12)
 
 /***************************************************************************************
 *   queue_init() Implementation.
@@ -95,7 +96,7 @@ int16_t queue_post_FIFO(queue_t *me, void_t *data)
     /* Is the Queue Empty ? */
     if (me->front == (void_t *)0) { 
         me->front = data;           /* Deliver Pointer Directly */
-        SPYER_QUEUE("Pointer %X is Post into FIFO Queue %X, Usage %d, Max Usage %d. TimeStamp %d", \\
+        SPYER_QUEUE("Pointer %X is Post into FIFO Queue %X, Usage %d, Max Usage %d. TimeStamp %d", \
                      data, me, me->used_cnt, me->max_cnt, ticks_get()); 
         return TRUE; 
     }
@@ -110,7 +111,7 @@ int16_t queue_post_FIFO(queue_t *me, void_t *data)
         me->max_cnt = me->used_cnt; /* Store Maximum Used so Far */
     }
 
-    SPYER_QUEUE("Pointer %X is Post into FIFO Queue %X, Usage %d, Max Usage %d. TimeStamp %d", \\
+    SPYER_QUEUE("Pointer %X is Post into FIFO Queue %X, Usage %d, Max Usage %d. TimeStamp %d", \
                  data, me, me->used_cnt, me->max_cnt, ticks_get()); 
 
     INT_UNLOCK_(); 
@@ -139,7 +140,7 @@ int16_t queue_post_LIFO(queue_t *me, void_t *data)
     /* Is the Queue Empty ? */
     if (me->front == (void_t *)0) { 
         me->front = data;               /* Stick the New Pointer to the Front */
-        SPYER_QUEUE("Pointer %X is Post into LIFO Queue %X, Usage %d, Max Usage %d. TimeStamp %d", \\
+        SPYER_QUEUE("Pointer %X is Post into LIFO Queue %X, Usage %d, Max Usage %d. TimeStamp %d", \
                      data, me, me->used_cnt, me->max_cnt, ticks_get()); 
         return TRUE; 
     }
@@ -157,7 +158,7 @@ int16_t queue_post_LIFO(queue_t *me, void_t *data)
         me->max_cnt = me->used_cnt;     /* Store Maximum Used so far */
     }
 
-    SPYER_QUEUE("Pointer %X is Post into LIFO Queue %X, Usage %d, Max Usage %d. TimeStamp %d", \\
+    SPYER_QUEUE("Pointer %X is Post into LIFO Queue %X, Usage %d, Max Usage %d. TimeStamp %d", \
                  data, me, me->used_cnt, me->max_cnt, ticks_get()); 
 
     INT_UNLOCK_();
@@ -196,7 +197,7 @@ void_t *queue_get(queue_t *me)
         /* The Queue becomes Empty */
         me->front = (void_t *)0;
     }
-    SPYER_QUEUE("Pointer %X is Get from Queue %X, Usage %d. TimeStamp %d", \\
+    SPYER_QUEUE("Pointer %X is Get from Queue %X, Usage %d. TimeStamp %d", \
                  data, me, me->used_cnt, ticks_get()); 
     INT_UNLOCK_();
 
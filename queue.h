@@ -206,7 +206,8 @@ QUEUE_EXT void_t *queue_front(queue_t *me);
 QUEUE_EXT uint16_t queue_margin(queue_t *me); 
 
 #ifdef SPYER_QUEUE_ENABLE   /* Spy Debuger Enabled */
-    #define SPYER_QUEUE(format, ...)   spyer_((const int8_t *)format, ##__VA_ARGS__)
+    #define SPYER_QUEUE(format, ...)   \
+        spyer_ch_(SPYER_CH_QUEUE, (const int8_t *)format, ##__VA_ARGS__)
 #else                       /* Spy Debuger Disabled */
     #define SPYER_QUEUE(format, ...)   ((void_t)0)
 #endif  /* End of SPYER_QUEUE_ENABLE */
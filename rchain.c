@@ -45,6 +45,7 @@
 #include "fault.h"
 #include "mpool.h"
 #include "event.h"
+#include "epool.h"
 #include "cpool.h"
 
 #define  EXTERN_GLOBALS
@@ -52,6 +53,7 @@
 
 ASSERT_THIS_FILE(rchain.c)
 FAULT_THIS_FILE(rchain.c)
+SPYER_THIS_FILE(13)
 
 /***************************************************************************************
 *   rchain_init() Implementation.
@@ -89,12 +91,12 @@ chain_t *rchain_find(chain_t **me, signal_t signal)
         return (chain_t *)0; 
     } 
     chain = *me; 
-    if ((event_t *)(chain->builtin)->signal == signal) { 
+    if (((event_t *)(chain->builtin))->signal == signal) { 
         /* Find It */
         return chain; 
     } 
     chain = chain->next; 
-    while ((chain != *me) && ((event_t *)(chain->builtin)->signal != signal)) { 
+    while ((chain != *me) && (((event_t *)(chain->builtin))->signal != signal)) { 
         chain = chain->next; 
     } 
     if (chain == *me) { 
@@ -120,9 +122,9 @@ int16_t rchain_bind(chain_t **me, event_t *event)
     } 
 
     /* The Active Object Has Bind in Chain Pool ? */
-    if (rchain_find(me, event) != (chain_t *)0) { 
+    if (rchain_find(me, event->signal) != (chain_t *)0) { 
         /* Find It */
-        SPYER_RCHAIN("Event %X Has Bind in Event Register Chain %X. TimeStamp %d", \\
+        SPYER_RCHAIN("Event %X Has Bind in Event Register Chain %X. TimeStamp %d", \
                       event, me, ticks_get()); 
         return TRUE; 
     } 
@@ -143,11 +145,11 @@ int16_t rchain_bind(chain_t **me, event_t *event)
         chain->fore = chain;
     }
     else {  /* The Priority-Based Event Register Chain is Not NULL */
+        /* Get the Pointer of the Highest Priority Event */
+        current = *me;
         /* The Priority of "event" is High than The Highest Priority Event ? */
         if(event->priority < ((event_t *)(current->builtin))->priority) {   
             /* Yes, It High Than The Highest Priority Event */
-            /* Get the Pointer of the Highest Priority Event */
-            current = *me;
             /* Append this Event into The Head of Event Chain */
             chain->next  = current;
             chain->fore  = current->fore;  /* Circulated Bidirectional List */
@@ -177,7 +179,7 @@ int16_t rchain_bind(chain_t **me, event_t *event)
         }
     }
 
-    SPYER_RCHAIN("Event %X is Bind into Event Register Chain %X. TimeStamp %d", \\
+    SPYER_RCHAIN("Event %X is Bind into Event Register Chain %X. TimeStamp %d", \
                   event, me, ticks_get()); 
 
     return TRUE; 
@@ -189,7 +191,6 @@ int16_t rchain_bind(chain_t **me, event_t *event)
 int16_t rchain_unbind(chain_t **me, chain_t *chain)
 {
     int16_t ret; 
-    chain_t *current; 
 
     ASSERT_REQUIRE(me  != (chain_t **)0);
     ASSERT_REQUIRE(chain != (chain_t *)0);
@@ -212,14 +213,14 @@ int16_t rchain_unbind(chain_t **me, chain_t *chain)
     }
 
     /* Release the Block of Event */
-    ret = epool_release((event_t *)(current->builtin)); 
+    ret = epool_release((event_t *)(chain->builtin)); 
     ASSERT_ENSURE(ret >= (int16_t)0); 
     /* Release the Block of Event Register Chain Cell */
     ret = cpool_put((chain_t *)chain); 
     ASSERT_ENSURE(ret == TRUE); 
 
-    SPYER_RCHAIN("Event %X is Unbind from Event Register Chain %X. TimeStamp %d", \\
-                  event, me, ticks_get()); 
+    SPYER_RCHAIN("Event %X is Unbind from Event Register Chain %X. TimeStamp %d", \
+                  chain->builtin, me, ticks_get()); 
 
     return TRUE;
 }
@@ -112,7 +112,8 @@ RCHAIN_EXT int16_t rchain_bind(chain_t **me, event_t *event);
 RCHAIN_EXT int16_t rchain_unbind(chain_t **me, chain_t *chain);
 
 #ifdef SPYER_RCHAIN_ENABLE   /* Spy Debuger Enabled */
-    #define SPYER_RCHAIN(format, ...)   spyer_((const int8_t *)format, ##__VA_ARGS__)
+    #define SPYER_RCHAIN(format, ...)   \
+        spyer_ch_(SPYER_CH_RCHAIN, (const int8_t *)format, ##__VA_ARGS__)
 #else                       /* Spyer Debuger Disabled */
     #define SPYER_RCHAIN(format, ...)   ((void_t)0)
 #endif  /* End of SPYER_RCHAIN_ENABLE */
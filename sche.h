@@ -43,6 +43,20 @@
     #define SCHE_EXT    extern
 #endif
 
+#ifndef MAX_ACTIVE
+    /***********************************************************************************
+    *   Macro to Override the Default Maximum Amount of Active Objects in Ready Set.
+    *
+    *   Default is 64. Each Active Object Owns an Unique Slot (0..MAX_ACTIVE-1) in the 
+    *   Ready Set, Where Lower Slot Correspond to Higher Priority. 
+    ***********************************************************************************/
+    #define MAX_ACTIVE      64
+#endif
+
+#if (MAX_ACTIVE > 64)
+    #error "MAX_ACTIVE Must be not Larger than 64"
+#endif
+
 #if (MAX_ACTIVE <= 8)
     #define SCHE_BITSET_8
 #endif
@@ -53,7 +67,7 @@
 *   The Priority Set Represents the Set of Active Object that are Ready to Run and 
 *   Need to be Considered by Scheduling Processing. 
 ***************************************************************************************/
-#ifdef (SCHE_BITSET_8)
+#ifdef SCHE_BITSET_8
 
     /***********************************************************************************
     *   The set is Capable of Storing up to 8 Priority Levels.
@@ -86,13 +100,13 @@
             ((((set_t *)me_)->bits & ROM_BYTE(&lookup_bit_or[n_])) != 0)
 
     /***********************************************************************************
-    *   Insert Element "n_" into the Set "me_", n_ = 1..8
+    *   Insert Element "n_" into the Set "me_", n_ = 0..7
     ***********************************************************************************/
     #define set_insert(me_, n_)     \
             (((set_t *)me_)->bits |= ROM_BYTE(&lookup_bit_or[n_]))
 
     /***********************************************************************************
-    *   Remove Element n_ from the Set "me_", n_ = 1..8
+    *   Remove Element n_ from the Set "me_", n_ = 0..7
     ***********************************************************************************/
     #define set_remove(me_, n_)     \
             (((set_t *)me_)->bits &= ROM_BYTE(&lookup_bit_and[n_]))
@@ -216,6 +230,11 @@
 
 /***************************************************************************************
 *   Ready Set of Active Objects.
+*
+*   NOTE: 
+*   (1) The Element n of the Set is the Slot of Active Object, set_find_max() Returns 
+*       the Lowest Slot in the Set, that is the Highest Priority Ready Active Object. 
+*   (2) The Ready Set MUST be Accessed with Interrupts LOCKED. 
 ***************************************************************************************/
 SCHE_EXT set_t volatile os_ready_set_;
 
@@ -0,0 +1,569 @@
+/***************************************************************************************
+*   The MIT License (MIT)
+*   Copyright (C) 2005 JinHui Han, <Email: ferrethan485@sohu.com, QQ: 1901589440>
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in
+*   all copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+*   THE SOFTWARE.
+***************************************************************************************/
+
+
+/***************************************************************************************
+*   Component : Active Object Application FrameWork
+*   Group : Simulation
+*   File Name : sim.c
+*   Version : 1.0
+*   Description : Deterministic Simulation of the Framework in Virtual Time
+*   Author : JinHui Han
+*   History : 
+*          Name            Date                    Remarks
+*       JinHui Han      05-20-2005      Created Initial Version 1.0
+*       JinHui Han      05-20-2005      Verified Version 1.0
+***************************************************************************************/
+
+#include "std_type.h"
+#include "std_def.h"
+#include "config.h"
+
+#ifdef SIM_ENABLE
+#include <stdio.h>
+#endif  /* End of SIM_ENABLE */
+
+#include "lock.h"
+#include "debug.h"
+#include "assert.h"
+#include "spyer.h"
+#include "ticks.h"
+#include "fault.h"
+#include "lookup.h"
+#include "mpool.h"
+#include "event.h"
+#include "epool.h"
+#include "cpool.h"
+#include "echain.h"
+#include "ering.h"
+#include "rchain.h"
+#include "fsm.h"
+#include "hsm.h"
+#include "active.h"
+#include "achain.h"
+#include "sche.h"
+#include "stack.h"
+#include "manager.h"
+#include "ticker.h"
+
+#define  EXTERN_GLOBALS
+#include "sim.h"
+
+ASSERT_THIS_FILE(sim.c)
+FAULT_THIS_FILE(sim.c)
+SPYER_THIS_FILE(20)
+
+#ifdef SIM_ENABLE
+
+/***************************************************************************************
+*   Entry of the Injection Script, with the Latencies of Its Events. 
+***************************************************************************************/
+typedef struct sim_script_tag { 
+    sim_time_t    time;         /* Virtual Time of the Next Injection */
+    uint32_t      period;       /* Cycles between Two Injections */
+    uint32_t      count;        /* Injections Left, 0 is Forever */
+    uint32_t      seq;          /* Injections Done */
+    sim_source_t  source;       /* Source of the Events, NULL when the Entry is Over */
+    uint32_t      done;         /* Events Released */
+    uint32_t      lost;         /* Events not Tracked, the Flight Table is Full */
+    uint32_t      min;          /* Minimum Latency */
+    uint32_t      max;          /* Maximum Latency */
+    double        sum;          /* Sum of Latencies */
+    uint32_t      hist[SIM_BUCKETS];    /* Log2 Histogram of Latency */
+} sim_script_t; 
+
+/***************************************************************************************
+*   Injected Event in Flight. 
+***************************************************************************************/
+typedef struct sim_flight_tag { 
+    event_t     * event;        /* The Event Posted */
+    sim_time_t    time;         /* Virtual Time of the Injection */
+    uint8_t       script;       /* Index of the Script Entry */
+} sim_flight_t; 
+
+/***************************************************************************************
+*   Watched Event Chain or Pool. 
+***************************************************************************************/
+typedef struct sim_watch_tag { 
+    echain_t    * chain;        /* The Event Chain, or NULL */
+    mpool_t     * pool;         /* The Pool, or NULL */
+    char const  * name;         /* Name in the Report */
+    uint16_t      mark;         /* Maximum Depth of Chain, Minimum Margin of Pool */
+} sim_watch_t; 
+
+static sim_time_t    sim_now_;          /* The Virtual Clock */
+static sim_time_t    sim_end_;          /* The End of sim_run() */
+static sim_cost_t    sim_cost_; 
+static uint32_t      sim_steps_;        /* RTC Steps Run */
+static uint32_t      sim_idles_;        /* Calls of on_idle() */
+static sim_script_t  sim_script_[SIM_SCRIPT_AMOUNT]; 
+static uint8_t       sim_scripts_; 
+static sim_flight_t  sim_flight_[SIM_FLIGHT_AMOUNT]; 
+static uint16_t      sim_flights_; 
+static sim_watch_t   sim_watch_[SIM_WATCH_AMOUNT]; 
+static uint8_t       sim_watches_; 
+
+/***************************************************************************************
+*   sim_before_() Implementation. Internal
+*   TRUE if the Time "a" is Earlier than the Time "b". 
+***************************************************************************************/
+static int16_t sim_before_(sim_time_t const *a, sim_time_t const *b)
+{
+    if (a->tick != b->tick) { 
+        return (a->tick < b->tick) ? TRUE : FALSE; 
+    } 
+    return (a->cycle < b->cycle) ? TRUE : FALSE; 
+}
+
+/***************************************************************************************
+*   sim_add_() Implementation. Internal
+***************************************************************************************/
+static void_t sim_add_(sim_time_t *time, uint32_t cycles)
+{
+    time->tick  += cycles / SIM_TICK_CYCLES; 
+    time->cycle += cycles % SIM_TICK_CYCLES; 
+    if (time->cycle >= SIM_TICK_CYCLES) { 
+        time->cycle -= SIM_TICK_CYCLES; 
+        ++(time->tick); 
+    } 
+}
+
+/***************************************************************************************
+*   sim_latency_() Implementation. Internal
+*   The Cycles from "from" to the Virtual Clock, Saturated to 32 Bits. 
+***************************************************************************************/
+static uint32_t sim_latency_(sim_time_t const *from)
+{
+    double cycles; 
+
+    cycles = (double)(sim_now_.tick - from->tick) * (double)SIM_TICK_CYCLES + 
+             (double)sim_now_.cycle - (double)from->cycle; 
+    return (cycles >= 4294967295.0) ? (uint32_t)0xFFFFFFFFUL : (uint32_t)cycles; 
+}
+
+/***************************************************************************************
+*   sim_next_() Implementation. Internal
+*   The Script Entry of the Next Injection, the First Entry Wins the Tie. 
+***************************************************************************************/
+static sim_script_t *sim_next_(void_t)
+{
+    uint8_t       index; 
+    sim_script_t *next; 
+
+    next = (sim_script_t *)0; 
+    for (index = (uint8_t)0; index < sim_scripts_; ++index) { 
+        if (sim_script_[index].source == (sim_source_t)0) { 
+            continue; 
+        } 
+        if ((next == (sim_script_t *)0) || 
+            (sim_before_(&(sim_script_[index].time), &(next->time)) == TRUE)) { 
+            next = &sim_script_[index]; 
+        } 
+    } 
+    return next; 
+}
+
+/***************************************************************************************
+*   sim_sample_() Implementation. Internal
+***************************************************************************************/
+static void_t sim_sample_(void_t)
+{
+    uint8_t  index; 
+    uint16_t value; 
+
+    for (index = (uint8_t)0; index < sim_watches_; ++index) { 
+        if (sim_watch_[index].chain != (echain_t *)0) { 
+            value = echain_count(sim_watch_[index].chain); 
+            if (value > sim_watch_[index].mark) { 
+                sim_watch_[index].mark = value; 
+            } 
+        } 
+        else { 
+            value = mpool_margin(sim_watch_[index].pool); 
+            if (value < sim_watch_[index].mark) { 
+                sim_watch_[index].mark = value; 
+            } 
+        } 
+    } 
+}
+
+/***************************************************************************************
+*   sim_fire_() Implementation. Internal
+*   The "ISR" of Injection, the Virtual Clock is at the Time of the Entry. 
+***************************************************************************************/
+static void_t sim_fire_(sim_script_t *script)
+{
+    cpu_sr_t key; 
+    event_t *event; 
+
+    key = interrupt_enter(); 
+    event = (*(script->source))(script->seq); 
+    ++(script->seq); 
+    if (event != (event_t *)0) { 
+        if (sim_flights_ < (uint16_t)SIM_FLIGHT_AMOUNT) { 
+            sim_flight_[sim_flights_].event  = event; 
+            sim_flight_[sim_flights_].time   = sim_now_; 
+            sim_flight_[sim_flights_].script = (uint8_t)(script - &sim_script_[0]); 
+            ++sim_flights_; 
+        } 
+        else { 
+            ++(script->lost); 
+        } 
+        man_post(event); 
+    } 
+    if ((script->count != (uint32_t)0) && (--(script->count) == (uint32_t)0)) { 
+        /* The Last Injection of the Entry */
+        script->source = (sim_source_t)0; 
+    } 
+    else if (script->period == (uint32_t)0) { 
+        script->source = (sim_source_t)0; 
+    } 
+    else { 
+        sim_add_(&(script->time), script->period); 
+    } 
+    interrupt_leave(key, FALSE); 
+    sim_sample_(); 
+}
+
+/***************************************************************************************
+*   sim_tick_() Implementation. Internal
+*   The Time-Tick "ISR", the Virtual Clock is at the Start of the Tick. 
+***************************************************************************************/
+static void_t sim_tick_(void_t)
+{
+    cpu_sr_t key; 
+
+    key = interrupt_enter(); 
+    ticker (); 
+    interrupt_leave(key, FALSE); 
+    debug_flush (); 
+}
+
+/***************************************************************************************
+*   sim_advance_() Implementation. Internal
+*   Advance the Virtual Clock to "target", Play the Ticks and the Injections on the 
+*   Way in the Time Order. 
+***************************************************************************************/
+static void_t sim_advance_(sim_time_t const *target)
+{
+    sim_time_t    tick; 
+    sim_script_t *next; 
+
+    for (;;) { 
+        tick.tick  = sim_now_.tick + (uint32_t)1; 
+        tick.cycle = (uint32_t)0; 
+        next = sim_next_(); 
+        if ((sim_before_(target, &tick) != TRUE) && 
+            ((next == (sim_script_t *)0) || (sim_before_(&(next->time), &tick) != TRUE))) { 
+            /* The Tick is First, before the Injection at the Same Time */
+            sim_now_ = tick; 
+            sim_tick_(); 
+            continue; 
+        } 
+        if ((next != (sim_script_t *)0) && (sim_before_(target, &(next->time)) != TRUE)) { 
+            if (sim_before_(&sim_now_, &(next->time)) == TRUE) { 
+                sim_now_ = next->time; 
+            } 
+            sim_fire_(next); 
+            continue; 
+        } 
+        break; 
+    } 
+    sim_now_ = *target; 
+}
+
+/***************************************************************************************
+*   sim_init() Implementation.
+***************************************************************************************/
+int16_t sim_init(sim_cost_t cost)
+{
+    sim_now_.tick  = (uint32_t)0; 
+    sim_now_.cycle = (uint32_t)0; 
+    sim_end_       = sim_now_; 
+    sim_cost_      = cost; 
+    sim_steps_     = (uint32_t)0; 
+    sim_idles_     = (uint32_t)0; 
+    sim_scripts_   = (uint8_t)0; 
+    sim_flights_   = (uint16_t)0; 
+    sim_watches_   = (uint8_t)0; 
+
+    sim_watch_chain((echain_t *)&(man.event), "manager"); 
+    sim_watch_pool((mpool_t *)&cpool, "cpool"); 
+    return TRUE; 
+}
+
+/***************************************************************************************
+*   sim_inject() Implementation.
+***************************************************************************************/
+int16_t sim_inject(uint32_t tick, uint32_t cycle, uint32_t period, 
+                   uint32_t count, sim_source_t source)
+{
+    sim_script_t *script; 
+
+    ASSERT_REQUIRE(source != (sim_source_t)0); 
+    ASSERT_REQUIRE(cycle < SIM_TICK_CYCLES); 
+    if ((source == (sim_source_t)0) || (cycle >= SIM_TICK_CYCLES)) { 
+        return FAILURE; 
+    } 
+    if (sim_scripts_ >= (uint8_t)SIM_SCRIPT_AMOUNT) { 
+        return FALSE; 
+    } 
+
+    script = &sim_script_[sim_scripts_]; 
+    script->time.tick  = tick; 
+    script->time.cycle = cycle; 
+    script->period = period; 
+    script->count  = count; 
+    script->seq    = (uint32_t)0; 
+    script->source = source; 
+    script->done   = (uint32_t)0; 
+    script->lost   = (uint32_t)0; 
+    script->min    = (uint32_t)0xFFFFFFFFUL; 
+    script->max    = (uint32_t)0; 
+    script->sum    = 0.0; 
+    for (tick = (uint32_t)0; tick < (uint32_t)SIM_BUCKETS; ++tick) { 
+        script->hist[tick] = (uint32_t)0; 
+    } 
+    ++sim_scripts_; 
+    return TRUE; 
+}
+
+/***************************************************************************************
+*   sim_watch_chain() Implementation.
+***************************************************************************************/
+int16_t sim_watch_chain(echain_t *chain, char const *name)
+{
+    ASSERT_REQUIRE(chain != (echain_t *)0); 
+    if (chain == (echain_t *)0) { 
+        return FAILURE; 
+    } 
+    if (sim_watches_ >= (uint8_t)SIM_WATCH_AMOUNT) { 
+        return FALSE; 
+    } 
+    sim_watch_[sim_watches_].chain = chain; 
+    sim_watch_[sim_watches_].pool  = (mpool_t *)0; 
+    sim_watch_[sim_watches_].name  = name; 
+    sim_watch_[sim_watches_].mark  = echain_count(chain); 
+    ++sim_watches_; 
+    return TRUE; 
+}
+
+/***************************************************************************************
+*   sim_watch_pool() Implementation.
+***************************************************************************************/
+int16_t sim_watch_pool(mpool_t *pool, char const *name)
+{
+    ASSERT_REQUIRE(pool != (mpool_t *)0); 
+    if (pool == (mpool_t *)0) { 
+        return FAILURE; 
+    } 
+    if (sim_watches_ >= (uint8_t)SIM_WATCH_AMOUNT) { 
+        return FALSE; 
+    } 
+    sim_watch_[sim_watches_].chain = (echain_t *)0; 
+    sim_watch_[sim_watches_].pool  = pool; 
+    sim_watch_[sim_watches_].name  = name; 
+    sim_watch_[sim_watches_].mark  = mpool_margin(pool); 
+    ++sim_watches_; 
+    return TRUE; 
+}
+
+/***************************************************************************************
+*   sim_run() Implementation.
+***************************************************************************************/
+int16_t sim_run(uint32_t ticks)
+{
+    sim_end_.tick  = sim_now_.tick + ticks; 
+    sim_end_.cycle = (uint32_t)0; 
+    while (sim_before_(&sim_now_, &sim_end_) == TRUE) { 
+        man_scheduler(); 
+    } 
+    return TRUE; 
+}
+
+/***************************************************************************************
+*   sim_step() Implementation.
+***************************************************************************************/
+void_t sim_step(active_t *active)
+{
+    uint32_t   cost; 
+    sim_time_t target; 
+
+    cost = (sim_cost_ != (sim_cost_t)0) ? (*sim_cost_)(active) : (uint32_t)SIM_STEP_CYCLES; 
+    ++sim_steps_; 
+    target = sim_now_; 
+    sim_add_(&target, cost); 
+    sim_advance_(&target); 
+    sim_sample_(); 
+}
+
+/***************************************************************************************
+*   sim_idle() Implementation.
+***************************************************************************************/
+void_t sim_idle(uint32_t ticks)
+{
+    sim_time_t    target; 
+    sim_script_t *next; 
+
+    ++sim_idles_; 
+    if (ticks == (uint32_t)0) { 
+        ticks = (uint32_t)1; 
+    } 
+    /* Wake Up at the Tick of the Timer Expiry, not Later than the End */
+    target.cycle = (uint32_t)0; 
+    if (ticks >= sim_end_.tick - sim_now_.tick) { 
+        target.tick = sim_end_.tick; 
+    } 
+    else { 
+        target.tick = sim_now_.tick + ticks; 
+    } 
+    /* Or at the Next Injection */
+    next = sim_next_(); 
+    if ((next != (sim_script_t *)0) && (sim_before_(&(next->time), &target) == TRUE)) { 
+        target = next->time; 
+    } 
+    if (sim_before_(&sim_now_, &target) != TRUE) { 
+        return; 
+    } 
+#ifdef TICKER_TICKLESS_ENABLE
+    /* The Clock Tick is Stopped, Catch up the Ticks Slept at Once */
+    ticks = target.tick - sim_now_.tick; 
+    sim_now_ = target; 
+    if (ticks != (uint32_t)0) { 
+        ticker_catchup(ticks); 
+        debug_flush (); 
+    } 
+    /* Play the Injections Due */
+    sim_advance_(&target); 
+#else
+    sim_advance_(&target); 
+#endif  /* End of TICKER_TICKLESS_ENABLE */
+}
+
+/***************************************************************************************
+*   sim_done() Implementation.
+***************************************************************************************/
+void_t sim_done(event_t *event)
+{
+    uint16_t      index; 
+    uint8_t       bucket; 
+    uint32_t      latency; 
+    sim_script_t *script; 
+
+    for (index = (uint16_t)0; index < sim_flights_; ++index) { 
+        if (sim_flight_[index].event == event) { 
+            break; 
+        } 
+    } 
+    if (index >= sim_flights_) { 
+        /* Not Injected, or not Tracked */
+        return; 
+    } 
+    latency = sim_latency_(&(sim_flight_[index].time)); 
+    script  = &sim_script_[sim_flight_[index].script]; 
+    /* Remove from the Flight Table, the Last Entry Takes the Place */
+    --sim_flights_; 
+    sim_flight_[index] = sim_flight_[sim_flights_]; 
+
+    ++(script->done); 
+    script->sum += (double)latency; 
+    if (latency < script->min) { 
+        script->min = latency; 
+    } 
+    if (latency > script->max) { 
+        script->max = latency; 
+    } 
+    for (bucket = (uint8_t)0; (latency >> 1) != (uint32_t)0; latency >>= 1) { 
+        ++bucket; 
+    } 
+    if (bucket >= (uint8_t)SIM_BUCKETS) { 
+        bucket = (uint8_t)(SIM_BUCKETS - 1); 
+    } 
+    ++(script->hist[bucket]); 
+}
+
+/***************************************************************************************
+*   sim_cycles() Implementation.
+***************************************************************************************/
+uint32_t sim_cycles(void_t)
+{
+    return sim_now_.tick * SIM_TICK_CYCLES + sim_now_.cycle; 
+}
+
+/***************************************************************************************
+*   sim_report() Implementation.
+***************************************************************************************/
+void_t sim_report(void_t)
+{
+    uint8_t   index; 
+    uint8_t   bucket; 
+    uint16_t  flight; 
+    uint32_t  inflight; 
+    uint32_t  count; 
+    uint32_t  p99; 
+    sim_script_t *script; 
+
+    printf("sim: %lu ticks (%.3f s) virtual, %lu steps, %lu idles\n", 
+           (unsigned long)sim_now_.tick, 
+           (double)sim_now_.tick / (double)TICKER + (double)sim_now_.cycle / 1e9, 
+           (unsigned long)sim_steps_, (unsigned long)sim_idles_); 
+    for (index = (uint8_t)0; index < sim_scripts_; ++index) { 
+        script = &sim_script_[index]; 
+        inflight = (uint32_t)0; 
+        for (flight = (uint16_t)0; flight < sim_flights_; ++flight) { 
+            if (sim_flight_[flight].script == index) { 
+                ++inflight; 
+            } 
+        } 
+        /* The Upper Bound of the Bucket Holding the 99th Percentile */
+        p99 = (uint32_t)0; 
+        count = (uint32_t)0; 
+        for (bucket = (uint8_t)0; bucket < (uint8_t)SIM_BUCKETS; ++bucket) { 
+            count += script->hist[bucket]; 
+            if ((double)count * 100.0 >= (double)script->done * 99.0) { 
+                p99 = (bucket >= (uint8_t)31) ? (uint32_t)0xFFFFFFFFUL : 
+                      ((uint32_t)2 << bucket); 
+                break; 
+            } 
+        } 
+        printf("inject %u: %lu injected, %lu done, %lu in flight, %lu lost, " 
+               "latency ns min %lu mean %.0f p99 < %lu max %lu\n", 
+               (unsigned)index, (unsigned long)script->seq, (unsigned long)script->done, 
+               (unsigned long)inflight, (unsigned long)script->lost, 
+               (unsigned long)((script->done != (uint32_t)0) ? script->min : 0), 
+               (script->done != (uint32_t)0) ? script->sum / (double)script->done : 0.0, 
+               (unsigned long)p99, (unsigned long)script->max); 
+    } 
+    for (index = (uint8_t)0; index < sim_watches_; ++index) { 
+        if (sim_watch_[index].chain != (echain_t *)0) { 
+            printf("chain %s: max depth %u\n", sim_watch_[index].name, 
+                   (unsigned)sim_watch_[index].mark); 
+        } 
+        else { 
+            printf("pool %s: min margin %u\n", sim_watch_[index].name, 
+                   (unsigned)sim_watch_[index].mark); 
+        } 
+    } 
+}
+
+#endif  /* End of SIM_ENABLE */
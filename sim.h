@@ -0,0 +1,240 @@
+/***************************************************************************************
+*   The MIT License (MIT)
+*   Copyright (C) 2005 JinHui Han, <Email: ferrethan485@sohu.com, QQ: 1901589440>
+*
+*   Permission is hereby granted, free of charge, to any person obtaining a copy
+*   of this software and associated documentation files (the "Software"), to deal
+*   in the Software without restriction, including without limitation the rights
+*   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*   copies of the Software, and to permit persons to whom the Software is
+*   furnished to do so, subject to the following conditions:
+*
+*   The above copyright notice and this permission notice shall be included in
+*   all copies or substantial portions of the Software.
+*
+*   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+*   THE SOFTWARE.
+***************************************************************************************/
+
+
+/***************************************************************************************
+*   Component : Active Object Application FrameWork
+*   Group : Simulation
+*   File Name : sim.h
+*   Version : 1.0
+*   Description : Deterministic Simulation of the Framework in Virtual Time
+*   Author : JinHui Han
+*   History : 
+*          Name            Date                    Remarks
+*       JinHui Han      05-20-2005      Created Initial Version 1.0
+*       JinHui Han      05-20-2005      Verified Version 1.0
+***************************************************************************************/
+
+#ifndef _SIM_H
+#define _SIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef  EXTERN_GLOBALS
+    #define SIM_EXT
+#else
+    #define SIM_EXT     extern
+#endif
+
+#ifdef SIM_ENABLE
+
+    #ifndef POSIX_HOST
+        #error "SIM_ENABLE Requires POSIX_HOST"
+    #endif
+    #ifdef MANAGER_EXECUTOR_ENABLE
+        #error "SIM_ENABLE Runs the Active Objects on One Thread, not with the Executor"
+    #endif
+
+    #ifndef SIM_STEP_CYCLES
+        /*******************************************************************************
+        *   This Constant Defines the Virtual Cycles (Nanoseconds) Charged for One RTC 
+        *   Step, when the Cost Function of sim_init() is NULL. 
+        *******************************************************************************/
+        #define SIM_STEP_CYCLES     10000   /* Default is 10000 */
+    #endif      /* End of SIM_STEP_CYCLES */
+
+    #ifndef SIM_SCRIPT_AMOUNT
+        /*******************************************************************************
+        *   This Constant Defines the Maximum Entries of the Injection Script. 
+        *******************************************************************************/
+        #define SIM_SCRIPT_AMOUNT   32      /* Default is 32 */
+    #endif      /* End of SIM_SCRIPT_AMOUNT */
+
+    #ifndef SIM_FLIGHT_AMOUNT
+        /*******************************************************************************
+        *   This Constant Defines the Maximum Injected Events Tracked at the Same Time, 
+        *   the Latency of the Other Events is not Measured (Counted as "lost"). 
+        *******************************************************************************/
+        #define SIM_FLIGHT_AMOUNT   256     /* Default is 256 */
+    #endif      /* End of SIM_FLIGHT_AMOUNT */
+
+    #ifndef SIM_WATCH_AMOUNT
+        /*******************************************************************************
+        *   This Constant Defines the Maximum Event Chains and Pools Watched. 
+        *******************************************************************************/
+        #define SIM_WATCH_AMOUNT    16      /* Default is 16 */
+    #endif      /* End of SIM_WATCH_AMOUNT */
+
+    #ifndef SIM_BUCKETS
+        /*******************************************************************************
+        *   This Constant Defines the Buckets of the Log2 Histogram of Latency, the 
+        *   Bucket n Counts the Latency in [2^n, 2^(n+1)) Nanoseconds. 
+        *******************************************************************************/
+        #define SIM_BUCKETS         32      /* Default is 32 */
+    #endif      /* End of SIM_BUCKETS */
+
+/***************************************************************************************
+*   Deterministic Simulation in Virtual Time. 
+*
+*   The Simulation Build (POSIX_HOST and SIM_ENABLE) Runs the Framework on One Thread 
+*   against a Virtual Clock in Nanoseconds, which Advances Only when: 
+*   (1) An Active Object Completes an RTC Step, by the Cost of the Step (the Cost 
+*       Function, or SIM_STEP_CYCLES). The Manager Itself Costs Nothing. 
+*   (2) The Manager is Idle, on_idle() Jumps to the Next Clock Tick, the Next Timer 
+*       Expiry (TICKER_TICKLESS_ENABLE) or the Next Injection, Whichever is First. 
+*   The Clock Ticks (ticker()) and the Injections (man_post() from the "ISRs") which 
+*   Fall in the Advance are Played in the Time Order, the Tick before the Injection 
+*   at the Same Time. cycles_get() Returns the Virtual Clock, so the Profiles of 
+*   Active Objects are in Virtual Time too. 
+*
+*   The Simulator Measures: 
+*   (1) The End-to-End Latency of Each Injected Event, from the Injection until the 
+*       Last Reference is Released by epool_release(). 
+*   (2) The Maximum Depth of the Watched Event Chains (the Manager's is Watched). 
+*   (3) The Minimum Margin of the Watched Pools (the Chain Pool is Watched). 
+*
+*   NOTE: 
+*   (1) The Events never Published (no Subscriber) are Reported as "in flight". 
+*   (2) Nothing Depends on the Wall Clock, the Same Script Gives the Same Report. 
+***************************************************************************************/
+
+/* Virtual Cycles (Nanoseconds) per Clock Tick */
+#define SIM_TICK_CYCLES     ((uint32_t)(1000000000UL / (uint32_t)TICKER))
+
+/***************************************************************************************
+*   Virtual Time, the Ticks and the Cycles Elapsed in the Tick. 
+***************************************************************************************/
+typedef struct sim_time_tag { 
+    uint32_t  tick;         /* Clock Ticks */
+    uint32_t  cycle;        /* Cycles in the Tick, Less than SIM_TICK_CYCLES */
+} sim_time_t; 
+
+/* Cost Function, Returns the Virtual Cycles of the RTC Step Just Completed */
+typedef uint32_t (*sim_cost_t)(active_t *active); 
+
+/* Source of the Injection, Returns the Event to be Posted (or NULL to Skip) */
+typedef event_t *(*sim_source_t)(uint32_t seq); 
+
+/***************************************************************************************
+*   Initialize the Simulator.
+*
+*   Description: Reset the Virtual Clock, the Script and the Measurements, and 
+*                Watch the Event Chain of Manager and the Chain Pool. 
+*   Argument: cost -- The Cost Function of RTC Step, or NULL for SIM_STEP_CYCLES. 
+*   Return:  1 is True, 0 is False, -1 is Failure 
+*
+*   NOTE: 
+*   (1) Called after man_init(), ticker_init() and interrupt_enable(), in Place of 
+*       the Loop of man_scheduler(). 
+***************************************************************************************/
+SIM_EXT int16_t sim_init(sim_cost_t cost); 
+
+/***************************************************************************************
+*   Script the Injection of Events.
+*
+*   Description: Call "source" at the Virtual Time (tick, cycle), and man_post() the 
+*                Event it Returns, then Again Every "period" Cycles. 
+*   Argument: tick   -- The Tick of the First Injection. 
+*             cycle  -- The Cycles in the Tick, Less than SIM_TICK_CYCLES. 
+*             period -- The Cycles between Two Injections. 
+*             count  -- The Number of Injections, 0 is Forever. 
+*             source -- The Source of the Events, Called with 0, 1, 2, ... 
+*   Return:  1 is True, 0 is False (the Script is Full), -1 is Failure 
+*
+*   NOTE: 
+*   (1) The Latency is Measured per Script Entry. 
+***************************************************************************************/
+SIM_EXT int16_t sim_inject(uint32_t tick, uint32_t cycle, uint32_t period, 
+                           uint32_t count, sim_source_t source); 
+
+/***************************************************************************************
+*   Watch the Depth of Event Chain.
+*
+*   Description: Record the Maximum Depth of the Event Chain, after Each Step. 
+*   Argument: chain -- The Pointer of Event Chain. 
+*             name  -- The Name in the Report. 
+*   Return:  1 is True, 0 is False (Too Many Watches), -1 is Failure 
+*
+*   NOTE: 
+***************************************************************************************/
+SIM_EXT int16_t sim_watch_chain(echain_t *chain, char const *name); 
+
+/***************************************************************************************
+*   Watch the Margin of Pool.
+*
+*   Description: Record the Minimum Margin (the High-Water Mark) of the Pool, after 
+*                Each Step. 
+*   Argument: pool -- The Pointer of Memory Pool or Event Pool. 
+*             name -- The Name in the Report. 
+*   Return:  1 is True, 0 is False (Too Many Watches), -1 is Failure 
+*
+*   NOTE: 
+***************************************************************************************/
+SIM_EXT int16_t sim_watch_pool(mpool_t *pool, char const *name); 
+
+/***************************************************************************************
+*   Run the Simulation.
+*
+*   Description: Run man_scheduler() until the Virtual Clock Reaches the Tick. 
+*   Argument: ticks -- The Ticks to Run, from the Current Virtual Time. 
+*   Return:  1 is True, 0 is False, -1 is Failure 
+*
+*   NOTE: 
+*   (1) May be Called Again to Continue, with More Script Entries Added. 
+***************************************************************************************/
+SIM_EXT int16_t sim_run(uint32_t ticks); 
+
+/***************************************************************************************
+*   Print the Report of Simulation.
+*
+*   Description: Print the Latencies, the Depths and the Margins to the Standard 
+*                Output. 
+*   Argument: none
+*   Return: none
+*
+*   NOTE: 
+***************************************************************************************/
+SIM_EXT void_t sim_report(void_t); 
+
+/***************************************************************************************
+*   Hooks of the Simulator, Called by the Framework and the Ports. 
+*
+*   (1) sim_step()   -- by the Manager, after the RTC Step of Active Object. 
+*   (2) sim_idle()   -- by on_idle(), with the Ticks to the Next Timer Expiry. 
+*   (3) sim_done()   -- by epool_release(), when the Last Reference is Released. 
+*   (4) sim_cycles() -- by cycles_get(), the Virtual Clock Truncated to 32 Bits. 
+***************************************************************************************/
+SIM_EXT void_t   sim_step(active_t *active); 
+SIM_EXT void_t   sim_idle(uint32_t ticks); 
+SIM_EXT void_t   sim_done(event_t *event); 
+SIM_EXT uint32_t sim_cycles(void_t); 
+
+#endif  /* End of SIM_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif      /* End of _SIM_H */
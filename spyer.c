@@ -36,6 +36,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdarg.h>
 
 #include "std_type.h"
 #include "std_def.h"
@@ -43,12 +44,112 @@
 #include "lock.h"
 #include "fault.h"
 #include "debug.h"
+#include "ticks.h"
 
 #define  EXTERN_GLOBALS
 #include "spyer.h"
 
 #ifdef SPYER_ENABLE      /* Spyer Enabled */
 
+#ifdef SPYER_FILTER_ENABLE
+/***************************************************************************************
+*   spyer_filter() Implementation.
+***************************************************************************************/
+void_t spyer_filter(uint32_t mask)
+{
+    INT_LOCK_KEY_
+
+    INT_LOCK_();
+    spyer_mask  = mask; 
+    spyer_live_ = mask; 
+    INT_UNLOCK_(); 
+}
+#endif      /* End of SPYER_FILTER_ENABLE */
+
+#ifdef SPYER_BINARY_ENABLE
+
+/***************************************************************************************
+*   Maximum Size of Binary Record in Bytes. 
+***************************************************************************************/
+#define SPYER_RECORD_SIZE_  \
+    ((uint16_t)(2 + sizeof(uint32_t) + ((1 + SPYER_MAX_ARGS) * sizeof(spyer_arg_t))))
+
+/***************************************************************************************
+*   spyer_pack_() Implementation. Internal
+*   Copy the Value into the Record in Native Byte Order, Returns the Next Position. 
+***************************************************************************************/
+static uint8_t *spyer_pack_(uint8_t *record, void_t const *value, uint16_t size)
+{
+    uint8_t const *byte; 
+
+    byte = (uint8_t const *)value; 
+    while (size-- > (uint16_t)0) { 
+        *record++ = *byte++; 
+    } 
+    return record; 
+}
+
+/***************************************************************************************
+*   spyer_put_() Implementation. Internal
+*   Build the Record with the Type ID "id" and Put It into the Debug Buffer. 
+***************************************************************************************/
+static void_t spyer_put_(uint8_t sync, void_t const *id, uint16_t id_size, 
+                         uint8_t argc, va_list args)
+{
+    uint8_t     record[SPYER_RECORD_SIZE_]; 
+    uint8_t   * position; 
+    uint32_t    stamp; 
+    spyer_arg_t arg; 
+
+    if (argc > (uint8_t)SPYER_MAX_ARGS) { 
+        argc = (uint8_t)SPYER_MAX_ARGS; 
+    } 
+    record[0] = sync; 
+    record[1] = argc; 
+    /* Timestamp, Read without Lock, sys_ticks is only Written by the Ticker */
+    stamp = sys_ticks; 
+    position = spyer_pack_(&record[2], &stamp, (uint16_t)sizeof(uint32_t)); 
+    position = spyer_pack_(position, id, id_size); 
+    while (argc-- > (uint8_t)0) { 
+        arg = va_arg(args, spyer_arg_t); 
+        position = spyer_pack_(position, &arg, (uint16_t)sizeof(spyer_arg_t)); 
+    } 
+
+    /* debug_put_block() Locks the Interrupts Internally */
+    debug_put_block (record, (uint16_t)(position - record)); 
+}
+
+/***************************************************************************************
+*   spyer_bin_() Implementation.
+***************************************************************************************/
+void_t spyer_bin_(const int8_t * format, uint8_t argc, ...)
+{
+    spyer_arg_t id; 
+    va_list     args; 
+
+    /* The Address of Format Strings is the Type ID of Record */
+    id = (spyer_arg_t)format; 
+    va_start(args, argc); 
+    spyer_put_(SPYER_SYNC, &id, (uint16_t)sizeof(spyer_arg_t), argc, args); 
+    va_end(args); 
+}
+
+#ifdef SPYER_INTERN_ENABLE
+/***************************************************************************************
+*   spyer_id_() Implementation.
+***************************************************************************************/
+void_t spyer_id_(uint32_t id, uint8_t argc, ...)
+{
+    va_list     args; 
+
+    va_start(args, argc); 
+    spyer_put_(SPYER_SYNC_ID, &id, (uint16_t)sizeof(uint32_t), argc, args); 
+    va_end(args); 
+}
+#endif      /* End of SPYER_INTERN_ENABLE */
+
+#else
+
 /***************************************************************************************
 *   spyer_() Implementation.
 ***************************************************************************************/
@@ -65,4 +166,6 @@ void_t spyer_(const int8_t * format, ...)
     INT_UNLOCK_(); 
 }
 
+#endif      /* End of SPYER_BINARY_ENABLE */
+
 #endif      /* End of SPYER_ENABLE */
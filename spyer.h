@@ -59,8 +59,173 @@ extern "C" {
 *   The Preprocessor Switch SPYER_ENABLE Enables Spyer Debuger.
 ***************************************************************************************/
 
+/***************************************************************************************
+*   Define the Unique ID of the Source File for the Interned Spyer Records. 
+*
+*   NOTE: (1) Every Source File which Uses the SPYER_XXX() Macros MUST Invoke It Once, 
+*             After ASSERT_THIS_FILE() and FAULT_THIS_FILE(). 
+*         (2) The ID MUST be Unique in the Image, 1 to 65535. spyer_dict.py Reads 
+*             It to Generate the Dictionary. 
+***************************************************************************************/
+#if defined(SPYER_INTERN_ENABLE) && !defined(SPYER_BINARY_ENABLE)
+    #error "SPYER_INTERN_ENABLE Requires SPYER_BINARY_ENABLE"
+#endif
+#if defined(SPYER_ENABLE) && defined(SPYER_BINARY_ENABLE) && defined(SPYER_INTERN_ENABLE)
+    #define SPYER_THIS_FILE(id_)    enum { spyer_file_id_ = (id_) };
+#else
+    #define SPYER_THIS_FILE(id_)
+#endif
+
+/***************************************************************************************
+*   Trace Channels of Spyer, One Bit for Every Subsystem. 
+*
+*   NOTE: (1) Used to Build the Mask of Runtime Filter (SPYER_FILTER_ENABLE), the 
+*             SPYER_XXX_ENABLE Switches Still Decide What is Compiled in. 
+***************************************************************************************/
+#define SPYER_CH_NONE       ((uint32_t)0x00000000)
+#define SPYER_CH_USER       ((uint32_t)0x00000001)  /* SPYER() of Application */
+#define SPYER_CH_TICKS      ((uint32_t)0x00000002)
+#define SPYER_CH_WATCHDOG   ((uint32_t)0x00000004)
+#define SPYER_CH_MPOOL      ((uint32_t)0x00000008)
+#define SPYER_CH_EPOOL      ((uint32_t)0x00000010)
+#define SPYER_CH_HPOOL      ((uint32_t)0x00000020)
+#define SPYER_CH_CPOOL      ((uint32_t)0x00000040)
+#define SPYER_CH_ECHAIN     ((uint32_t)0x00000080)
+#define SPYER_CH_ERING      ((uint32_t)0x00000100)
+#define SPYER_CH_ACHAIN     ((uint32_t)0x00000200)
+#define SPYER_CH_RCHAIN     ((uint32_t)0x00000400)
+#define SPYER_CH_UCHAIN     ((uint32_t)0x00000800)
+#define SPYER_CH_QUEUE      ((uint32_t)0x00001000)
+#define SPYER_CH_STACK      ((uint32_t)0x00002000)
+#define SPYER_CH_MANAGER    ((uint32_t)0x00004000)
+#define SPYER_CH_ACTIVEX    ((uint32_t)0x00008000)
+#define SPYER_CH_TIMER      ((uint32_t)0x00010000)
+#define SPYER_CH_HSM        ((uint32_t)0x00020000)
+#define SPYER_CH_FSM        ((uint32_t)0x00040000)
+#define SPYER_CH_ALL        ((uint32_t)0xFFFFFFFF)
+
+    /***********************************************************************************
+    *   The Mask of Runtime Filter after the Initialization. 
+    ***********************************************************************************/
+    #ifndef SPYER_FILTER_DEFAULT
+    #define SPYER_FILTER_DEFAULT    SPYER_CH_ALL    /* Default is All Channels */
+    #endif  /* End of SPYER_FILTER_DEFAULT */
+
 #ifdef SPYER_ENABLE      /* SPYER_ENABLE Defined -- Spy Debuger Enabled */
 
+#ifdef SPYER_BINARY_ENABLE
+
+    /***********************************************************************************
+    *   Binary Record of Spyer. 
+    *
+    *   Instead of Formatting the Strings on the Target, Every Record is Written into 
+    *   the Debug Buffer as the Binary Block below, and is Formatted by the Host 
+    *   Decoder "spyer_decode.py", which Reads the Format Strings from the ELF Image. 
+    *
+    *               -------------------------------------
+    *               |  SPYER_SYNC                (1)    |
+    *               |  Number of Arguments "n"   (1)    |
+    *               |  Timestamp, sys_ticks      (4)    |
+    *               |  Address of Format String  (P)    |   Type ID of Record
+    *               |  Argument 1                (P)    |
+    *               |  ...  ...                         |
+    *               |  Argument n                (P)    |
+    *               -------------------------------------
+    *
+    *   Where P is sizeof(spyer_arg_t), the Size of Pointer, the Byte Order is the 
+    *   Native Byte Order of the Target. 
+    ***********************************************************************************/
+    typedef unsigned long spyer_arg_t;      /* Integral Type with the Size of Pointer */
+
+    #define SPYER_SYNC        ((uint8_t)0xA5)   /* Synchronization Byte of Record */
+    #define SPYER_MAX_ARGS    8                 /* Maximum Number of Arguments */
+
+    /***********************************************************************************
+    *   Description: Write One Binary Record into the Debug Buffer. 
+    *   Argument: format -- The Format Strings, Only Its Address is Recorded. 
+    *             argc -- The Number of Arguments, Not More than SPYER_MAX_ARGS. 
+    *             ... -- The Arguments, Every One MUST be spyer_arg_t. 
+    *   Return: none
+    *   NOTE:
+    *   (1) Called Through the spyer_() Macro, which Counts and Casts the Arguments. 
+    *   (2) The "%s" Argument is Recorded as the Address, so It MUST Points to the 
+    *       Constant Strings in the Image. 
+    ***********************************************************************************/
+    SPYER_EXT void_t spyer_bin_(const int8_t * format, uint8_t argc, ...); 
+
+    /***********************************************************************************
+    *   Count the Arguments (0 to SPYER_MAX_ARGS), and Cast Every One to spyer_arg_t. 
+    ***********************************************************************************/
+    #define SPYER_ARGC_(...)      SPYER_ARGC_N_(0, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+    #define SPYER_ARGC_N_(a0_, a1_, a2_, a3_, a4_, a5_, a6_, a7_, a8_, n_, ...)   n_
+    #define SPYER_CAT_(a_, b_)    SPYER_CAT2_(a_, b_)
+    #define SPYER_CAT2_(a_, b_)   a_##b_
+    #define SPYER_CAST_(a_)       , ((spyer_arg_t)(a_))
+    #define SPYER_MAP_(...)       SPYER_CAT_(SPYER_MAP_, SPYER_ARGC_(__VA_ARGS__))(__VA_ARGS__)
+    #define SPYER_MAP_0()
+    #define SPYER_MAP_1(a_)       SPYER_CAST_(a_)
+    #define SPYER_MAP_2(a_, ...)  SPYER_CAST_(a_) SPYER_MAP_1(__VA_ARGS__)
+    #define SPYER_MAP_3(a_, ...)  SPYER_CAST_(a_) SPYER_MAP_2(__VA_ARGS__)
+    #define SPYER_MAP_4(a_, ...)  SPYER_CAST_(a_) SPYER_MAP_3(__VA_ARGS__)
+    #define SPYER_MAP_5(a_, ...)  SPYER_CAST_(a_) SPYER_MAP_4(__VA_ARGS__)
+    #define SPYER_MAP_6(a_, ...)  SPYER_CAST_(a_) SPYER_MAP_5(__VA_ARGS__)
+    #define SPYER_MAP_7(a_, ...)  SPYER_CAST_(a_) SPYER_MAP_6(__VA_ARGS__)
+    #define SPYER_MAP_8(a_, ...)  SPYER_CAST_(a_) SPYER_MAP_7(__VA_ARGS__)
+
+#ifdef SPYER_INTERN_ENABLE
+
+    /***********************************************************************************
+    *   Interned Binary Record of Spyer. 
+    *
+    *   The Format Strings is not Linked into the Image at All, the Record Carries the 
+    *   ID of Call Site Instead of the Address of Format Strings: 
+    *
+    *               -------------------------------------
+    *               |  SPYER_SYNC_ID             (1)    |
+    *               |  Number of Arguments "n"   (1)    |
+    *               |  Timestamp, sys_ticks      (4)    |
+    *               |  ID of Call Site           (4)    |   (File ID << 16) | Line
+    *               |  Argument 1                (P)    |
+    *               |  ...  ...                         |
+    *               |  Argument n                (P)    |
+    *               -------------------------------------
+    *
+    *   The Line is the Line of the SPYER_XXX() Macro Name. spyer_dict.py Scans the 
+    *   Sources and Writes the Dictionary which Maps the ID into the Format Strings, 
+    *   File and Line, spyer_decode.py Formats the Records with It. 
+    ***********************************************************************************/
+    #define SPYER_SYNC_ID     ((uint8_t)0xA6)   /* Synchronization Byte of Record */
+
+    /***********************************************************************************
+    *   Description: Write One Interned Binary Record into the Debug Buffer. 
+    *   Argument: id -- The ID of Call Site. 
+    *             argc -- The Number of Arguments, Not More than SPYER_MAX_ARGS. 
+    *             ... -- The Arguments, Every One MUST be spyer_arg_t. 
+    *   Return: none
+    ***********************************************************************************/
+    SPYER_EXT void_t spyer_id_(uint32_t id, uint8_t argc, ...); 
+
+    /***********************************************************************************
+    *   spyer_() Macros, the SPYER_XXX() Macros of Every Module Expand into It. 
+    *   The "format" is Dropped at Here. 
+    ***********************************************************************************/
+    #define SPYER_ID_()     (((uint32_t)spyer_file_id_ << 16) | (uint32_t)__LINE__)
+    #define spyer_(format, ...)   \
+        spyer_id_(SPYER_ID_(), (uint8_t)SPYER_ARGC_(__VA_ARGS__) SPYER_MAP_(__VA_ARGS__))
+
+#else
+
+    /***********************************************************************************
+    *   spyer_() Macros, the SPYER_XXX() Macros of Every Module Expand into It. 
+    ***********************************************************************************/
+    #define spyer_(format, ...)   \
+        spyer_bin_((const int8_t *)(format), (uint8_t)SPYER_ARGC_(__VA_ARGS__) \
+                   SPYER_MAP_(__VA_ARGS__))
+
+#endif      /* End of SPYER_INTERN_ENABLE */
+
+#else
+
     /***********************************************************************************
     *   Description: First, Format the Arguments under the Control of the String 
     *                Pointed to by "format". 
@@ -81,14 +246,70 @@ extern "C" {
     *           More Subsequent Arguments. 
     ***********************************************************************************/
     SPYER_EXT void_t spyer_(const int8_t * format, ...); 
+
+#endif      /* End of SPYER_BINARY_ENABLE */
+ 
+#ifdef SPYER_FILTER_ENABLE
+
+    /***********************************************************************************
+    *   Runtime Filter of Spyer. 
+    *
+    *   "spyer_mask" is the Global Mask of Channels. "spyer_live_" is the Mask in 
+    *   Effect, It is "spyer_mask" Normally, and is SPYER_CH_ALL while the Manager 
+    *   Runs an Active Object whose "trace" Flag is Set, so All the Records Emitted 
+    *   in the RTC Step of that Active Object Pass. 
+    *
+    *   NOTE: (1) A Disabled Record Costs One Test and Branch, the Arguments are not 
+    *             Evaluated, and Nothing is Formatted or Copied. 
+    *         (2) The Records Emitted by the Interrupts which Preempt the RTC Step of 
+    *             the Traced Active Object Pass too. 
+    ***********************************************************************************/
+    SPYER_EXT uint32_t volatile spyer_mask; 
+    SPYER_EXT uint32_t volatile spyer_live_; 
+
+    /***********************************************************************************
+    *   Description: Set the Global Mask of Channels. 
+    *   Argument: mask -- The Channels Switched On, SPYER_CH_XXX Ored Together. 
+    *   Return: none
+    ***********************************************************************************/
+    SPYER_EXT void_t spyer_filter(uint32_t mask); 
+
+    /***********************************************************************************
+    *   Enter and Leave the RTC Step of Active Object, Called by the Manager. 
+    ***********************************************************************************/
+    #define spyer_enter_(trace_)    \
+        (spyer_live_ = ((trace_) != (uint8_t)0) ? SPYER_CH_ALL : spyer_mask)
+    #define spyer_leave_()          (spyer_live_ = spyer_mask)
+
+    /***********************************************************************************
+    *   spyer_ch_() Macros, Emit the Record only when the "channel_" is Switched On. 
+    ***********************************************************************************/
+    #define spyer_ch_(channel_, format, ...)    \
+        do {                                    \
+            if ((spyer_live_ & (channel_)) != (uint32_t)0) { \
+                spyer_(format, ##__VA_ARGS__);  \
+            }                                   \
+        } while (0)
+
+#else
+
+    #define spyer_filter(mask_)     ((void_t)0)
+    #define spyer_enter_(trace_)    ((void_t)0)
+    #define spyer_leave_()          ((void_t)0)
+    #define spyer_ch_(channel_, format, ...)    spyer_(format, ##__VA_ARGS__)
+
+#endif      /* End of SPYER_FILTER_ENABLE */
  
     /***********************************************************************************
     *   SPYER() Macros. 
     ***********************************************************************************/
-    #define SPYER(format, ...)   spyer_((const int8_t *)format, ##__VA_ARGS__)
+    #define SPYER(format, ...)   spyer_ch_(SPYER_CH_USER, (const int8_t *)format, ##__VA_ARGS__)
 
 #else                       /* Spyer Debuger Disabled */
 
+    #define spyer_filter(mask_)     ((void_t)0)
+    #define spyer_enter_(trace_)    ((void_t)0)
+    #define spyer_leave_()          ((void_t)0)
     #define SPYER(format, ...)   ((void_t)0)
 
 #endif      /* End of SPYER_ENABLE */
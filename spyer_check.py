@@ -0,0 +1,273 @@
+#!/usr/bin/env python3
+########################################################################################
+#   The MIT License (MIT)
+#   Copyright (C) 2005 JinHui Han, <Email: ferrethan485@sohu.com, QQ: 1901589440>
+#
+#   Permission is hereby granted, free of charge, to any person obtaining a copy
+#   of this software and associated documentation files (the "Software"), to deal
+#   in the Software without restriction, including without limitation the rights
+#   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+#   copies of the Software, and to permit persons to whom the Software is
+#   furnished to do so, subject to the following conditions:
+#
+#   The above copyright notice and this permission notice shall be included in
+#   all copies or substantial portions of the Software.
+#
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+#   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+#   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+#   THE SOFTWARE.
+########################################################################################
+
+########################################################################################
+#   Component : Active Object Application FrameWork
+#   Group : Spy Debuger
+#   File Name : spyer_check.py
+#   Version : 1.0
+#   Description : Round-Trip Check of the Binary Records of Spyer on the POSIX_HOST Port
+#   Author : JinHui Han
+#   History :
+#          Name            Date                    Remarks
+#       JinHui Han      05-02-2005      Created Initial Version 1.0
+#       JinHui Han      05-02-2005      Verified Version 1.0
+########################################################################################
+#
+#   Usage: spyer_check.py [--keep <directory>]
+#
+#   Builds the Microbenchmarks (bench.c) in a Scratch Copy of the Tree, with the Spyer
+#   Switches of config.h Turned On and BENCH_ITERATIONS Cut Down, Runs Them, and
+#   Decodes the Records Written into the Standard Output by spyer_decode.py:
+#       binary  -- SPYER_BINARY_ENABLE and Every SPYER_XXX_ENABLE Channel, Decoded
+#                  with the ELF Image.
+#       intern  -- SPYER_INTERN_ENABLE in Addition, Decoded with the Dictionary which
+#                  spyer_dict.py Generates from the Sources. The Messages must be the
+#                  Messages of "binary", the Numbers Aside.
+#       filter  -- SPYER_FILTER_ENABLE in Addition, SPYER_FILTER_DEFAULT Switches On
+#                  the Channels of FILTER Only. The Records must Come from Their
+#                  Files, and must be the Records of "intern" from Those Files.
+#
+#   Every Variant must Emit Records, the Records must Tile the Trace without a Gap,
+#   and Every Record must be Decoded. The Exit Status is 1 on the First Failure.
+#
+#   The Image is Linked with -no-pie, so the Addresses of Format Strings Carried by
+#   the Records are the Addresses in the ELF Image.
+########################################################################################
+
+import argparse
+import glob
+import json
+import os
+import re
+import shutil
+import struct
+import subprocess
+import sys
+import tempfile
+
+SPYER_SYNC = 0xA5
+SPYER_SYNC_ID = 0xA6
+ITERATIONS = 64
+# The Channels Switched On by the Runtime Filter, and the Files Emitting Them
+FILTER = {'SPYER_CH_MPOOL': 'mpool.c', 'SPYER_CH_HSM': 'hsm.c'}
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+# The Switches which are not the Trace Channels
+MODES = ('SPYER_BINARY_ENABLE', 'SPYER_INTERN_ENABLE', 'SPYER_FILTER_ENABLE')
+
+
+class Failure(Exception):
+    pass
+
+
+def channels(config):
+    """Returns the SPYER_XXX_ENABLE Channels Switched in config.h."""
+    found = re.findall(r'^#undef\s+(SPYER_[A-Z0-9_]+_ENABLE)\b', config, re.M)
+    return [name for name in found if name not in MODES]
+
+
+def configure(tree, switches, extra=()):
+    """Turns the Switches On in config.h of the Scratch Tree, from the Original."""
+    path = os.path.join(tree, 'config.h')
+    with open(os.path.join(HERE, 'config.h'), 'rb') as f:
+        text = f.read().decode('latin-1')
+    for name in switches:
+        text, count = re.subn(r'^#undef(\s+)%s\b' % name, r'#define\g<1>%s' % name,
+                              text, flags=re.M)
+        if count != 1:
+            raise Failure('config.h: no "#undef %s"' % name)
+    text, count = re.subn(r'^#define(\s+)BENCH_ITERATIONS\s+\d+',
+                          r'#define\g<1>BENCH_ITERATIONS    %d' % ITERATIONS,
+                          text, flags=re.M)
+    if count != 1:
+        raise Failure('config.h: no "#define BENCH_ITERATIONS"')
+    # The Extra Definitions Follow SPYER_ENABLE, before Any Header Reads Them
+    text = re.sub(r'^(#define\s+SPYER_ENABLE\b[^\n]*\n)',
+                  lambda match: match.group(1) + ''.join(line + '\r\n' for line in extra),
+                  text, count=1, flags=re.M)
+    with open(path, 'wb') as f:
+        f.write(text.encode('latin-1'))
+
+
+def emit(tree):
+    """Builds and Runs the Microbenchmarks, Returns the Image and the Trace."""
+    build = subprocess.run(['make', '-s', '-C', tree, 'bench', 'CFLAGS=-O1 -g -no-pie'],
+                           stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+    if build.returncode != 0:
+        raise Failure('build failed:\n' + build.stdout.decode('latin-1'))
+    image = os.path.join(tree, 'build', 'bench')
+    trace = os.path.join(tree, 'build', 'trace.bin')
+    with open(trace, 'wb') as f:
+        run = subprocess.run([image, os.path.join(tree, 'build', 'bench.json')], stdout=f)
+    if run.returncode != 0:
+        raise Failure('bench exits with %d' % run.returncode)
+    return image, trace
+
+
+def records(image, trace):
+    """Returns the ID of Call Site of Every Record (None if not Interned), the
+    Records must Tile the Trace."""
+    with open(image, 'rb') as f:
+        header = f.read(6)
+    ptr_size = 8 if header[4] == 2 else 4           # ELFCLASS64
+    order = '<' if header[5] == 1 else '>'          # ELFDATA2LSB
+    with open(trace, 'rb') as f:
+        data = f.read()
+    sites = []
+    position = 0
+    while position < len(data):
+        sync = data[position]
+        if sync not in (SPYER_SYNC, SPYER_SYNC_ID) or position + 10 > len(data):
+            raise Failure('%s: no record at offset %d' % (trace, position))
+        if sync == SPYER_SYNC:
+            sites.append(None)
+            id_size = ptr_size
+        else:
+            sites.append(struct.unpack_from(order + 'I', data, position + 6)[0])
+            id_size = 4
+        position += 2 + 4 + id_size + data[position + 1] * ptr_size
+    if position != len(data) or not sites:
+        raise Failure('%s: %d records, %d bytes left'
+                      % (trace, len(sites), position - len(data)))
+    return sites
+
+
+def decode(tree, trace, image=None, dictionary=None):
+    """Decodes the Trace with spyer_decode.py, Returns the Messages."""
+    command = [sys.executable, os.path.join(tree, 'spyer_decode.py')]
+    if image is not None:
+        command += ['--elf', image]
+    if dictionary is not None:
+        command += ['--dict', dictionary]
+    result = subprocess.run(command + [trace], stdout=subprocess.PIPE, check=True)
+    # Drop the Timestamps, "[%10d] "
+    return [line[13:] for line in result.stdout.decode('latin-1').splitlines()]
+
+
+def check_binary(tree, names):
+    configure(tree, ['SPYER_ENABLE', 'SPYER_BINARY_ENABLE'] + names)
+    image, trace = emit(tree)
+    count = len(records(image, trace))
+    messages = decode(tree, trace, image=image)
+    if len(messages) != count:
+        raise Failure('binary: %d of %d records decoded' % (len(messages), count))
+    for message in messages:
+        if re.search(r'<[0-9A-F]+>', message):
+            raise Failure('binary: "%%s" not found in the image: %s' % message)
+    print('binary: %d records decoded' % count)
+    return messages
+
+
+def dictionary(tree):
+    """Generates the Dictionary from the Sources of the Scratch Tree."""
+    path = os.path.join(tree, 'build', 'dict.json')
+    sources = sorted(glob.glob(os.path.join(tree, '*.c')))
+    subprocess.run([sys.executable, os.path.join(tree, 'spyer_dict.py'), '-o', path]
+                   + sources, check=True)
+    with open(path) as f:
+        return path, json.load(f)
+
+
+def masked(messages):
+    """The Messages Sorted, with the Numbers (Addresses, Counters) Masked."""
+    return sorted(re.sub(r'-?[0-9A-Fa-f]*[0-9][0-9A-Fa-f]*', 'N', message)
+                  for message in messages)
+
+
+def check_intern(tree, names, expected):
+    configure(tree, ['SPYER_ENABLE', 'SPYER_BINARY_ENABLE', 'SPYER_INTERN_ENABLE'] + names)
+    image, trace = emit(tree)
+    sites = records(image, trace)
+    path, entries = dictionary(tree)
+    unknown = [site for site in sites if site is None or '%d' % site not in entries]
+    if unknown:
+        raise Failure('intern: %d records of no call site, the first is %r'
+                      % (len(unknown), unknown[0]))
+    messages = decode(tree, trace, image=image, dictionary=path)
+    if len(messages) != len(sites):
+        raise Failure('intern: %d of %d records decoded' % (len(messages), len(sites)))
+    # The Threads of the Benchmarks Interleave, so the Order and the Numbers Differ
+    if masked(messages) != masked(expected):
+        raise Failure('intern: the messages differ from the binary records')
+    print('intern: %d records decoded, %d call sites in the dictionary'
+          % (len(sites), len(entries)))
+    return messages, [entries['%d' % site]['file'] for site in sites]
+
+
+def check_filter(tree, names, expected, files):
+    mask = ' | '.join(sorted(FILTER))
+    configure(tree, ['SPYER_ENABLE', 'SPYER_BINARY_ENABLE', 'SPYER_INTERN_ENABLE',
+                     'SPYER_FILTER_ENABLE'] + names,
+              ['#define SPYER_FILTER_DEFAULT    (%s)' % mask])
+    image, trace = emit(tree)
+    sites = records(image, trace)
+    path, entries = dictionary(tree)
+    emitted = set(entries['%d' % site]['file'] for site in sites if '%d' % site in entries)
+    if emitted != set(FILTER.values()):
+        raise Failure('filter: records from %s, not from %s'
+                      % (', '.join(sorted(emitted)), ', '.join(sorted(FILTER.values()))))
+    messages = decode(tree, trace, image=image, dictionary=path)
+    wanted = [message for message, name in zip(expected, files) if name in FILTER.values()]
+    if len(messages) != len(sites) or masked(messages) != masked(wanted):
+        raise Failure('filter: %d records, %d of %d expected'
+                      % (len(sites), len(messages), len(wanted)))
+    print('filter: %d records of %s' % (len(sites), mask))
+
+
+def scratch(keep):
+    """Copies the Tree into a Scratch Directory."""
+    tree = keep if keep is not None else tempfile.mkdtemp(prefix='spyer_')
+    if os.path.isdir(tree):
+        shutil.rmtree(tree)
+    os.makedirs(tree)
+    for pattern in ('*.c', '*.h', '*.py', 'Makefile'):
+        for path in glob.glob(os.path.join(HERE, pattern)):
+            shutil.copy(path, tree)
+    return tree
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description='Round-trip check of the spyer records.')
+    parser.add_argument('--keep', help='scratch directory, kept after the check')
+    args = parser.parse_args(argv[1:])
+
+    with open(os.path.join(HERE, 'config.h'), 'rb') as f:
+        names = channels(f.read().decode('latin-1'))
+    tree = scratch(args.keep)
+    try:
+        expected = check_binary(tree, names)
+        expected, files = check_intern(tree, names, expected)
+        check_filter(tree, names, expected, files)
+    except (Failure, subprocess.CalledProcessError) as error:
+        sys.stderr.write('spyer_check: %s\n' % error)
+        return 1
+    finally:
+        if args.keep is None:
+            shutil.rmtree(tree, ignore_errors=True)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
@@ -0,0 +1,209 @@
+#!/usr/bin/env python3
+########################################################################################
+#   The MIT License (MIT)
+#   Copyright (C) 2005 JinHui Han, <Email: ferrethan485@sohu.com, QQ: 1901589440>
+#
+#   Permission is hereby granted, free of charge, to any person obtaining a copy
+#   of this software and associated documentation files (the "Software"), to deal
+#   in the Software without restriction, including without limitation the rights
+#   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+#   copies of the Software, and to permit persons to whom the Software is
+#   furnished to do so, subject to the following conditions:
+#
+#   The above copyright notice and this permission notice shall be included in
+#   all copies or substantial portions of the Software.
+#
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+#   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+#   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+#   THE SOFTWARE.
+########################################################################################
+
+########################################################################################
+#   Component : Active Object Application FrameWork
+#   Group : Spy Debuger
+#   File Name : spyer_decode.py
+#   Version : 1.0
+#   Description : Host Decoder for the Binary Records of Spyer (SPYER_BINARY_ENABLE)
+#   Author : JinHui Han
+#   History :
+#          Name            Date                    Remarks
+#       JinHui Han      05-02-2005      Created Initial Version 1.0
+#       JinHui Han      05-02-2005      Verified Version 1.0
+########################################################################################
+#
+#   Usage: spyer_decode.py [--elf <image>] [--dict <dictionary>] [--ptr-size <n>]
+#                          [<trace file>]
+#
+#   Reads the Binary Records Captured from the Debug Serial Port (from the Trace File,
+#   or from the Standard Input), Looks Up the Format Strings and the "%s" Arguments
+#   in the ELF Image of the Target, and Prints the Human-Readable Messages as the
+#   Formatted spyer_() Output.
+#
+#   The Interned Records (SPYER_INTERN_ENABLE) Carry the ID of Call Site, their Format
+#   Strings are Looked Up in the Dictionary Generated by spyer_dict.py. The ELF Image
+#   is then Optional, Only the "%s" Arguments Need It.
+#
+#   The Layout of Record is Described in spyer.h. The Size of Pointer and the Byte
+#   Order are Taken from the ELF Image, or from the Options without the Image.
+########################################################################################
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+SPYER_SYNC = 0xA5
+SPYER_SYNC_ID = 0xA6
+SPYER_MAX_ARGS = 8
+
+# Conversion Specifiers Used by the Format Strings of spyer_()
+SPEC = re.compile(r'%([-+ #0]*\d*(?:\.\d+)?)(?:hh|h|ll|l|L)?([diouxXcsp%])')
+
+
+class Image(object):
+    """The Loadable Sections of the ELF Image, Used to Read the Constant Strings."""
+
+    def __init__(self, path, ptr_size=4, order='<'):
+        self.sections = []
+        if path is None:
+            # No Image, the Interned Records Only
+            self.data = None
+            self.ptr_size = ptr_size
+            self.order = order
+            return
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF':
+            raise ValueError('%s is not an ELF image' % path)
+        self.is64 = (self.data[4] == 2)
+        self.order = '<' if self.data[5] == 1 else '>'
+        self.ptr_size = 8 if self.is64 else 4
+        if self.is64:
+            shoff, = struct.unpack_from(self.order + 'Q', self.data, 0x28)
+            shentsize, shnum = struct.unpack_from(self.order + 'HH', self.data, 0x3A)
+            layout = 'IIQQQQ'
+        else:
+            shoff, = struct.unpack_from(self.order + 'I', self.data, 0x20)
+            shentsize, shnum = struct.unpack_from(self.order + 'HH', self.data, 0x2E)
+            layout = 'IIIIII'
+        for index in range(shnum):
+            _, kind, flags, addr, offset, size = struct.unpack_from(
+                self.order + layout, self.data, shoff + index * shentsize)
+            # SHF_ALLOC, and not SHT_NOBITS (.bss)
+            if (flags & 0x2) and kind != 8 and size:
+                self.sections.append((addr, addr + size, offset))
+
+    def string(self, address):
+        """Returns the C String at the Address, or None if not in the Image."""
+        if self.data is None:
+            return None
+        for start, end, offset in self.sections:
+            if start <= address < end:
+                begin = offset + (address - start)
+                stop = self.data.find(b'\0', begin, offset + (end - start))
+                if stop < 0:
+                    return None
+                return self.data[begin:stop].decode('latin-1')
+        return None
+
+
+def format_record(image, fmt, args):
+    """Formats the Arguments as the Target sprintf() would do."""
+    bits = image.ptr_size * 8
+    values = iter(args)
+
+    def convert(match):
+        flags, kind = match.group(1), match.group(2)
+        if kind == '%':
+            return '%'
+        value = next(values, 0)
+        if kind in 'di':
+            if value >= (1 << (bits - 1)):
+                value -= (1 << bits)
+            return ('%' + flags + 'd') % value
+        if kind == 's':
+            text = image.string(value)
+            return ('%' + flags + 's') % (text if text is not None else '<%X>' % value)
+        if kind == 'c':
+            return chr(value & 0xFF)
+        if kind == 'p':
+            return '0x%X' % value
+        return ('%' + flags + kind) % value
+
+    return SPEC.sub(convert, fmt)
+
+
+def lookup(image, dictionary, sync, data, position):
+    """Returns the Format Strings and the Size of Type ID, or None if Unknown."""
+    if sync == SPYER_SYNC:
+        if image.data is None:
+            return None, image.ptr_size
+        word = image.order + ('Q' if image.ptr_size == 8 else 'I')
+        fmt_addr, = struct.unpack_from(word, data, position)
+        return image.string(fmt_addr), image.ptr_size
+    site, = struct.unpack_from(image.order + 'I', data, position)
+    entry = dictionary.get('%d' % site)
+    return (entry['format'] if entry is not None else None), 4
+
+
+def decode(image, dictionary, stream, output):
+    """Decodes the Records, Resynchronizes on the Sync Byte after Garbage."""
+    ptr = image.ptr_size
+    word = image.order + ('Q' if ptr == 8 else 'I')
+    data = stream.read()
+    position = 0
+    while position + 2 + 4 + 4 <= len(data):
+        sync = data[position]
+        if sync not in (SPYER_SYNC, SPYER_SYNC_ID) or data[position + 1] > SPYER_MAX_ARGS:
+            position += 1
+            continue
+        argc = data[position + 1]
+        id_size = ptr if sync == SPYER_SYNC else 4
+        size = 2 + 4 + id_size + argc * ptr
+        if position + size > len(data):
+            break
+        stamp, = struct.unpack_from(image.order + 'I', data, position + 2)
+        fmt, _ = lookup(image, dictionary, sync, data, position + 6)
+        if fmt is None:
+            # Not a Record, Resynchronize
+            position += 1
+            continue
+        args = [struct.unpack_from(word, data, position + 6 + id_size + ptr * n)[0]
+                for n in range(argc)]
+        output.write('[%10d] %s\n' % (stamp, format_record(image, fmt, args)))
+        position += size
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description='Decode the binary spyer records.')
+    parser.add_argument('--elf', help='ELF image of the target')
+    parser.add_argument('--dict', help='dictionary generated by spyer_dict.py')
+    parser.add_argument('--ptr-size', type=int, choices=(4, 8), default=4,
+                        help='size of pointer without the ELF image, default 4')
+    parser.add_argument('--big-endian', action='store_true',
+                        help='byte order without the ELF image')
+    parser.add_argument('trace', nargs='?', help='trace file, default stdin')
+    args = parser.parse_args(argv[1:])
+    if args.elf is None and args.dict is None:
+        parser.error('at least one of --elf and --dict is required')
+
+    image = Image(args.elf, args.ptr_size, '>' if args.big_endian else '<')
+    dictionary = {}
+    if args.dict is not None:
+        with open(args.dict) as f:
+            dictionary = json.load(f)
+    if args.trace is not None:
+        with open(args.trace, 'rb') as stream:
+            decode(image, dictionary, stream, sys.stdout)
+    else:
+        decode(image, dictionary, sys.stdin.buffer, sys.stdout)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
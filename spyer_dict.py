@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+########################################################################################
+#   The MIT License (MIT)
+#   Copyright (C) 2005 JinHui Han, <Email: ferrethan485@sohu.com, QQ: 1901589440>
+#
+#   Permission is hereby granted, free of charge, to any person obtaining a copy
+#   of this software and associated documentation files (the "Software"), to deal
+#   in the Software without restriction, including without limitation the rights
+#   to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+#   copies of the Software, and to permit persons to whom the Software is
+#   furnished to do so, subject to the following conditions:
+#
+#   The above copyright notice and this permission notice shall be included in
+#   all copies or substantial portions of the Software.
+#
+#   THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+#   IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+#   FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+#   AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+#   LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+#   OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+#   THE SOFTWARE.
+########################################################################################
+
+########################################################################################
+#   Component : Active Object Application FrameWork
+#   Group : Spy Debuger
+#   File Name : spyer_dict.py
+#   Version : 1.0
+#   Description : Dictionary Generator for the Interned Records of Spyer (SPYER_INTERN_ENABLE)
+#   Author : JinHui Han
+#   History :
+#          Name            Date                    Remarks
+#       JinHui Han      05-02-2005      Created Initial Version 1.0
+#       JinHui Han      05-02-2005      Verified Version 1.0
+########################################################################################
+#
+#   Usage: spyer_dict.py [-o <dictionary>] <source> ...
+#
+#   Scans the Sources for SPYER_THIS_FILE(id) and the SPYER_XXX() Invocations, and
+#   Writes the JSON Dictionary which Maps the ID of Call Site into the Format Strings,
+#   File and Line. spyer_decode.py Reads the Dictionary to Format the Records.
+#
+#   The ID of Call Site is (File ID << 16) | Line, where the Line is the Line of the
+#   SPYER_XXX() Macro Name, as the __LINE__ of a Macro Invocation which Spans Several
+#   Lines Expands to the Line of the Macro Name.
+########################################################################################
+
+import argparse
+import json
+import os
+import re
+import sys
+
+FILE_ID = re.compile(r'^\s*SPYER_THIS_FILE\s*\(\s*(\d+)\s*\)', re.M)
+INVOKE = re.compile(r'\bSPYER_[A-Z0-9_]*\s*\(')
+LITERAL = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+# The Strings between the Literals of Format, Only Blanks and Continuations
+GLUE = re.compile(r'^(?:\s|\\)*$')
+# The Macros which are not the Trace Points
+SKIP = ('SPYER_THIS_FILE', 'SPYER_ID_', 'SPYER_ARGC_', 'SPYER_ARGC_N_', 'SPYER_CAT_',
+        'SPYER_CAST_', 'SPYER_MAP_')
+
+
+def unescape(text):
+    """Converts the Escape Sequences of C into the Characters."""
+    return text.encode('latin-1').decode('unicode_escape')
+
+
+def strip_comments(text):
+    """Blanks the Comments, but Keeps the Line Breaks and the Offsets."""
+    def blank(match):
+        return re.sub(r'[^\n]', ' ', match.group(0))
+    return re.sub(r'/\*.*?\*/|//[^\n]*', blank, text, flags=re.S)
+
+
+def scan(path):
+    """Returns the File ID and the List of (Line, Format) in the Source."""
+    with open(path, 'rb') as f:
+        text = f.read().decode('latin-1').replace('\r\n', '\n')
+    text = strip_comments(text)
+    match = FILE_ID.search(text)
+    if match is None:
+        return None, []
+    sites = []
+    for invoke in INVOKE.finditer(text):
+        name = invoke.group(0).rstrip('( \t')
+        start = text.rfind('\n', 0, invoke.start()) + 1
+        if name in SKIP or text[start:invoke.start()].lstrip().startswith('#'):
+            continue
+        # The Adjacent Literals Following the Macro Name are Concatenated
+        fmt = []
+        position = invoke.end()
+        literal = LITERAL.search(text, position)
+        while literal is not None and GLUE.match(text[position:literal.start()]):
+            fmt.append(unescape(literal.group(1)))
+            position = literal.end()
+            literal = LITERAL.search(text, position)
+        if not fmt:
+            continue
+        line = text.count('\n', 0, invoke.start()) + 1
+        sites.append((line, ''.join(fmt)))
+    return int(match.group(1)), sites
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description='Generate the spyer dictionary.')
+    parser.add_argument('-o', '--output', help='dictionary file, default stdout')
+    parser.add_argument('sources', nargs='+', help='C sources of the image')
+    args = parser.parse_args(argv[1:])
+
+    dictionary = {}
+    owners = {}
+    for path in args.sources:
+        file_id, sites = scan(path)
+        if file_id is None:
+            continue
+        name = os.path.basename(path)
+        if not 0 < file_id < 0x10000:
+            sys.stderr.write('%s: file id %d out of range\n' % (name, file_id))
+            return 1
+        if file_id in owners:
+            sys.stderr.write('%s: file id %d already used by %s\n'
+                             % (name, file_id, owners[file_id]))
+            return 1
+        owners[file_id] = name
+        for line, fmt in sites:
+            dictionary['%d' % ((file_id << 16) | line)] = {
+                'file': name, 'line': line, 'format': fmt}
+
+    text = json.dumps(dictionary, indent=1, sort_keys=True)
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(text + '\n')
+    else:
+        sys.stdout.write(text + '\n')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
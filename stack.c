@@ -49,6 +49,7 @@
 
 ASSERT_THIS_FILE(stack.c)
 FAULT_THIS_FILE(stack.c)
+SPYER_THIS_FILE(14)
 
 /***************************************************************************************
 *   stack_init() Implementation.
@@ -93,7 +94,7 @@ int16_t stack_push(stack_t *me, void_t *data)
         me->max_cnt = me->head; /* Store Maximum Used so Far */
     }
 
-    SPYER_STACK("Data %X is Push into Stack %X, Usage %d, Max Usage %d. TimeStamp %d", \\
+    SPYER_STACK("Data %X is Push into Stack %X, Usage %d, Max Usage %d. TimeStamp %d", \
                  data, me, me->head, me->max_cnt, ticks_get()); 
 
     return TRUE; 
@@ -119,7 +120,7 @@ int16_t stack_pop(stack_t *me, void_t **data)
 
     *data = me->buffer[--me->head];     /* Get from the Head */
  
-    SPYER_STACK("Data %X is Pop from Stack %X, Usage %d. TimeStamp %d", \\
+    SPYER_STACK("Data %X is Pop from Stack %X, Usage %d. TimeStamp %d", \
                  *data, me, me->head, ticks_get()); 
     return TRUE; 
 }
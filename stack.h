@@ -139,7 +139,7 @@ STACK_EXT int16_t stack_pop(stack_t *me, void_t **data);
 *
 *   NOTE: 
 ***************************************************************************************/
-STACK_EXT uint16_t stack_usage(stack_t *me) 
+STACK_EXT uint16_t stack_usage(stack_t *me); 
 
 /***************************************************************************************
 *   Get the Margin of the Given Stack.
@@ -155,7 +155,8 @@ STACK_EXT uint16_t stack_usage(stack_t *me)
 STACK_EXT uint16_t stack_margin(stack_t *me); 
 
 #ifdef SPYER_STACK_ENABLE   /* Spy Debuger Enabled */
-    #define SPYER_STACK(format, ...)   spyer_((const int8_t *)format, ##__VA_ARGS__)
+    #define SPYER_STACK(format, ...)   \
+        spyer_ch_(SPYER_CH_STACK, (const int8_t *)format, ##__VA_ARGS__)
 #else                       /* Spy Debuger Disabled */
     #define SPYER_STACK(format, ...)   ((void_t)0)
 #endif  /* End of SPYER_STACK_ENABLE */
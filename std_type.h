@@ -94,7 +94,11 @@ typedef void *  ptr_t;
 #define PTR_MAX         4294967295U
 
 /* The Unsigned Integral Type of The Result of The sizeof Operator. */
+#ifdef __SIZE_TYPE__
+typedef __SIZE_TYPE__ size_t;  /* The Type of Compiler, Same as <stddef.h> on Host */
+#else
 typedef unsigned int size_t;   /* Others (e.g. <stdio.h>) Also Define */
+#endif
 
 /* Limits of size_t */
 #define SIZE_MAX        4294967295U
@@ -106,7 +110,11 @@ typedef unsigned int size_t;   /* Others (e.g. <stdio.h>) Also Define */
 *   Character Set shall have a Code Value when Used as the Long Character in an Integer 
 *   Character Constant.
 ***************************************************************************************/
+#ifdef __WCHAR_TYPE__
+typedef __WCHAR_TYPE__ wchar_t; /* The Type of Compiler, Same as <stddef.h> on Host */
+#else
 typedef unsigned short wchar_t; /* Also in <stdlib.h> and <inttypes.h> */
+#endif
 
 /*  Limits of wchar_t */
 #define WCHAR_MIN       0
@@ -137,6 +145,11 @@ typedef unsigned short bool_t;
 typedef float       float32_t;
 typedef double      float64_t;
 typedef long double float128_t;
+#if defined(__ARM_FP16_FORMAT_IEEE) || defined(__ARM_FP16_FORMAT_ALTERNATIVE)
+typedef __fp16      float16_t;
+#else
+typedef uint16_t    float16_t;  /* Storage Only, No Half Precision in the Compiler */
+#endif
 
 /* This is a Special  64 bit Float Type that is  8-byte Aligned */
 #define aligned_float64_t   (     double __attribute__((aligned(8))));
@@ -48,6 +48,7 @@
 #include "epool.h"
 #include "cpool.h"
 #include "echain.h"
+#include "ering.h"
 #include "rchain.h"
 #include "fsm.h"
 #include "hsm.h"
@@ -65,6 +66,7 @@
 
 ASSERT_THIS_FILE(temp.c)
 FAULT_THIS_FILE(temp.c)
+SPYER_THIS_FILE(15)
 
 typedef struct temp_tag {
     /***********************************************************************************
@@ -94,10 +96,11 @@ temp_t temp = {
         (int16_t)0,     /* Reset Request */
         (int16_t)0,     /* Pause Request */ 
         (uint16_t)10,   /* Priority */
+        (uint8_t)10,    /* Slot in Ready Set */
         (hsm_t *)hsm,   /* The Pointer of HSM hsm_t */
         (fsm_t *)fsm,   /* The Pointer of FSM fsm_t */
-        (chain_t *)0,   /* The Pointer of Event Chain */
-        (chain_t *)0,   /* The Pointer of Defer Event Chain */
+        ECHAIN_INITIALIZER, /* The Event Chain */
+        ECHAIN_INITIALIZER, /* The Defer Event Chain */
         temp_version,   /* Get Object's Version */
         temp_name,      /* Get Object's Name */
         temp_start,     /* Start */
@@ -76,6 +76,42 @@ TICKER_EXT void_t ticker_init(void_t);
 **************************************************************************************/
 TICKER_EXT void_t ticker(void_t);
 
+#ifdef TICKER_TICKLESS_ENABLE
+/**************************************************************************************
+*   Catch up the Ticks Slept in the Tickless Idle.
+*
+*   Description: Advance the System Ticks and All the Armed Timer by the Ticks 
+*                Elapsed during the Tickless Idle in One Step. 
+*   Argument: elapsed -- The Ticks Elapsed during the Idle. 
+*   Return: none
+*
+*   NOTE: 
+*   (1) Called by on_idle() after Wake-Up, before It Unlocks the Interrupts. 
+*   (2) The Clock Tick Interrupt MUST be Stopped during the Idle, so that ticker() 
+*       and ticker_catchup() are not Run at the Same Time. 
+*   (3) If the CPU Slept Longer than the Next Timer Expiry, the Timers are Handled 
+*       Expiry by Expiry, and no Timer Event is Lost. 
+**************************************************************************************/
+TICKER_EXT void_t ticker_catchup(uint32_t elapsed);
+
+#ifdef POSIX_HOST
+/**************************************************************************************
+*   Sleep in the Tickless Idle on Host.
+*
+*   Description: Stop the Clock Tick, Sleep until the "ticks" Elapsed or an "ISR" 
+*                Wakes the Manager Up, then Catch up the Ticks Slept. 
+*   Argument: ticks -- The Ticks may Sleep, TIMER_NEXT_NONE If No Timer is Armed. 
+*   Return: none
+*
+*   NOTE: 
+*   (1) Called by on_idle() with the Interrupts Locked. The Ticker Thread Keeps 
+*       Counting the Ticks on the Same Grid while the Clock Tick is Stopped, so 
+*       the Catch-Up is Exact. 
+**************************************************************************************/
+TICKER_EXT void_t ticker_sleep(uint32_t ticks);
+#endif  /* End of POSIX_HOST */
+#endif  /* End of TICKER_TICKLESS_ENABLE */
+
 #ifdef __cplusplus
 }
 #endif
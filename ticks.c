@@ -44,6 +44,8 @@
 #define  EXTERN_GLOBALS
 #include "ticks.h"
 
+SPYER_THIS_FILE(16)
+
 /***************************************************************************************
 *   ticks_init() Implementation.
 ***************************************************************************************/
@@ -68,6 +70,22 @@ void_t ticks_increase(void_t)
     SPYER_TICKS("System Ticks Increased, Ticks %d", sys_ticks); 
 }
 
+/***************************************************************************************
+*   ticks_advance() Implementation.
+***************************************************************************************/
+void_t ticks_advance(uint32_t ticks) 
+{
+    INT_LOCK_KEY_
+
+    /* Advance the System Ticks */
+    INT_LOCK_();
+    sys_ticks += ticks; 
+    INT_UNLOCK_(); 
+
+    /* Spyer */
+    SPYER_TICKS("System Ticks Advanced %d, Ticks %d", ticks, sys_ticks); 
+}
+
 /***************************************************************************************
 *   ticks_get() Implementation.
 ***************************************************************************************/
@@ -52,6 +52,15 @@ extern "C" {
 **************************************************************************************/
 TICKS_EXT uint32_t volatile sys_ticks; 
 
+/**************************************************************************************
+*   Initialize the Current System Time. 
+*
+*   Description: Clear the Current System Time in Time-Tick. 
+*   Argument: none
+*   Return: none. 
+**************************************************************************************/
+TICKS_EXT void_t ticks_init(void_t); 
+
 /**************************************************************************************
 *   Increment the Current System Time in Time-Tick. 
 *
@@ -61,11 +70,23 @@ TICKS_EXT uint32_t volatile sys_ticks;
 *
 *   NOTE: ticks_increase() is NOT Using a Critical Section Internal, It must be 
 *         Finished in the Manner of RTC (Run to Completion). It's Assmed Here that 
-*         ticks_increment() is Invoked from Only one ISR (The "Clock Ticker" 
+*         ticks_increase() is Invoked from Only one ISR (The "Clock Ticker" 
 *         Interrupt).
 **************************************************************************************/
 TICKS_EXT void_t ticks_increase(void_t); 
 
+/**************************************************************************************
+*   Advance the Current System Time by Many Time-Ticks. 
+*
+*   Description: Advance the Current System Time by "ticks" Time-Ticks in One Step. 
+*   Argument: ticks -- The Number of Time-Ticks Elapsed. 
+*   Return: none. 
+*
+*   NOTE: (1) Used by the Tickless Idle to Catch up the Ticks Slept. 
+*         (2) ticks_advance() is Using a Critical Section Internal.
+**************************************************************************************/
+TICKS_EXT void_t ticks_advance(uint32_t ticks); 
+
 /**************************************************************************************
 *   Pickup the Current System Time in Time-Tick. 
 *
@@ -79,7 +100,8 @@ TICKS_EXT uint32_t ticks_get(void_t);
 
 
 #ifdef SPYER_TICKS_ENABLE   /* Spy Debuger Enabled */
-    #define SPYER_TICKS(format, ...)   spyer_((const int8_t *)format, ##__VA_ARGS__)
+    #define SPYER_TICKS(format, ...)   \
+        spyer_ch_(SPYER_CH_TICKS, (const int8_t *)format, ##__VA_ARGS__)
 #else                       /* Spyer Debuger Disabled */
     #define SPYER_TICKS(format, ...)   ((void_t)0)
 #endif 
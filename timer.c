@@ -48,12 +48,16 @@
 #include "epool.h"
 #include "cpool.h"
 #include "echain.h"
+#include "ering.h"
 #include "rchain.h"
 #include "fsm.h"
 #include "hsm.h"
 #include "active.h"
 #include "achain.h"
 #include "callback.h"
+#include "stack.h"
+#include "lookup.h"
+#include "sche.h"
 #include "manager.h"
 
 #define  EXTERN_GLOBALS
@@ -61,6 +65,332 @@
 
 ASSERT_THIS_FILE(timer.c)
 FAULT_THIS_FILE(timer.c)
+SPYER_THIS_FILE(17)
+
+#ifdef TIMER_WHEEL_ENABLE
+/***************************************************************************************
+*   The Range of the Timing Wheel in Ticks.
+***************************************************************************************/
+#define TIMER_WHEEL_RANGE_  ((uint32_t)1 << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS))
+
+/***************************************************************************************
+*   timer_init() Implementation.
+***************************************************************************************/
+int16_t timer_init(void_t)
+{
+    uint16_t index; 
+
+    for (index = (uint16_t)0; 
+         index < (uint16_t)(TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS); ++index) { 
+        timer_wheel_[index] = (timer_t *)0; 
+    } 
+    timer_now_ = (uint32_t)0; 
+    return TRUE; 
+}
+
+/***************************************************************************************
+*   timer_insert_() Implementation. Internal
+*
+*   NOTE: Called with Interrupts Locked. 
+***************************************************************************************/
+static void_t timer_insert_(timer_t *me)
+{
+    uint32_t delta; 
+    uint32_t expire; 
+    uint16_t level; 
+    uint16_t slot; 
+
+    expire = me->expire; 
+    delta  = (uint32_t)(expire - timer_now_); 
+    if (delta >= TIMER_WHEEL_RANGE_) { 
+        /* Out of the Range, Park It in the Farthest Slot */
+        delta  = TIMER_WHEEL_RANGE_ - (uint32_t)1; 
+        expire = timer_now_ + delta; 
+    } 
+    /* Find the Level which Covers the Delta */
+    level = (uint16_t)0; 
+    while (delta >= ((uint32_t)1 << (TIMER_WHEEL_BITS * (level + (uint16_t)1)))) { 
+        ++level; 
+    } 
+    slot = (uint16_t)(level * TIMER_WHEEL_SLOTS) + 
+           (uint16_t)((expire >> (TIMER_WHEEL_BITS * level)) & (uint32_t)TIMER_WHEEL_MASK); 
+
+    /* Append This Timer into the Head of the Slot */
+    me->slot = slot; 
+    me->prev = me; 
+    me->next = timer_wheel_[slot]; 
+    if (timer_wheel_[slot] != (timer_t *)0) { 
+        timer_wheel_[slot]->prev = me; 
+    } 
+    timer_wheel_[slot] = me; 
+}
+
+/***************************************************************************************
+*   timer_remove_() Implementation. Internal
+*
+*   NOTE: Called with Interrupts Locked. The Timer is Marked as Disarmed. 
+***************************************************************************************/
+static void_t timer_remove_(timer_t *me)
+{
+    if (me->prev == me) { 
+        /* The Head of the Slot */
+        timer_wheel_[me->slot] = me->next; 
+        if (me->next != (timer_t *)0) { 
+            me->next->prev = me->next; 
+        } 
+    } 
+    else { 
+        me->prev->next = me->next; 
+        if (me->next != (timer_t *)0) { 
+            me->next->prev = me->prev; 
+        } 
+    } 
+    me->prev = (timer_t *)0; 
+    me->next = (timer_t *)0; 
+}
+
+/***************************************************************************************
+*   timer_arm() Implementation.
+***************************************************************************************/
+int16_t timer_arm(timer_t *me, int32_t count, int32_t interval, event_t *event)
+{
+    INT_LOCK_KEY_
+
+    ASSERT_REQUIRE(me != (timer_t *)0);
+    ASSERT_REQUIRE(me->prev == (timer_t *)0);         /* Timer Event must NOT be Used */
+    ASSERT_REQUIRE(count > (int32_t)0);               /* Cannot Arm a Timer with 0 Ticks */
+    ASSERT_REQUIRE(interval >= (int32_t)0); 
+    if((me == (timer_t *)0) || (me->prev != (timer_t *)0)) { 
+        return FALSE; 
+    } 
+    if ((count <= (int32_t)0) || (interval < (int32_t)0)) { 
+        return FALSE; 
+    } 
+
+    me->counter  = count;       /* Set the Counter  */
+    me->interval = interval;    /* Set the Interval */
+    me->event    = event;       /* Post Event when Expired */
+
+    INT_LOCK_();
+    me->expire = timer_now_ + (uint32_t)count; 
+    timer_insert_(me); 
+    INT_UNLOCK_();
+
+    SPYER_TIMER("Timer %X is Armed, Counter %d, Interval %d, Slot %d. TimeStamp %d", \
+                 me, me->counter, me->interval, me->slot, ticks_get()); 
+    return TRUE; 
+}
+
+/***************************************************************************************
+*   timer_rearm() Implementation.
+***************************************************************************************/
+int16_t timer_rearm(timer_t *me, int32_t count, int32_t interval)
+{
+    int16_t ret;
+
+    INT_LOCK_KEY_
+    
+    ASSERT_REQUIRE(me != (timer_t *)0);
+    ASSERT_REQUIRE(count > (int32_t)0); 
+    ASSERT_REQUIRE(interval >= (int32_t)0); 
+    if(me == (timer_t *)0) { 
+        return FALSE; 
+    } 
+    if ((count <= (int32_t)0) || (interval < (int32_t)0)) { 
+        return FALSE; 
+    } 
+
+    INT_LOCK_();
+    me->counter  = count; 
+    me->interval = interval; 
+    if (me->prev == (timer_t *)0) {  /* Is this Timer Disarmed ? */
+        ret = FALSE;    /* The Timer is Disarmed */
+    }
+    else { 
+        /* Move the Timer to the Slot of New Expire Tick */
+        timer_remove_(me); 
+        me->expire = timer_now_ + (uint32_t)count; 
+        timer_insert_(me); 
+        ret = TRUE;     /* The Timer is Armed */
+    }
+    INT_UNLOCK_();
+
+    SPYER_TIMER("Timer %X is Rearmed, Counter %d, Interval %d, Status %d. TimeStamp %d", \
+                 me, me->counter, me->interval, ret, ticks_get()); 
+    return ret;
+}
+
+/***************************************************************************************
+*   timer_disarm() Implementation.
+*
+*   NOTE: Disarm a Timer (no Harm in Disarming an Already Disarmed Timer)
+***************************************************************************************/
+int16_t timer_disarm(timer_t *me)
+{
+    int16_t ret;
+
+    INT_LOCK_KEY_
+
+    ASSERT_REQUIRE(me != (timer_t *)0);
+    if(me == (timer_t *)0) { 
+        return FALSE; 
+    } 
+
+    INT_LOCK_();
+    if (me->prev != (timer_t *)0) { /* Is the Timer Actually Armed ? */
+        /* The Timer was Armed */
+        timer_remove_(me); 
+        ret = TRUE;
+    }
+    else {
+        /* The Timer was not Armed */
+        ret = FALSE;
+    }
+    INT_UNLOCK_();
+
+    SPYER_TIMER("Timer %X is Disarmed, Counter %d, Interval %d, Status %d. TimeStamp %d", \
+                 me, me->counter, me->interval, ret, ticks_get()); 
+    return ret;
+}
+
+/***************************************************************************************
+*   timer() Implementation.
+***************************************************************************************/
+int16_t timer(void_t)
+{
+    int16_t  ret; 
+    uint16_t level; 
+    uint16_t slot; 
+    timer_t *timer;
+    timer_t *next;
+    event_t *event;
+
+    INT_LOCK_KEY_
+
+    INT_LOCK_();
+    ++timer_now_; 
+    /* Cascade the Higher Level when the Lower Level Wraps */
+    for (level = (uint16_t)1; level < (uint16_t)TIMER_WHEEL_LEVELS; ++level) { 
+        if ((timer_now_ & (((uint32_t)1 << (TIMER_WHEEL_BITS * level)) - (uint32_t)1)) 
+            != (uint32_t)0) { 
+            break; 
+        } 
+        slot = (uint16_t)(level * TIMER_WHEEL_SLOTS) + 
+               (uint16_t)((timer_now_ >> (TIMER_WHEEL_BITS * level)) & (uint32_t)TIMER_WHEEL_MASK); 
+        timer = timer_wheel_[slot]; 
+        timer_wheel_[slot] = (timer_t *)0; 
+        while (timer != (timer_t *)0) { 
+            next = timer->next; 
+            timer_insert_(timer); 
+            timer = next; 
+        } 
+    } 
+    slot = (uint16_t)(timer_now_ & (uint32_t)TIMER_WHEEL_MASK); 
+    INT_UNLOCK_();
+
+    /* Every Timer in the Current Slot of Level 0 is Expired */
+    for (;;) { 
+        INT_LOCK_();
+        timer = timer_wheel_[slot]; 
+        if (timer == (timer_t *)0) { 
+            INT_UNLOCK_();
+            break; 
+        } 
+        timer_remove_(timer); 
+        if (timer->interval != (int32_t)0) {    /* Is it Periodic Timer ? */
+            /* Rearm the Timer */
+            timer->expire = timer_now_ + (uint32_t)(timer->interval); 
+            timer_insert_(timer); 
+
+            SPYER_TIMER("Periodic Timer %X is Reset, Interval %d. TimeStamp %d", \
+                        timer, timer->interval, ticks_get()); 
+        }
+        else { 
+            SPYER_TIMER("One-Shot Timer %X is Disarmed. TimeStamp %d", \
+                        timer, ticks_get()); 
+        }
+        event = timer->event; 
+        INT_UNLOCK_();
+
+        ASSERT_REQUIRE(event != (event_t *)0); 
+        if (event != (event_t *)0) { 
+            ret = man_post(event); 
+            ASSERT_ENSURE(ret == TRUE); 
+            if (ret != TRUE) { 
+                /* Deal With Fault at Here */
+
+            } 
+            SPYER_TIMER("Timer Event %X is Post, Fault %d. TimeStamp %d", \
+                        event, ret, ticks_get()); 
+        }
+    } 
+    return TRUE; 
+}
+
+/***************************************************************************************
+*   timer_next() Implementation.
+***************************************************************************************/
+uint32_t timer_next(void_t)
+{
+    uint32_t next; 
+    uint32_t block; 
+    uint32_t ticks; 
+    uint16_t level; 
+    uint16_t index; 
+    uint16_t k; 
+
+    next = TIMER_NEXT_NONE; 
+    /* The First Armed Slot of Level 0 */
+    for (k = (uint16_t)1; k < TIMER_WHEEL_SLOTS; ++k) { 
+        index = (uint16_t)((timer_now_ + (uint32_t)k) & (uint32_t)TIMER_WHEEL_MASK); 
+        if (timer_wheel_[index] != (timer_t *)0) { 
+            next = (uint32_t)k; 
+            break; 
+        } 
+    } 
+    /* The First Cascade of Armed Slot of Higher Levels */
+    for (level = (uint16_t)1; level < (uint16_t)TIMER_WHEEL_LEVELS; ++level) { 
+        block = timer_now_ >> (TIMER_WHEEL_BITS * level); 
+        for (k = (uint16_t)1; k <= TIMER_WHEEL_SLOTS; ++k) { 
+            index = (uint16_t)(level * TIMER_WHEEL_SLOTS) + 
+                    (uint16_t)((block + (uint32_t)k) & (uint32_t)TIMER_WHEEL_MASK); 
+            if (timer_wheel_[index] != (timer_t *)0) { 
+                ticks = ((block + (uint32_t)k) << (TIMER_WHEEL_BITS * level)) - timer_now_; 
+                if (ticks < next) { 
+                    next = ticks; 
+                } 
+                break; 
+            } 
+        } 
+    } 
+    return next; 
+}
+
+/***************************************************************************************
+*   timer_advance() Implementation.
+*
+*   NOTE: No Armed Slot is Skipped, Because "elapsed" is Limited by timer_next(). 
+***************************************************************************************/
+int16_t timer_advance(uint32_t elapsed)
+{
+    INT_LOCK_KEY_
+
+    ASSERT_REQUIRE(elapsed > (uint32_t)0); 
+    if (elapsed == (uint32_t)0) { 
+        return FALSE; 
+    } 
+
+    INT_LOCK_();
+    /* Jump over the Empty Ticks */
+    timer_now_ += elapsed - (uint32_t)1; 
+    INT_UNLOCK_();
+
+    SPYER_TIMER("Timer is Advanced %d Ticks. TimeStamp %d", elapsed, ticks_get()); 
+    /* Handle the Last Tick */
+    return timer(); 
+}
+
+#else
 
 /***************************************************************************************
 *   timer_init() Implementation.
@@ -102,7 +432,7 @@ int16_t timer_arm(timer_t *me, int32_t count, int32_t interval, event_t *event)
     timer_list_ = me;
     INT_UNLOCK_();
 
-    SPYER_TIMER("Timer %X is Armed, Counter %d, Interval %d. TimeStamp %d", \\
+    SPYER_TIMER("Timer %X is Armed, Counter %d, Interval %d. TimeStamp %d", \
                  me, me->counter, me->interval, ticks_get()); 
     return TRUE; 
 }
@@ -136,7 +466,7 @@ int16_t timer_rearm(timer_t *me, int32_t count, int32_t interval)
     }
     INT_UNLOCK_();
 
-    SPYER_TIMER("Timer %X is Rearmed, Counter %d, Interval %d, Status %d. TimeStamp %d", \\
+    SPYER_TIMER("Timer %X is Rearmed, Counter %d, Interval %d, Status %d. TimeStamp %d", \
                  me, me->counter, me->interval, ret, ticks_get()); 
     return ret;
 }
@@ -162,7 +492,9 @@ int16_t timer_disarm(timer_t *me)
         ret = TRUE;
         if (me == timer_list_) {
             timer_list_ = me->next;
-            timer_list_->prev = timer_list_;
+            if (timer_list_ != (timer_t *)0) {  /* Not the Last in the List */
+                timer_list_->prev = timer_list_;
+            }
         }
         else {
             if (me->next != (timer_t *)0) {   
@@ -179,38 +511,35 @@ int16_t timer_disarm(timer_t *me)
     }
     INT_UNLOCK_();
 
-    SPYER_TIMER("Timer %X is Disarmed, Counter %d, Interval %d, Status %d. TimeStamp %d", \\
+    SPYER_TIMER("Timer %X is Disarmed, Counter %d, Interval %d, Status %d. TimeStamp %d", \
                  me, me->counter, me->interval, ret, ticks_get()); 
     return ret;
 }
 
 /***************************************************************************************
-*   task_timer() Implementation.
+*   timer() Implementation.
 ***************************************************************************************/
-int16_t task_timer(void_t)
+int16_t timer(void_t)
 {
     int16_t  ret; 
     timer_t *timer;
 
-    SPY_BEGIN_(SPY_TIMER_TASK_T, spy_timer_object_, (void_t *)&task_timer);
-        SPY_TIME_();                    /* Timestamp */
-        SPY_FUNCTION_(&task_timer);     /* This Timer Task */
-    SPY_END_();
-
     timer = timer_list_; 
     while (timer != (timer_t *)0) {
         if (--timer->counter == (int32_t)0) {   /* Is Timer about to Expire ? */
             if (timer->interval != (int32_t)0) {    /* Is it Periodic Timer ? */
                 timer->counter = timer->interval;   /* Rearm the Timer */
 
-                SPYER_TIMER("Periodic Timer %X is Reset, Interval %d. TimeStamp %d", \\
+                SPYER_TIMER("Periodic Timer %X is Reset, Interval %d. TimeStamp %d", \
                             timer, timer->interval, ticks_get()); 
             }
             else {   
                 /* One-Shot Timeout, Disarm by Removing it from the List */
                 if (timer == timer_list_) {
                     timer_list_ = timer->next;
-                    timer_list_->prev = timer_list_;
+                    if (timer_list_ != (timer_t *)0) {  /* Not the Last Event ? */
+                        timer_list_->prev = timer_list_;
+                    }
                 }
                 else {
                     if (timer->next != (timer_t *)0) {   /* Not the Last Event ? */
@@ -220,7 +549,7 @@ int16_t task_timer(void_t)
                 }
                 timer->prev = (timer_t *)0;         /* Mark the Event Disarmed */
 
-                SPYER_TIMER("One-Shot Timer %X is Disarmed. TimeStamp %d", \\
+                SPYER_TIMER("One-Shot Timer %X is Disarmed. TimeStamp %d", \
                             timer, ticks_get()); 
             }
 
@@ -232,10 +561,63 @@ int16_t task_timer(void_t)
                     /* Deal With Fault at Here */
 
                 } 
-                SPYER_TIMER("Timer Event %X is Post, Fault %d. TimeStamp %d", \\
+                SPYER_TIMER("Timer Event %X is Post, Fault %d. TimeStamp %d", \
                             timer->event, ret, ticks_get()); 
             }
         }
         timer = timer->next; 
     }
+    return TRUE; 
 }
+
+/***************************************************************************************
+*   timer_next() Implementation.
+***************************************************************************************/
+uint32_t timer_next(void_t)
+{
+    uint32_t next; 
+    timer_t *timer;
+
+    next = TIMER_NEXT_NONE; 
+    timer = timer_list_; 
+    while (timer != (timer_t *)0) {
+        if ((uint32_t)(timer->counter) < next) { 
+            next = (uint32_t)(timer->counter); 
+        } 
+        timer = timer->next; 
+    }
+    return next; 
+}
+
+/***************************************************************************************
+*   timer_advance() Implementation.
+*
+*   NOTE: No Timer is Expired before the Last Tick, Because "elapsed" is Limited by 
+*         timer_next(). 
+***************************************************************************************/
+int16_t timer_advance(uint32_t elapsed)
+{
+    timer_t *armed;
+
+    INT_LOCK_KEY_
+
+    ASSERT_REQUIRE(elapsed > (uint32_t)0); 
+    if (elapsed == (uint32_t)0) { 
+        return FALSE; 
+    } 
+
+    INT_LOCK_();
+    /* Count Down All the Timer except the Last Tick */
+    armed = timer_list_; 
+    while (armed != (timer_t *)0) {
+        armed->counter -= (int32_t)(elapsed - (uint32_t)1); 
+        armed = armed->next; 
+    }
+    INT_UNLOCK_();
+
+    SPYER_TIMER("Timer is Advanced %d Ticks. TimeStamp %d", elapsed, ticks_get()); 
+    /* Handle the Last Tick */
+    return timer(); 
+}
+
+#endif  /* End of TIMER_WHEEL_ENABLE */
@@ -47,6 +47,32 @@ extern "C" {
     #define TIMER_EXT   extern
 #endif
 
+#ifdef TIMER_WHEEL_ENABLE
+
+    #ifndef TIMER_WHEEL_LEVELS
+        /*******************************************************************************
+        *   This Constant Defines the Number of Levels of the Timing Wheel. 
+        *******************************************************************************/
+        #define TIMER_WHEEL_LEVELS  4       /* Default is 4 */
+    #endif      /* End of TIMER_WHEEL_LEVELS */
+
+    #ifndef TIMER_WHEEL_BITS
+        /*******************************************************************************
+        *   This Constant Defines the Number of Slots of Every Level as the Power 
+        *   of 2, Such as 6 for 64 Slots. 
+        *******************************************************************************/
+        #define TIMER_WHEEL_BITS    6       /* Default is 6 */
+    #endif      /* End of TIMER_WHEEL_BITS */
+
+    #if ((TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS) > 30)
+        #error "The Range of Timing Wheel MUST be Less than (1 << 30) Ticks." 
+    #endif
+
+    #define TIMER_WHEEL_SLOTS   ((uint16_t)1 << TIMER_WHEEL_BITS)
+    #define TIMER_WHEEL_MASK    (TIMER_WHEEL_SLOTS - (uint16_t)1)
+
+#endif  /* End of TIMER_WHEEL_ENABLE */
+
 /***************************************************************************************
 *   Timer Structure.
 *
@@ -67,6 +93,14 @@ extern "C" {
 *   This Linked List is Scanned in Every Invocation of the Ticker. Only Armed 
 *   (Timing Out) Timer are in the List, so Only Armed Timer Consume CPU Cycles. 
 *
+*   When TIMER_WHEEL_ENABLE is Defined, the Armed Timer are Hashed into the Slots 
+*   of a Hierarchical Timing Wheel According to Their Expire Tick. Level 0 has One 
+*   Slot per Tick, Each Higher Level has One Slot per Revolution of the Level Below. 
+*   The Ticker Only Handles the Current Slot of Level 0, and Cascades One Slot of 
+*   the Higher Level into the Lower Levels when the Lower Level Wraps. So Arm and 
+*   Disarm are O(1), and the Cost of Every Ticker is Amortized O(1) Regardless of 
+*   the Number of Armed Timer. 
+*
 *   timer_tag for the Description of the Data Members Derivation.
 *
 *   NOTE: 
@@ -91,6 +125,20 @@ typedef struct timer_tag
     ***********************************************************************************/
     int32_t  counter;
 
+#ifdef TIMER_WHEEL_ENABLE
+    /***********************************************************************************
+    *   The Absolute Tick (of "timer_now_") when the Timer Fires. The Down-Counter 
+    *   "counter" is not Decremented, It Keeps the Counter Value when Armed. 
+    ***********************************************************************************/
+    uint32_t expire;
+
+    /***********************************************************************************
+    *   The Slot of Timing Wheel which the Timer is Linked in, as 
+    *   (Level * TIMER_WHEEL_SLOTS + Index). 
+    ***********************************************************************************/
+    uint16_t slot;
+#endif  /* End of TIMER_WHEEL_ENABLE */
+
     /***********************************************************************************
     *   The Interval for the Periodic Timer (Zero for the One-Shot Timer). 
     *   The Value of the Interval is Re-Loaded to the Internal Down-Counter when the
@@ -114,7 +162,13 @@ typedef struct timer_tag
     struct timer_tag *next;
 } timer_t;
 
+#ifdef TIMER_WHEEL_ENABLE
+/* Slots Head of Timing Wheel */
+TIMER_EXT timer_t * timer_wheel_[TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS]; 
+TIMER_EXT uint32_t  timer_now_;      /* Current Tick of Timing Wheel */
+#else
 TIMER_EXT timer_t * timer_list_;     /* List Head of Timer */
+#endif  /* End of TIMER_WHEEL_ENABLE */
 
 /***************************************************************************************
 *   Initialize the Timer Manager.
@@ -229,11 +283,52 @@ TIMER_EXT int16_t timer_disarm(timer_t *me);
 *       Operation, timer_disarm() can Only be Used During the Active Object is 
 *       Exiting, and Active Object Has Got the Expired Event Associate with that 
 *       Timer.
+*   (5) With TIMER_WHEEL_ENABLE, the Expired Timer is Removed from the Wheel under 
+*       Lock One at a Time, so the Limitation of (4) is not Exist, timer_disarm() 
+*       can be Used at Any Time. 
+*   (6) With TIMER_WHEEL_ENABLE, the Timer Longer than the Range of the Wheel is 
+*       Parked in the Farthest Slot of the Highest Level, and Cascaded Again Until 
+*       It is within the Range. 
 ***************************************************************************************/
 TIMER_EXT int16_t timer(void_t); 
 
+/***************************************************************************************
+*   The Value Returned by timer_next() when No Timer is Armed. 
+***************************************************************************************/
+#define TIMER_NEXT_NONE     ((uint32_t)0xFFFFFFFF)
+
+/***************************************************************************************
+*   Ticks until the Next Timer Expires.
+*
+*   Description: Get the Number of Ticks until the Next Armed Timer Expires. 
+*   Argument: none. 
+*   Return: The Ticks (at Least 1) until the Next Expiry, or TIMER_NEXT_NONE. 
+*
+*   NOTE: 
+*   (1) MUST be Called with Interrupts Locked, Such As in the Idle Check of Manager. 
+*   (2) With TIMER_WHEEL_ENABLE, the Result may be Earlier than the Real Expiry, 
+*       It is the Tick when the Slot Holding the Timer is Cascaded. 
+*   (3) The Cost is O(n) for the Timer List, and Bounded by the Slots of the Wheel 
+*       for the Timing Wheel. It is Only Used when the System is Idle. 
+***************************************************************************************/
+TIMER_EXT uint32_t timer_next(void_t); 
+
+/***************************************************************************************
+*   Advance the Timers by Many Ticks.
+*
+*   Description: Advance All the Armed Timer by "elapsed" Ticks in One Step, and 
+*                Handle the Timers Expired at the Last Tick. 
+*   Argument: elapsed -- The Ticks Elapsed, MUST be in 1..timer_next(). 
+*   Return:  1 is True, 0 is False, -1 is Failure 
+*
+*   NOTE: 
+*   (1) Used by ticker_catchup() after the Tickless Idle. 
+***************************************************************************************/
+TIMER_EXT int16_t timer_advance(uint32_t elapsed); 
+
 #ifdef SPYER_TIMER_ENABLE   /* Spy Debuger Enabled */
-    #define SPYER_TIMER(format, ...)   spyer_((const int8_t *)format, ##__VA_ARGS__)
+    #define SPYER_TIMER(format, ...)   \
+        spyer_ch_(SPYER_CH_TIMER, (const int8_t *)format, ##__VA_ARGS__)
 #else                       /* Spy Debuger Disabled */
     #define SPYER_TIMER(format, ...)   ((void_t)0)
 #endif  /* End of SPYER_TIMER_ENABLE */
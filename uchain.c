@@ -44,7 +44,11 @@
 #include "ticks.h"
 #include "fault.h"
 #include "mpool.h"
+#include "event.h"
 #include "cpool.h"
+#include "echain.h"
+#include "fsm.h"
+#include "hsm.h"
 #include "active.h"
 
 #define  EXTERN_GLOBALS
@@ -52,6 +56,7 @@
 
 ASSERT_THIS_FILE(uchain.c)
 FAULT_THIS_FILE(uchain.c)
+SPYER_THIS_FILE(18)
 
 /***************************************************************************************
 *   uchain_init() Implementation.
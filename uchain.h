@@ -93,7 +93,8 @@ UCHAIN_EXT int16_t uchain_bind(chain_t **me, void_t *cell);
 UCHAIN_EXT int16_t uchain_unbind(chain_t **me, void_t *cell);
 
 #ifdef SPYER_UCHAIN_ENABLE   /* Spy Debuger Enabled */
-    #define SPYER_UCHAIN(format, ...)   spyer_((const int8_t *)format, ##__VA_ARGS__)
+    #define SPYER_UCHAIN(format, ...)   \
+        spyer_ch_(SPYER_CH_UCHAIN, (const int8_t *)format, ##__VA_ARGS__)
 #else                        /* Spyer Debuger Disabled */
     #define SPYER_UCHAIN(format, ...)   ((void_t)0)
 #endif  /* End of SPYER_UCHAIN_ENABLE */
@@ -70,7 +70,8 @@ WATCHDOG_EXT int16_t watchdog_init(void_t);
 WATCHDOG_EXT int16_t watchdog_feed(void_t); 
 
 #ifdef SPYER_WATCHDOG_ENABLE   /* Spy Debuger Enabled */
-    #define SPYER_WATCHDOG(format, ...)   spyer_((const int8_t *)format, ##__VA_ARGS__)
+    #define SPYER_WATCHDOG(format, ...)   \
+        spyer_ch_(SPYER_CH_WATCHDOG, (const int8_t *)format, ##__VA_ARGS__)
 #else                       /* Spy Debuger Disabled */
     #define SPYER_WATCHDOG(format, ...)   ((void_t)0)
 #endif  /* End of SPYER_WATCHDOG_ENABLE */